@@ -2,28 +2,57 @@
 #define S21_AVL_TREE
 #include <iomanip>
 #include <iostream>
+#include <cstdint>
+#include <future>
+#include <iterator>
 #include <limits>
 #include <memory>
+#include <system_error>
+#include <thread>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+#include "NodePool.h"
 
 namespace s21 {
 
+// Tags for constructors that take input already sorted by the comparator:
+// strictly increasing for set/map, non-decreasing for multiset.
+struct sorted_unique_t {
+  explicit sorted_unique_t() = default;
+};
+inline constexpr sorted_unique_t sorted_unique{};
+
+struct sorted_equivalent_t {
+  explicit sorted_equivalent_t() = default;
+};
+inline constexpr sorted_equivalent_t sorted_equivalent{};
+
 template <typename T>
 struct Node_tree {
   T value_;
   Node_tree* leftNode_ = nullptr;
   Node_tree* rightNode_ = nullptr;
   Node_tree* parent_ = nullptr;
-  int height_ = 0;
+  // Height and subtree size share one word so the node does not grow: an AVL
+  // tree of height 127 would need more nodes than fit in memory anyway.
+  int height_ : 8;
+  std::uint64_t subtreeSize_ : 56;
 
   Node_tree(T value = T(), Node_tree* leftNode = nullptr,
             Node_tree* rightNode = nullptr, Node_tree* parent = nullptr,
             int height = 0)
-      : value_(value),
+      : value_(std::move(value)),
         leftNode_(leftNode),
         rightNode_(rightNode),
         parent_(parent),
-        height_(height) {}
+        height_(height),
+        subtreeSize_(1U) {}
+  // Builds the value in place from constructor arguments
+  template <typename... Args>
+  explicit Node_tree(std::in_place_t, Args&&... args)
+      : value_(std::forward<Args>(args)...), height_(0), subtreeSize_(1U) {}
 };
 
 template <typename T>
@@ -76,10 +105,12 @@ class ConstIterator : public Iterator<T> {
     this->end_node_ = other.end_node_;
     return *this;
   }
-  const_reference operator*() { return this->curent_node_->value_; }
+  const_reference operator*() const { return this->curent_node_->value_; }
+  const value_type* operator->() const { return &this->curent_node_->value_; }
 };
 
-template <typename T, typename Comporator = std::less<T>>
+template <typename T, typename Comporator = std::less<T>,
+          typename Allocator = std::allocator<T>>
 class Tree {
  public:
   using value_type = T;
@@ -89,8 +120,15 @@ class Tree {
   using const_iterator = ConstIterator<T>;
   using size_type = std::size_t;
   using Node = Node_tree<T>;
+  using allocator_type = Allocator;
 
   Tree() : root_(nullptr), endNode_(new Node()), size_(0), comp_() {}
+  explicit Tree(const Allocator& alloc)
+      : root_(nullptr),
+        endNode_(new Node()),
+        size_(0),
+        comp_(),
+        pool_(alloc) {}
   Tree(const Tree& other);
   Tree(Tree&& other);
   ~Tree();
@@ -126,26 +164,185 @@ class Tree {
   size_type size() const;
   size_type max_size() const;
   void clear();
+  allocator_type get_allocator() const;
 
   std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
   std::pair<iterator, bool> insertNonUniq(const value_type& value);
+  std::pair<iterator, bool> insertNonUniq(value_type&& value);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  template <typename... Args>
+  iterator emplaceNonUniq(Args&&... args);
+  template <typename Key, typename... Args>
+  std::pair<iterator, bool> emplaceIfAbsent(const Key& key, Args&&... args);
+
+  // Hinted insertion: a hint right after the insertion point (end() for
+  // appends) skips the descent from the root
+  std::pair<iterator, bool> insertHint(const_iterator hint,
+                                       const value_type& value, bool unique);
+  std::pair<iterator, bool> insertHint(const_iterator hint, value_type&& value,
+                                       bool unique);
+  template <typename... Args>
+  std::pair<iterator, bool> emplaceHint(const_iterator hint, bool unique,
+                                        Args&&... args);
+  template <typename Key, typename... Args>
+  std::pair<iterator, bool> tryEmplaceHint(const_iterator hint, const Key& key,
+                                           Args&&... args);
+
+  template <typename ForwardIt>
+  void buildFromSorted(ForwardIt first, ForwardIt last);
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last, bool unique);
 
   void erase(iterator pos);
+  iterator erase(iterator first, iterator last);
+  Tree extract(const_reference low, const_reference high);
   void swap(Tree& other);
   void merge(Tree& other);
   void mergeNonUniq(Tree& other);
+  void unite(Tree& other, bool unique);
+  void intersect(Tree& other, bool unique);
+  void subtract(Tree& other, bool unique);
   iterator find(const_reference key);
+  const_iterator find(const_reference key) const;
   iterator lower_bound(const_reference key);
+  const_iterator lower_bound(const_reference key) const;
   iterator upper_bound(const_reference key);
+  const_iterator upper_bound(const_reference key) const;
   bool contains(const_reference key);
 
+  // Heterogeneous lookups, available when the comparator defines
+  // is_transparent: key may be any type comparable with value_type.
+  template <typename K, typename C = Comporator,
+            typename = typename C::is_transparent>
+  iterator find(const K& key) {
+    return iterator(findNode(key), endNode_);
+  }
+  template <typename K, typename C = Comporator,
+            typename = typename C::is_transparent>
+  const_iterator find(const K& key) const {
+    return const_iterator(findNode(key), endNode_);
+  }
+  template <typename K, typename C = Comporator,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K& key) {
+    return iterator(lowerBoundNode(key), endNode_);
+  }
+  template <typename K, typename C = Comporator,
+            typename = typename C::is_transparent>
+  const_iterator lower_bound(const K& key) const {
+    return const_iterator(lowerBoundNode(key), endNode_);
+  }
+  template <typename K, typename C = Comporator,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K& key) {
+    return iterator(upperBoundNode(key), endNode_);
+  }
+  template <typename K, typename C = Comporator,
+            typename = typename C::is_transparent>
+  const_iterator upper_bound(const K& key) const {
+    return const_iterator(upperBoundNode(key), endNode_);
+  }
+  template <typename K, typename C = Comporator,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const {
+    return findNode(key) != endNode_;
+  }
+  template <typename K, typename C = Comporator,
+            typename = typename C::is_transparent>
+  size_type rank(const K& key) const {
+    return countLess(key, false);
+  }
+  template <typename K, typename C = Comporator,
+            typename = typename C::is_transparent>
+  size_type count(const K& key) const {
+    return countLess(key, true) - countLess(key, false);
+  }
+  template <typename K, typename C = Comporator,
+            typename = typename C::is_transparent>
+  Tree extract(const K& low, const K& high) {
+    return extractRange(low, high);
+  }
+
+  iterator select(size_type index);
+  size_type rank(const_reference key) const;
+  size_type count(const_reference key) const;
+  size_type index_of(iterator pos);
+  std::ptrdiff_t distance(iterator first, iterator last);
+
  private:
   void SwapNode(Node* fNode, Node* sNode);
+  template <typename ForwardIt>
+  Node* buildBalanced(ForwardIt& it, size_type count, Node* parent);
+  // Move takes the values out of source rather than copying them
+  template <bool Move = false>
+  void cloneSubtree(std::conditional_t<Move, Node, const Node>* source,
+                    Node* parent, Node** slot);
+  // Above the height of any AVL tree that fits in memory
+  static constexpr int kMaxHeight = 96;
+  void teardown(Node* node, bool recycle);
+  template <typename Visit>
+  static void walkSubtree(Node* top, Visit visit);
+  static int cachedHeight(const Node* node);
+  static size_type subtreeSize(const Node* node);
+  template <typename K>
+  size_type countLess(const K& key, bool inclusive) const;
+  template <typename K>
+  Node* findNode(const K& key) const;
+  template <typename K>
+  Node* lowerBoundNode(const K& key) const;
+  template <typename K>
+  Node* upperBoundNode(const K& key) const;
+  template <typename K>
+  Tree extractRange(const K& low, const K& high);
+  static void refresh(Node* node);
+  template <typename Key>
+  Node* findSlot(const Key& key, bool unique, Node** parent,
+                 bool* left) const;
+  iterator linkNode(Node* node, Node* parent, bool left);
+  template <typename Key>
+  Node* findHintSlot(Node* hint, const Key& key, bool unique, Node** parent,
+                     bool* left) const;
+  template <typename Key, typename... Args>
+  std::pair<iterator, bool> placeNear(const_iterator hint, const Key& key,
+                                      bool unique, Args&&... args);
+
+  // Join-based set algebra on detached subtrees
+  enum class SetOperation { kUnion, kSum, kIntersection, kDifference };
+  struct Split {
+    Node* less;
+    Node* equal;
+    Node* greater;
+  };
+  static constexpr size_type kParallelGrain = 1U << 15;
+
+  void combine(Tree& other, SetOperation operation, bool unique);
+  Node* combineNodes(Node* first, Node* second, SetOperation operation,
+                     bool unique, std::vector<Node*>* trash, int depth) const;
+  Node* combineEqual(Node* first, Node* second, SetOperation operation,
+                     std::vector<Node*>* trash) const;
+  Split splitNodes(Node* node, const_reference key, bool unique) const;
+  static std::pair<Node*, Node*> splitLast(Node* node);
+  static std::pair<Node*, Node*> splitAt(Node* node, size_type index);
+  static Node* joinNodes(Node* left, Node* middle, Node* right);
+  static Node* joinRight(Node* left, Node* middle, Node* right);
+  static Node* joinLeft(Node* left, Node* middle, Node* right);
+  static Node* concat(Node* left, Node* right);
+  static Node* link(Node* node, Node* left, Node* right);
+  static Node* rotateLeft(Node* node);
+  static Node* rotateRight(Node* node);
+  static int parallelDepth();
+  void eraseSubtree(Node* node);
+  Node* cutRange(size_type from, size_type to);
+  void setRoot(Node* root);
 
   Node* root_;
-  Node* endNode_;
+  Node* endNode_;  // endNode_->parent_ caches the rightmost node
+  Node* leftmost_ = nullptr;
   size_type size_ = 0U;
   Comporator comp_;
+  NodePool<Node, Allocator> pool_;
 };
 }  // namespace s21
 
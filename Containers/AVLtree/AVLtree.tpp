@@ -2,140 +2,407 @@
 
 namespace s21 {
 
-template <typename T, typename Comporator>
-Tree<T, Comporator>::Tree(const Tree& other) : Tree() {
+template <typename T, typename Comporator, typename Allocator>
+Tree<T, Comporator, Allocator>::Tree(const Tree& other) : Tree() {
   *this = other;
 }
 
-template <typename T, typename Comporator>
-Tree<T, Comporator>::Tree(Tree&& other) : Tree() {
+template <typename T, typename Comporator, typename Allocator>
+Tree<T, Comporator, Allocator>::Tree(Tree&& other) : Tree() {
   *this = std::move(other);
 }
 
-template <typename T, typename Comporator>
-Tree<T, Comporator>::~Tree() {
+template <typename T, typename Comporator, typename Allocator>
+Tree<T, Comporator, Allocator>::~Tree() {
   clear();
   delete endNode_;
 }
 
-template <typename T, typename Comporator>
-void Tree<T, Comporator>::swap(Tree& other) {
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::swap(Tree& other) {
   std::swap(root_, other.root_);
   std::swap(endNode_, other.endNode_);
+  std::swap(leftmost_, other.leftmost_);
   std::swap(size_, other.size_);
+  std::swap(comp_, other.comp_);
+  pool_.swap(other.pool_);
 }
 
 /*
 merge
+Moves the nodes of other into this tree; other is left empty. Keys already
+present here keep their value and the duplicates from other are dropped.
 */
 
-template <typename T, typename Comporator>
-void Tree<T, Comporator>::merge(Tree& other) {
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::merge(Tree& other) {
   if (this != &other) {
-    for (auto it = other.begin(); it != other.end(); ++it) {
-      insert(*it);
-    }
-    other.clear();
+    combine(other, SetOperation::kUnion, true);
   }
 }
 
-template <typename T, typename Comporator>
-void Tree<T, Comporator>::mergeNonUniq(Tree& other) {
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::mergeNonUniq(Tree& other) {
   if (this != &other) {
-    for (auto it = other.begin(); it != other.end(); ++it) {
-      insertNonUniq(*it);
-    }
-    other.clear();
+    combine(other, SetOperation::kSum, false);
   }
 }
 
 /*
-insertNonUniq
-Ввод в дерево неуникальных значений
+unite, intersect, subtract
+Set union, intersection and difference in O(m log(n / m + 1)) for sizes
+m <= n. With unique == false equal keys are matched up as in
+std::set_union and friends: the result keeps max, min or the difference of
+the two counts. other is consumed and left empty.
 */
 
-template <typename T, typename Comparator>
-std::pair<typename Tree<T, Comparator>::iterator, bool>
-Tree<T, Comparator>::insertNonUniq(const value_type& value) {
-  Node* NewNode = new Node(value);
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::unite(Tree& other, bool unique) {
+  if (this != &other) {
+    combine(other, SetOperation::kUnion, unique);
+  }
+}
 
-  if (root_ == nullptr) {
-    root_ = NewNode;
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::intersect(Tree& other, bool unique) {
+  if (this != &other) {
+    combine(other, SetOperation::kIntersection, unique);
+  }
+}
+
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::subtract(Tree& other, bool unique) {
+  if (this == &other) {
+    clear();
   } else {
-    Node* node = root_;
-    while (true) {
-      if (comp_(value, node->value_)) {
-        if (node->leftNode_ == nullptr) {
-          NewNode->parent_ = node;
-          node->leftNode_ = NewNode;
-          break;
-        } else {
-          node = node->leftNode_;
-        }
-      } else {
-        if (node->rightNode_ == nullptr) {
-          NewNode->parent_ = node;
-          node->rightNode_ = NewNode;
-          break;
-        } else {
-          node = node->rightNode_;
-        }
-      }
-    }
+    combine(other, SetOperation::kDifference, unique);
+  }
+}
 
-    Node* currentNode = NewNode;
-    while (currentNode != nullptr && currentNode != endNode_) {
-      updateHeight(currentNode);
-      balancingTree(&currentNode);
+/*
+buildFromSorted
+Replaces the contents with a perfectly balanced tree built in O(N) from a
+range already sorted by the comparator. All nodes come from one chunk.
+*/
 
-      currentNode = currentNode->parent_;
+template <typename T, typename Comporator, typename Allocator>
+template <typename ForwardIt>
+void Tree<T, Comporator, Allocator>::buildFromSorted(ForwardIt first,
+                                                     ForwardIt last) {
+  clear();
+  size_type count = static_cast<size_type>(std::distance(first, last));
+  if (count == 0U) return;
+  pool_.reserve(count);
+  root_ = buildBalanced(first, count, endNode_);
+  size_ = count;
+  leftmost_ = find_min(root_);
+  endNode_->parent_ = find_max(root_);
+}
+
+// Builds the subtree holding the next count values of it in order. Left and
+// right halves differ by at most one node, so the AVL invariant holds.
+template <typename T, typename Comporator, typename Allocator>
+template <typename ForwardIt>
+typename Tree<T, Comporator, Allocator>::Node*
+Tree<T, Comporator, Allocator>::buildBalanced(ForwardIt& it, size_type count,
+                                              Node* parent) {
+  if (count == 0U) return nullptr;
+  size_type leftCount = count / 2U;
+  Node* left = buildBalanced(it, leftCount, nullptr);
+  Node* node = pool_.create(*it);
+  ++it;
+  node->parent_ = parent;
+  node->leftNode_ = left;
+  if (left) left->parent_ = node;
+  node->rightNode_ = buildBalanced(it, count - leftCount - 1U, node);
+  node->height_ =
+      std::max(cachedHeight(left), cachedHeight(node->rightNode_)) + 1;
+  node->subtreeSize_ = count;
+  return node;
+}
+
+/*
+assign
+Replaces the contents with [first, last). Sorted forward ranges take the
+linear buildFromSorted path, anything else is inserted one by one.
+*/
+
+template <typename T, typename Comporator, typename Allocator>
+template <typename InputIt>
+void Tree<T, Comporator, Allocator>::assign(InputIt first, InputIt last,
+                                            bool unique) {
+  using category = typename std::iterator_traits<InputIt>::iterator_category;
+  if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+    bool sorted = true;
+    if (first != last) {
+      for (InputIt prev = first, it = std::next(first); sorted && it != last;
+           prev = it, ++it) {
+        sorted = unique ? comp_(*prev, *it) : !comp_(*it, *prev);
+      }
+    }
+    if (sorted) {
+      buildFromSorted(first, last);
+      return;
     }
   }
+  clear();
+  // Mostly sorted input still gains from hinting at the previous position
+  const_iterator hint = end();
+  for (; first != last; ++first) {
+    hint = insertHint(hint, *first, unique).first;
+    ++hint;
+  }
+}
 
-  ++size_;
-  root_->parent_ = endNode_;
-  endNode_->parent_ = find_max(root_);
-  return std::make_pair(iterator(NewNode, endNode_), true);
+/*
+insertNonUniq
+Ввод в дерево неуникальных значений
+*/
+
+template <typename T, typename Comparator, typename Allocator>
+std::pair<typename Tree<T, Comparator, Allocator>::iterator, bool>
+Tree<T, Comparator, Allocator>::insertNonUniq(const value_type& value) {
+  return std::make_pair(emplaceNonUniq(value), true);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+std::pair<typename Tree<T, Comparator, Allocator>::iterator, bool>
+Tree<T, Comparator, Allocator>::insertNonUniq(value_type&& value) {
+  return std::make_pair(emplaceNonUniq(std::move(value)), true);
 }
 
 /*
 insert
-Ввод в дерево уникальных значений
+Ввод в дерево уникальных значений. The position is searched before a node
+is created, so a duplicate costs no allocation or copy.
+*/
+
+template <typename T, typename Comparator, typename Allocator>
+std::pair<typename Tree<T, Comparator, Allocator>::iterator, bool>
+Tree<T, Comparator, Allocator>::insert(const value_type& value) {
+  return emplaceIfAbsent(value, value);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+std::pair<typename Tree<T, Comparator, Allocator>::iterator, bool>
+Tree<T, Comparator, Allocator>::insert(value_type&& value) {
+  return emplaceIfAbsent(value, std::move(value));
+}
+
+/*
+emplace
+Constructs the value in its node first, since the key is only known
+afterwards; the node goes back to the pool if the key is taken.
 */
 
-template <typename T, typename Comparator>
-std::pair<typename Tree<T, Comparator>::iterator, bool>
-Tree<T, Comparator>::insert(const value_type& value) {
-  Node* NewNode = new Node(value);
+template <typename T, typename Comparator, typename Allocator>
+template <typename... Args>
+std::pair<typename Tree<T, Comparator, Allocator>::iterator, bool>
+Tree<T, Comparator, Allocator>::emplace(Args&&... args) {
+  Node* node = pool_.create(std::in_place, std::forward<Args>(args)...);
+  Node* parent = nullptr;
+  bool left = false;
+  Node* existing = findSlot(node->value_, true, &parent, &left);
+  if (existing) {
+    pool_.erase(node);
+    return std::make_pair(iterator(existing, endNode_), false);
+  }
+  return std::make_pair(linkNode(node, parent, left), true);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename... Args>
+typename Tree<T, Comparator, Allocator>::iterator
+Tree<T, Comparator, Allocator>::emplaceNonUniq(Args&&... args) {
+  Node* node = pool_.create(std::in_place, std::forward<Args>(args)...);
+  Node* parent = nullptr;
+  bool left = false;
+  findSlot(node->value_, false, &parent, &left);
+  return linkNode(node, parent, left);
+}
+
+/*
+emplaceIfAbsent
+Looks key up and constructs a value from args only when it is missing.
+key must compare like the value that args would build.
+*/
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename Key, typename... Args>
+std::pair<typename Tree<T, Comparator, Allocator>::iterator, bool>
+Tree<T, Comparator, Allocator>::emplaceIfAbsent(const Key& key,
+                                                Args&&... args) {
+  Node* parent = nullptr;
+  bool left = false;
+  Node* existing = findSlot(key, true, &parent, &left);
+  if (existing) {
+    return std::make_pair(iterator(existing, endNode_), false);
+  }
+  Node* node = pool_.create(std::in_place, std::forward<Args>(args)...);
+  return std::make_pair(linkNode(node, parent, left), true);
+}
+
+/*
+insertHint, emplaceHint, tryEmplaceHint
+Insert right before hint when the key belongs there, or right after it for
+keys greater than hint. Otherwise they fall back to a search from the root.
+*/
+
+template <typename T, typename Comparator, typename Allocator>
+std::pair<typename Tree<T, Comparator, Allocator>::iterator, bool>
+Tree<T, Comparator, Allocator>::insertHint(const_iterator hint,
+                                           const value_type& value,
+                                           bool unique) {
+  return placeNear(hint, value, unique, value);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+std::pair<typename Tree<T, Comparator, Allocator>::iterator, bool>
+Tree<T, Comparator, Allocator>::insertHint(const_iterator hint,
+                                           value_type&& value, bool unique) {
+  return placeNear(hint, value, unique, std::move(value));
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename... Args>
+std::pair<typename Tree<T, Comparator, Allocator>::iterator, bool>
+Tree<T, Comparator, Allocator>::emplaceHint(const_iterator hint, bool unique,
+                                            Args&&... args) {
+  Node* node = pool_.create(std::in_place, std::forward<Args>(args)...);
+  Node* hintNode = hint.getCurNode() ? hint.getCurNode() : endNode_;
+  Node* parent = nullptr;
+  bool left = false;
+  Node* existing =
+      findHintSlot(hintNode, node->value_, unique, &parent, &left);
+  if (existing) {
+    pool_.erase(node);
+    return std::make_pair(iterator(existing, endNode_), false);
+  }
+  return std::make_pair(linkNode(node, parent, left), true);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename Key, typename... Args>
+std::pair<typename Tree<T, Comparator, Allocator>::iterator, bool>
+Tree<T, Comparator, Allocator>::tryEmplaceHint(const_iterator hint,
+                                               const Key& key,
+                                               Args&&... args) {
+  return placeNear(hint, key, true, std::forward<Args>(args)...);
+}
+
+// Searches near hint first and builds the value only once a slot is found
+template <typename T, typename Comparator, typename Allocator>
+template <typename Key, typename... Args>
+std::pair<typename Tree<T, Comparator, Allocator>::iterator, bool>
+Tree<T, Comparator, Allocator>::placeNear(const_iterator hint,
+                                          const Key& key, bool unique,
+                                          Args&&... args) {
+  Node* hintNode = hint.getCurNode() ? hint.getCurNode() : endNode_;
+  Node* parent = nullptr;
+  bool left = false;
+  Node* existing = findHintSlot(hintNode, key, unique, &parent, &left);
+  if (existing) {
+    return std::make_pair(iterator(existing, endNode_), false);
+  }
+  Node* node = pool_.create(std::in_place, std::forward<Args>(args)...);
+  return std::make_pair(linkNode(node, parent, left), true);
+}
 
+// Checks key against hint and its neighbours only. The free child slot
+// between two neighbours is always the right child of the first one or the
+// left child of the second.
+template <typename T, typename Comparator, typename Allocator>
+template <typename Key>
+typename Tree<T, Comparator, Allocator>::Node*
+Tree<T, Comparator, Allocator>::findHintSlot(Node* hint, const Key& key,
+                                             bool unique, Node** parent,
+                                             bool* left) const {
   if (root_ == nullptr) {
-    root_ = NewNode;
-  } else {
-    Node* node = root_;
-    while (true) {
-      if (comp_(value, node->value_)) {
-        if (node->leftNode_ == nullptr) {
-          NewNode->parent_ = node;
-          node->leftNode_ = NewNode;
-          break;
-        } else {
-          node = node->leftNode_;
-        }
-      } else if (comp_(node->value_, value)) {
-        if (node->rightNode_ == nullptr) {
-          NewNode->parent_ = node;
-          node->rightNode_ = NewNode;
-          break;
-        } else {
-          node = node->rightNode_;
-        }
+    *parent = nullptr;
+    return nullptr;
+  }
+  bool belowHint =
+      hint == endNode_ ||
+      (unique ? comp_(key, hint->value_) : !comp_(hint->value_, key));
+  if (belowHint) {
+    iterator it(hint, endNode_);
+    Node* prev = hint == leftmost_ ? nullptr : (--it).getCurNode();
+    bool abovePrev = prev == nullptr || (unique ? comp_(prev->value_, key)
+                                                : !comp_(key, prev->value_));
+    if (abovePrev) {
+      if (hint != endNode_ && hint->leftNode_ == nullptr) {
+        *parent = hint;
+        *left = true;
+      } else {
+        *parent = prev;
+        *left = false;
+      }
+      return nullptr;
+    }
+  } else if (comp_(hint->value_, key)) {
+    iterator it(hint, endNode_);
+    Node* next = (++it).getCurNode();
+    bool belowNext = next == endNode_ || (unique ? comp_(key, next->value_)
+                                                 : !comp_(next->value_, key));
+    if (belowNext) {
+      if (hint->rightNode_ == nullptr) {
+        *parent = hint;
+        *left = false;
       } else {
-        delete NewNode;
-        return std::make_pair(iterator(node, endNode_), false);
+        *parent = next;
+        *left = true;
       }
+      return nullptr;
+    }
+  } else if (unique) {
+    return hint;
+  }
+  return findSlot(key, unique, parent, left);
+}
+
+// Finds where key belongs: returns the node holding an equal key when
+// unique is set, otherwise nullptr with the future parent and side filled in
+template <typename T, typename Comparator, typename Allocator>
+template <typename Key>
+typename Tree<T, Comparator, Allocator>::Node*
+Tree<T, Comparator, Allocator>::findSlot(const Key& key, bool unique,
+                                         Node** parent, bool* left) const {
+  Node* node = root_;
+  while (node) {
+    *parent = node;
+    if (comp_(key, node->value_)) {
+      *left = true;
+      node = node->leftNode_;
+    } else if (unique && !comp_(node->value_, key)) {
+      return node;
+    } else {
+      *left = false;
+      node = node->rightNode_;
     }
+  }
+  return nullptr;
+}
 
-    Node* currentNode = NewNode;
+// Hangs a new leaf under parent and rebalances up to the root
+template <typename T, typename Comparator, typename Allocator>
+typename Tree<T, Comparator, Allocator>::iterator
+Tree<T, Comparator, Allocator>::linkNode(Node* node, Node* parent,
+                                         bool left) {
+  if (parent == nullptr) {
+    root_ = node;
+    leftmost_ = node;
+    endNode_->parent_ = node;
+  } else {
+    node->parent_ = parent;
+    if (left) {
+      parent->leftNode_ = node;
+      if (parent == leftmost_) leftmost_ = node;
+    } else {
+      parent->rightNode_ = node;
+      if (parent == endNode_->parent_) endNode_->parent_ = node;
+    }
+
+    Node* currentNode = node;
     while (currentNode != nullptr && currentNode != endNode_) {
       updateHeight(currentNode);
       balancingTree(&currentNode);
@@ -146,8 +413,7 @@ Tree<T, Comparator>::insert(const value_type& value) {
 
   ++size_;
   root_->parent_ = endNode_;
-  endNode_->parent_ = find_max(root_);
-  return std::make_pair(iterator(NewNode, endNode_), true);
+  return iterator(node, endNode_);
 }
 
 /*
@@ -160,14 +426,27 @@ typename Iterator<T>::Node* Iterator<T>::getCurNode() {
   return curent_node_;
 }
 
-template <typename T, typename Comporator>
-void Tree<T, Comporator>::erase(iterator pos) {
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::erase(iterator pos) {
   Node* node = pos.getCurNode();
   if (!node || node == endNode_) return;
 
   Node* parent = node->parent_;
   Node* nodeToBalanceFrom = nullptr;
 
+  if (node->leftNode_ && node->rightNode_) {
+    Node* successor = find_min(node->rightNode_);
+    SwapNode(node, successor);
+    erase(pos);
+    return;
+  }
+  if (node == leftmost_) {
+    leftmost_ = node->rightNode_ ? find_min(node->rightNode_) : parent;
+  }
+  if (node == endNode_->parent_) {
+    endNode_->parent_ = node->leftNode_ ? find_max(node->leftNode_) : parent;
+  }
+
   if (!node->leftNode_ && !node->rightNode_) {
     if (parent && node != root_) {
       if (parent->leftNode_ == node)
@@ -189,7 +468,7 @@ void Tree<T, Comporator>::erase(iterator pos) {
       root_ = node->leftNode_;
     }
     node->leftNode_->parent_ = parent;
-  } else if (!node->leftNode_ && node->rightNode_) {
+  } else {
     if (parent && node != root_) {
       if (parent->leftNode_ == node)
         parent->leftNode_ = node->rightNode_;
@@ -200,14 +479,9 @@ void Tree<T, Comporator>::erase(iterator pos) {
       root_ = node->rightNode_;
     }
     node->rightNode_->parent_ = parent;
-  } else {
-    Node* successor = find_min(node->rightNode_);
-    SwapNode(node, successor);
-    erase(pos);
-    return;
   }
 
-  delete node;
+  pool_.erase(node);
 
   Node* current = nodeToBalanceFrom;
   while (current && current != endNode_) {
@@ -219,9 +493,10 @@ void Tree<T, Comporator>::erase(iterator pos) {
   --size_;
   if (root_) {
     root_->parent_ = endNode_;
-    endNode_->parent_ = find_max(root_);
   } else {
     size_ = 0U;
+    leftmost_ = nullptr;
+    endNode_->parent_ = nullptr;
   }
 }
 
@@ -229,8 +504,9 @@ void Tree<T, Comporator>::erase(iterator pos) {
 size
 */
 
-template <typename T, typename Comporator>
-typename Tree<T, Comporator>::size_type Tree<T, Comporator>::size() const {
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::size_type
+Tree<T, Comporator, Allocator>::size() const {
   return size_;
 }
 
@@ -238,8 +514,9 @@ typename Tree<T, Comporator>::size_type Tree<T, Comporator>::size() const {
 max_size
 */
 
-template <typename T, typename Comparator>
-typename Tree<T, Comparator>::size_type Tree<T, Comparator>::max_size() const {
+template <typename T, typename Comparator, typename Allocator>
+typename Tree<T, Comparator, Allocator>::size_type
+Tree<T, Comparator, Allocator>::max_size() const {
 #if defined(__linux__)
   return (std::numeric_limits<std::ptrdiff_t>::max()) / sizeof(Node);
 #else
@@ -249,42 +526,155 @@ typename Tree<T, Comparator>::size_type Tree<T, Comparator>::max_size() const {
 
 /*
 heightTree
+Measures the height by walking the subtree rather than trusting height_,
+so it can be used to check the cached heights
 */
 
-template <typename T, typename Comporator>
-int Tree<T, Comporator>::heightTree(Node* node) {
+template <typename T, typename Comporator, typename Allocator>
+int Tree<T, Comporator, Allocator>::heightTree(Node* node) {
   if (node == nullptr || node == endNode_) {
     return 0;
   }
 
-  int hLeft = heightTree(node->leftNode_);
-  int hRight = heightTree(node->rightNode_);
-  return std::max(hLeft, hRight) + 1;
+  int height = 0;
+  walkSubtree(node, [&height](Node*, int depth) {
+    height = std::max(height, depth);
+  });
+  return height;
 }
 
 /*
 updateHeight(Node* node)
+Recomputes height and subtree size of node from its children in O(1); the
+children must already be up to date.
 */
 
-template <typename T, typename Comporator>
-void Tree<T, Comporator>::updateHeight(Node* node) {
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::updateHeight(Node* node) {
   if (root_ == nullptr) {
     throw std::logic_error("The tree is empty");
   }
   if (node == nullptr || node == endNode_) {
     return;
   }
-  int leftHeight = (node->leftNode_ && node->leftNode_ != endNode_)
-                       ? heightTree(node->leftNode_)
-                       : 0;
-  int rightHeight = (node->rightNode_ && node->rightNode_ != endNode_)
-                        ? heightTree(node->rightNode_)
-                        : 0;
-  node->height_ = std::max(leftHeight, rightHeight) + 1;
+  refresh(node);
 }
 
-template <typename T, typename Comparator>
-void Tree<T, Comparator>::SwapNode(Node* firstNode, Node* secondNode) {
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::refresh(Node* node) {
+  node->height_ = std::max(cachedHeight(node->leftNode_),
+                           cachedHeight(node->rightNode_)) +
+                  1;
+  node->subtreeSize_ =
+      subtreeSize(node->leftNode_) + subtreeSize(node->rightNode_) + 1U;
+}
+
+template <typename T, typename Comporator, typename Allocator>
+int Tree<T, Comporator, Allocator>::cachedHeight(const Node* node) {
+  return node ? node->height_ : 0;
+}
+
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::size_type
+Tree<T, Comporator, Allocator>::subtreeSize(const Node* node) {
+  return node ? static_cast<size_type>(node->subtreeSize_) : 0U;
+}
+
+// -----------------------------------------------------------------------------------------------
+// ORDER STATISTICS
+
+/*
+select
+Iterator to the element with the given zero-based position, end() if the
+index is out of range
+*/
+
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::iterator
+Tree<T, Comporator, Allocator>::select(size_type index) {
+  if (index >= size_) return end();
+  Node* node = root_;
+  while (true) {
+    size_type leftSize = subtreeSize(node->leftNode_);
+    if (index < leftSize) {
+      node = node->leftNode_;
+    } else if (index == leftSize) {
+      return iterator(node, endNode_);
+    } else {
+      index -= leftSize + 1U;
+      node = node->rightNode_;
+    }
+  }
+}
+
+/*
+rank
+Number of elements less than key, i.e. the position of lower_bound(key)
+*/
+
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::size_type
+Tree<T, Comporator, Allocator>::rank(const_reference key) const {
+  return countLess(key, false);
+}
+
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::size_type
+Tree<T, Comporator, Allocator>::count(const_reference key) const {
+  return countLess(key, true) - countLess(key, false);
+}
+
+// Counts elements less than key, or not greater than key when inclusive
+template <typename T, typename Comporator, typename Allocator>
+template <typename K>
+typename Tree<T, Comporator, Allocator>::size_type
+Tree<T, Comporator, Allocator>::countLess(const K& key, bool inclusive) const {
+  size_type result = 0U;
+  const Node* node = root_;
+  while (node) {
+    bool goRight =
+        inclusive ? !comp_(key, node->value_) : comp_(node->value_, key);
+    if (goRight) {
+      result += subtreeSize(node->leftNode_) + 1U;
+      node = node->rightNode_;
+    } else {
+      node = node->leftNode_;
+    }
+  }
+  return result;
+}
+
+/*
+index_of
+Zero-based position of pos, size() for end()
+*/
+
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::size_type
+Tree<T, Comporator, Allocator>::index_of(iterator pos) {
+  Node* node = pos.getCurNode();
+  if (node == nullptr || node == endNode_) return size_;
+  size_type result = subtreeSize(node->leftNode_);
+  while (node->parent_ != endNode_) {
+    Node* parent = node->parent_;
+    if (parent->rightNode_ == node) {
+      result += subtreeSize(parent->leftNode_) + 1U;
+    }
+    node = parent;
+  }
+  return result;
+}
+
+template <typename T, typename Comporator, typename Allocator>
+std::ptrdiff_t Tree<T, Comporator, Allocator>::distance(iterator first,
+                                                        iterator last) {
+  return static_cast<std::ptrdiff_t>(index_of(last)) -
+         static_cast<std::ptrdiff_t>(index_of(first));
+}
+
+template <typename T, typename Comparator, typename Allocator>
+void
+Tree<T, Comparator, Allocator>::SwapNode(Node* firstNode, Node* secondNode) {
   Node* root_tmp = root_;
   if (firstNode == root_tmp) {
     root_ = secondNode;
@@ -308,7 +698,12 @@ void Tree<T, Comparator>::SwapNode(Node* firstNode, Node* secondNode) {
   std::swap(firstNode->parent_, secondNode->parent_);
   std::swap(firstNode->leftNode_, secondNode->leftNode_);
   std::swap(firstNode->rightNode_, secondNode->rightNode_);
-  std::swap(firstNode->height_, secondNode->height_);
+  int height = firstNode->height_;
+  firstNode->height_ = secondNode->height_;
+  secondNode->height_ = height;
+  std::uint64_t subtree = firstNode->subtreeSize_;
+  firstNode->subtreeSize_ = secondNode->subtreeSize_;
+  secondNode->subtreeSize_ = subtree;
 
   if (firstNode->leftNode_) {
     firstNode->leftNode_->parent_ = firstNode;
@@ -323,27 +718,38 @@ void Tree<T, Comparator>::SwapNode(Node* firstNode, Node* secondNode) {
     secondNode->rightNode_->parent_ = secondNode;
   }
   root_->parent_ = endNode_;
-  endNode_->parent_ = find_max(root_);
+  if (leftmost_ == firstNode) {
+    leftmost_ = secondNode;
+  } else if (leftmost_ == secondNode) {
+    leftmost_ = firstNode;
+  }
+  if (endNode_->parent_ == firstNode) {
+    endNode_->parent_ = secondNode;
+  } else if (endNode_->parent_ == secondNode) {
+    endNode_->parent_ = firstNode;
+  }
 }
 
 /*
 begin
 */
 
-template <typename T, typename Comporator>
-typename Tree<T, Comporator>::iterator Tree<T, Comporator>::begin() {
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::iterator
+Tree<T, Comporator, Allocator>::begin() {
   if (root_) {
-    return Iterator(find_min(root_), endNode_);
+    return Iterator(leftmost_, endNode_);
   } else {
     return end();
   }
 }
 
-template <typename T, typename Comporator>
-typename Tree<T, Comporator>::const_iterator Tree<T, Comporator>::begin()
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::const_iterator
+Tree<T, Comporator, Allocator>::begin()
     const {
   if (root_) {
-    return ConstIterator(find_min(root_), endNode_);
+    return ConstIterator(leftmost_, endNode_);
   } else {
     return end();
   }
@@ -353,13 +759,15 @@ typename Tree<T, Comporator>::const_iterator Tree<T, Comporator>::begin()
 end
 */
 
-template <typename T, typename Comporator>
-typename Tree<T, Comporator>::iterator Tree<T, Comporator>::end() {
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::iterator
+Tree<T, Comporator, Allocator>::end() {
   return Iterator(endNode_, endNode_);
 }
 
-template <typename T, typename Comporator>
-typename Tree<T, Comporator>::const_iterator Tree<T, Comporator>::end() const {
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::const_iterator
+Tree<T, Comporator, Allocator>::end() const {
   return ConstIterator(endNode_, endNode_);
 }
 
@@ -367,9 +775,9 @@ typename Tree<T, Comporator>::const_iterator Tree<T, Comporator>::end() const {
 find_min
 */
 
-template <typename T, typename Comporator>
-typename Tree<T, Comporator>::Node* Tree<T, Comporator>::find_min(
-    Node* node) const {
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::Node*
+Tree<T, Comporator, Allocator>::find_min(Node* node) const {
   while (node->leftNode_ != nullptr) {
     node = node->leftNode_;
   }
@@ -380,9 +788,9 @@ typename Tree<T, Comporator>::Node* Tree<T, Comporator>::find_min(
 find_max
 */
 
-template <typename T, typename Comporator>
-typename Tree<T, Comporator>::Node* Tree<T, Comporator>::find_max(
-    Node* node) const {
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::Node*
+Tree<T, Comporator, Allocator>::find_max(Node* node) const {
   while (node->rightNode_ != nullptr) {
     node = node->rightNode_;
   }
@@ -393,8 +801,8 @@ typename Tree<T, Comporator>::Node* Tree<T, Comporator>::find_max(
 empty
 */
 
-template <typename T, typename Comporator>
-bool Tree<T, Comporator>::empty() const {
+template <typename T, typename Comporator, typename Allocator>
+bool Tree<T, Comporator, Allocator>::empty() const {
   return root_ == nullptr;
 }
 
@@ -402,37 +810,84 @@ bool Tree<T, Comporator>::empty() const {
 clear
 */
 
-template <typename T, typename Comporator>
-void Tree<T, Comporator>::clear() {
-  if (root_ != nullptr) {
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::clear() {
+  if (root_ != nullptr && !std::is_trivially_destructible<T>::value) {
     deleteTree(root_);
   }
+  pool_.release();
   root_ = nullptr;
+  leftmost_ = nullptr;
+  endNode_->parent_ = nullptr;
   size_ = 0U;
 }
 
-template <typename T, typename Comporator>
-typename Tree<T, Comporator>::iterator Tree<T, Comporator>::find(
-    const_reference key) {
-  auto foundIt = lower_bound(key);
-  if (foundIt != end() && !(comp_(*foundIt, key) || comp_(key, *foundIt))) {
-    return foundIt;
-  } else {
-    return end();
-  }
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::allocator_type
+Tree<T, Comporator, Allocator>::get_allocator() const {
+  return allocator_type(pool_.get_allocator());
+}
+
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::iterator
+Tree<T, Comporator, Allocator>::find(const_reference key) {
+  return iterator(findNode(key), endNode_);
+}
+
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::const_iterator
+Tree<T, Comporator, Allocator>::find(const_reference key) const {
+  return const_iterator(findNode(key), endNode_);
+}
+
+template <typename T, typename Comporator, typename Allocator>
+bool Tree<T, Comporator, Allocator>::contains(const_reference key) {
+  return findNode(key) != endNode_;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+typename Tree<T, Comparator, Allocator>::iterator
+Tree<T, Comparator, Allocator>::lower_bound(const_reference key) {
+  return iterator(lowerBoundNode(key), endNode_);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+typename Tree<T, Comparator, Allocator>::const_iterator
+Tree<T, Comparator, Allocator>::lower_bound(const_reference key) const {
+  return const_iterator(lowerBoundNode(key), endNode_);
 }
 
-template <typename T, typename Comporator>
-bool Tree<T, Comporator>::contains(const_reference key) {
-  if (!empty()) {
-    return find(key) != end();
-  } else
-    return false;
+template <typename T, typename Comparator, typename Allocator>
+typename Tree<T, Comparator, Allocator>::iterator
+Tree<T, Comparator, Allocator>::upper_bound(const_reference key) {
+  return iterator(upperBoundNode(key), endNode_);
 }
 
-template <typename T, typename Comparator>
-typename Tree<T, Comparator>::iterator Tree<T, Comparator>::lower_bound(
-    const_reference key) {
+template <typename T, typename Comparator, typename Allocator>
+typename Tree<T, Comparator, Allocator>::const_iterator
+Tree<T, Comparator, Allocator>::upper_bound(const_reference key) const {
+  return const_iterator(upperBoundNode(key), endNode_);
+}
+
+/*
+findNode, lowerBoundNode, upperBoundNode
+Searches shared by the plain and the transparent lookups: key can be any
+type the comparator accepts next to a value. endNode_ means not found.
+*/
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+typename Tree<T, Comparator, Allocator>::Node*
+Tree<T, Comparator, Allocator>::findNode(const K& key) const {
+  Node* node = lowerBoundNode(key);
+  if (node != endNode_ && comp_(key, node->value_)) node = endNode_;
+  return node;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+typename Tree<T, Comparator, Allocator>::Node*
+Tree<T, Comparator, Allocator>::lowerBoundNode(const K& key) const {
   Node* res = endNode_;
   Node* cur_node = root_;
   while (cur_node) {
@@ -443,12 +898,13 @@ typename Tree<T, Comparator>::iterator Tree<T, Comparator>::lower_bound(
       cur_node = cur_node->rightNode_;
     }
   }
-  return iterator(res, endNode_);
+  return res;
 }
 
-template <typename T, typename Comparator>
-typename Tree<T, Comparator>::iterator Tree<T, Comparator>::upper_bound(
-    const_reference key) {
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+typename Tree<T, Comparator, Allocator>::Node*
+Tree<T, Comparator, Allocator>::upperBoundNode(const K& key) const {
   Node* res = endNode_;
   Node* cur_node = root_;
   while (cur_node) {
@@ -459,117 +915,645 @@ typename Tree<T, Comparator>::iterator Tree<T, Comparator>::upper_bound(
       cur_node = cur_node->rightNode_;
     }
   }
-  return iterator(res, endNode_);
+  return res;
 }
 
-template <typename T, typename Comporator>
-void Tree<T, Comporator>::deleteTree(Node* node) {
-  if (node != nullptr) {
-    deleteTree(node->leftNode_);
-    deleteTree(node->rightNode_);
-    delete node;
-  }
+// Destroys the values only: clear() releases the whole pool right after
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::deleteTree(Node* node) {
+  teardown(node, false);
 }
 
-template <typename T, typename Comporator>
-Tree<T, Comporator>& Tree<T, Comporator>::operator=(const Tree& other) {
+/*
+operator=
+Copies the source shape node for node: the source is already a valid AVL
+tree, so no comparisons or rotations are needed and the copy is O(n).
+*/
+
+template <typename T, typename Comporator, typename Allocator>
+Tree<T, Comporator, Allocator>&
+Tree<T, Comporator, Allocator>::operator=(const Tree& other) {
   if (this != &other) {
     clear();
-    for (auto it = other.begin(); it != other.end(); ++it) {
-      insertNonUniq(*it);
+    comp_ = other.comp_;
+    if (other.root_ != nullptr) {
+      pool_.reserve(other.size_);
+      try {
+        cloneSubtree(other.root_, endNode_, &root_);
+      } catch (...) {
+        clear();
+        throw;
+      }
+      size_ = other.size_;
+      leftmost_ = find_min(root_);
+      endNode_->parent_ = find_max(root_);
     }
   }
   return *this;
 }
 
-template <typename T, typename Comporator>
-Tree<T, Comporator>& Tree<T, Comporator>::operator=(Tree&& other) {
+/*
+cloneSubtree
+Copies in preorder without recursion. The copies whose right subtree is
+still to do wait in a fixed array: source is a valid AVL tree, so at most
+one per level, and far fewer than kMaxHeight. Every node is linked into
+the tree before its children are copied, so a throwing copy constructor
+leaves a well-formed partial tree for clear(). With Move the values are
+taken by std::move_if_noexcept: source stays intact if a copy throws.
+*/
+
+template <typename T, typename Comporator, typename Allocator>
+template <bool Move>
+void Tree<T, Comporator, Allocator>::cloneSubtree(
+    std::conditional_t<Move, Node, const Node>* source, Node* parent,
+    Node** slot) {
+  std::pair<decltype(source), Node*> pending[kMaxHeight];
+  int count = 0;
+  for (;;) {
+    Node* node = nullptr;
+    if constexpr (Move) {
+      node = pool_.create(std::move_if_noexcept(source->value_));
+    } else {
+      node = pool_.create(source->value_);
+    }
+    node->parent_ = parent;
+    node->height_ = source->height_;
+    node->subtreeSize_ = source->subtreeSize_;
+    *slot = node;
+    if (source->rightNode_ != nullptr) {
+      pending[count++] = {source->rightNode_, node};
+    }
+    if (source->leftNode_ != nullptr) {
+      source = source->leftNode_;
+      parent = node;
+      slot = &node->leftNode_;
+    } else if (count > 0) {
+      --count;
+      source = pending[count].first;
+      parent = pending[count].second;
+      slot = &parent->rightNode_;
+    } else {
+      return;
+    }
+  }
+}
+
+template <typename T, typename Comporator, typename Allocator>
+Tree<T, Comporator, Allocator>&
+Tree<T, Comporator, Allocator>::operator=(Tree&& other) {
   if (this != &other) {
     clear();
-    std::swap(root_, other.root_);
-    std::swap(endNode_, other.endNode_);
-    std::swap(size_, other.size_);
+    swap(other);
   }
   return *this;
 }
 
+// -----------------------------------------------------------------------------------------------
+// SET ALGEBRA
+
+/*
+combine
+Adopts the nodes of other (by taking over its pool chunks, or by copying
+them when the allocators differ), runs the recursive algorithm on the two
+detached roots and frees the dropped nodes afterwards. The recursion never
+touches the pool, so its halves can run on separate threads.
+*/
+
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::combine(Tree& other,
+                                             SetOperation operation,
+                                             bool unique) {
+  if (!(pool_.get_allocator() == other.pool_.get_allocator())) {
+    Tree copy(get_allocator());
+    copy = other;
+    other.clear();
+    combine(copy, operation, unique);
+    return;
+  }
+  Node* second = other.root_;
+  pool_.splice(other.pool_);
+  other.root_ = nullptr;
+  other.leftmost_ = nullptr;
+  other.endNode_->parent_ = nullptr;
+  other.size_ = 0U;
+
+  std::vector<Node*> trash;
+  setRoot(combineNodes(root_, second, operation, unique, &trash,
+                       parallelDepth()));
+  for (Node* node : trash) eraseSubtree(node);
+}
+
+// Installs a rebuilt root and refreshes size and the cached extremes
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::setRoot(Node* root) {
+  root_ = root;
+  if (root_) {
+    root_->parent_ = endNode_;
+    size_ = subtreeSize(root_);
+    leftmost_ = find_min(root_);
+    endNode_->parent_ = find_max(root_);
+  } else {
+    leftmost_ = nullptr;
+    endNode_->parent_ = nullptr;
+    size_ = 0U;
+  }
+}
+
+/*
+erase(first, last)
+Removes [first, last) with two splits and one join: O(log n) for the
+structure plus O(k) to free the k removed nodes. Returns last.
+*/
+
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::iterator
+Tree<T, Comporator, Allocator>::erase(iterator first, iterator last) {
+  size_type from = index_of(first);
+  size_type to = index_of(last);
+  if (from == 0U && to == size_) {
+    clear();
+  } else if (from < to) {
+    eraseSubtree(cutRange(from, to));
+  }
+  return last;
+}
+
+/*
+extract
+Moves the keys in [low, high) into a new tree. The tree structure is cut
+in O(log n); the k extracted values are moved into the nodes of the new
+tree, since a tree frees nodes only through its own pool. Move-only values
+are supported; copyable ones whose move may throw are copied.
+*/
+
+template <typename T, typename Comporator, typename Allocator>
+Tree<T, Comporator, Allocator> Tree<T, Comporator, Allocator>::extract(
+    const_reference low, const_reference high) {
+  return extractRange(low, high);
+}
+
+template <typename T, typename Comporator, typename Allocator>
+template <typename K>
+Tree<T, Comporator, Allocator> Tree<T, Comporator, Allocator>::extractRange(
+    const K& low, const K& high) {
+  Tree result(get_allocator());
+  result.comp_ = comp_;
+  size_type from = rank(low);
+  size_type to = rank(high);
+  if (from >= to) return result;
+
+  Node* range = cutRange(from, to);
+  try {
+    result.pool_.reserve(subtreeSize(range));
+    result.cloneSubtree<true>(range, result.endNode_, &result.root_);
+  } catch (...) {
+    result.clear();
+    auto parts = splitAt(root_, from);
+    setRoot(concat(concat(parts.first, range), parts.second));
+    throw;
+  }
+  result.setRoot(result.root_);
+  eraseSubtree(range);
+  return result;
+}
+
+// Detaches the nodes with positions [from, to) and returns them as a
+// balanced subtree
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::Node*
+Tree<T, Comporator, Allocator>::cutRange(size_type from, size_type to) {
+  auto head = splitAt(root_, from);
+  auto tail = splitAt(head.second, to - from);
+  setRoot(concat(head.first, tail.second));
+  return tail.first;
+}
+
+// Splits both trees around the root key of the first one, solves the two
+// sides (in parallel when they are big enough) and joins the results back
+// around whatever survives of the keys equal to the pivot.
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::Node*
+Tree<T, Comporator, Allocator>::combineNodes(Node* first, Node* second,
+                                             SetOperation operation,
+                                             bool unique,
+                                             std::vector<Node*>* trash,
+                                             int depth) const {
+  if (first == nullptr || second == nullptr) {
+    bool keepFirst = operation != SetOperation::kIntersection;
+    bool keepSecond = operation == SetOperation::kUnion ||
+                      operation == SetOperation::kSum;
+    Node* kept = first ? (keepFirst ? first : nullptr)
+                       : (keepSecond ? second : nullptr);
+    Node* dropped = first ? first : second;
+    if (dropped && dropped != kept) trash->push_back(dropped);
+    return kept;
+  }
+
+  const_reference key = first->value_;
+  Split lhs = splitNodes(first, key, unique);
+  Split rhs = splitNodes(second, key, unique);
+
+  Node* less = nullptr;
+  Node* greater = nullptr;
+  std::size_t work = subtreeSize(lhs.less) + subtreeSize(rhs.less);
+  if (depth > 0 && work >= kParallelGrain) {
+    std::vector<Node*> lessTrash;
+    std::future<Node*> lessResult;
+    try {
+      lessResult = std::async(std::launch::async, [&] {
+        return combineNodes(lhs.less, rhs.less, operation, unique,
+                            &lessTrash, depth - 1);
+      });
+    } catch (const std::system_error&) {
+      lessResult = std::future<Node*>();
+    }
+    if (!lessResult.valid()) {
+      less = combineNodes(lhs.less, rhs.less, operation, unique, trash,
+                          depth - 1);
+    }
+    greater = combineNodes(lhs.greater, rhs.greater, operation, unique, trash,
+                           depth - 1);
+    if (lessResult.valid()) {
+      less = lessResult.get();
+      trash->insert(trash->end(), lessTrash.begin(), lessTrash.end());
+    }
+  } else {
+    less = combineNodes(lhs.less, rhs.less, operation, unique, trash, depth);
+    greater = combineNodes(lhs.greater, rhs.greater, operation, unique, trash,
+                           depth);
+  }
+
+  Node* middle = combineEqual(lhs.equal, rhs.equal, operation, trash);
+  if (middle == nullptr) return concat(less, greater);
+  if (subtreeSize(middle) == 1U) return joinNodes(less, middle, greater);
+  return concat(concat(less, middle), greater);
+}
+
+// Decides which of two runs of equal keys survive. Nodes of the first run
+// are preferred, so merge keeps existing values like insert does.
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::Node*
+Tree<T, Comporator, Allocator>::combineEqual(Node* first, Node* second,
+                                             SetOperation operation,
+                                             std::vector<Node*>* trash) const {
+  size_type firstCount = subtreeSize(first);
+  size_type secondCount = subtreeSize(second);
+  Node* result = nullptr;
+  std::pair<Node*, Node*> parts{nullptr, nullptr};
+  switch (operation) {
+    case SetOperation::kUnion:
+      result = first;
+      if (secondCount > firstCount) {
+        parts = splitAt(second, firstCount);
+        result = concat(first, parts.second);
+        second = parts.first;
+      }
+      break;
+    case SetOperation::kSum:
+      result = concat(first, second);
+      second = nullptr;
+      break;
+    case SetOperation::kIntersection:
+      parts = splitAt(first, std::min(firstCount, secondCount));
+      result = parts.first;
+      if (parts.second) trash->push_back(parts.second);
+      break;
+    case SetOperation::kDifference:
+      parts = splitAt(first, std::min(firstCount, secondCount));
+      result = parts.second;
+      if (parts.first) trash->push_back(parts.first);
+      break;
+  }
+  if (second) trash->push_back(second);
+  return result;
+}
+
+/*
+splitNodes
+Splits a detached subtree into keys less than, equal to and greater than
+key. For unique trees the equal part is at most one node and the search
+stops there.
+*/
+
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::Split
+Tree<T, Comporator, Allocator>::splitNodes(Node* node, const_reference key,
+                                           bool unique) const {
+  if (node == nullptr) return Split{nullptr, nullptr, nullptr};
+  Node* left = node->leftNode_;
+  Node* right = node->rightNode_;
+  if (comp_(key, node->value_)) {
+    Split result = splitNodes(left, key, unique);
+    result.greater = joinNodes(result.greater, node, right);
+    return result;
+  }
+  if (comp_(node->value_, key)) {
+    Split result = splitNodes(right, key, unique);
+    result.less = joinNodes(left, node, result.less);
+    return result;
+  }
+  if (unique) return Split{left, link(node, nullptr, nullptr), right};
+  // Equal keys may sit on both sides of a node with the same key
+  Split lower = splitNodes(left, key, unique);
+  Split upper = splitNodes(right, key, unique);
+  return Split{concat(lower.less, lower.greater),
+               joinNodes(lower.equal, node, upper.equal),
+               concat(upper.less, upper.greater)};
+}
+
+// Detaches the rightmost node: {rest of the tree, that node}
+template <typename T, typename Comporator, typename Allocator>
+std::pair<typename Tree<T, Comporator, Allocator>::Node*,
+          typename Tree<T, Comporator, Allocator>::Node*>
+Tree<T, Comporator, Allocator>::splitLast(Node* node) {
+  if (node->rightNode_ == nullptr) {
+    return std::make_pair(node->leftNode_, node);
+  }
+  auto result = splitLast(node->rightNode_);
+  result.first = joinNodes(node->leftNode_, node, result.first);
+  return result;
+}
+
+// Splits off the first index nodes: {first index nodes, the rest}
+template <typename T, typename Comporator, typename Allocator>
+std::pair<typename Tree<T, Comporator, Allocator>::Node*,
+          typename Tree<T, Comporator, Allocator>::Node*>
+Tree<T, Comporator, Allocator>::splitAt(Node* node, size_type index) {
+  if (node == nullptr) return std::make_pair(nullptr, nullptr);
+  Node* left = node->leftNode_;
+  Node* right = node->rightNode_;
+  size_type leftSize = subtreeSize(left);
+  if (index <= leftSize) {
+    auto result = splitAt(left, index);
+    result.second = joinNodes(result.second, node, right);
+    return result;
+  }
+  auto result = splitAt(right, index - leftSize - 1U);
+  result.first = joinNodes(left, node, result.first);
+  return result;
+}
+
+/*
+joinNodes
+Joins two AVL subtrees around a middle node; every key of left must not
+exceed middle and every key of right must not precede it. O(|h(left) -
+h(right)|).
+*/
+
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::Node*
+Tree<T, Comporator, Allocator>::joinNodes(Node* left, Node* middle,
+                                          Node* right) {
+  if (cachedHeight(left) > cachedHeight(right) + 1) {
+    return joinRight(left, middle, right);
+  }
+  if (cachedHeight(right) > cachedHeight(left) + 1) {
+    return joinLeft(left, middle, right);
+  }
+  return link(middle, left, right);
+}
+
+// left is the taller tree: descend its right spine to a matching height
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::Node*
+Tree<T, Comporator, Allocator>::joinRight(Node* left, Node* middle,
+                                          Node* right) {
+  Node* outer = left->leftNode_;
+  Node* inner = left->rightNode_;
+  if (cachedHeight(inner) <= cachedHeight(right) + 1) {
+    Node* joined = link(middle, inner, right);
+    if (cachedHeight(joined) <= cachedHeight(outer) + 1) {
+      return link(left, outer, joined);
+    }
+    return rotateLeft(link(left, outer, rotateRight(joined)));
+  }
+  Node* joined = joinRight(inner, middle, right);
+  link(left, outer, joined);
+  if (cachedHeight(joined) <= cachedHeight(outer) + 1) return left;
+  return rotateLeft(left);
+}
+
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::Node*
+Tree<T, Comporator, Allocator>::joinLeft(Node* left, Node* middle,
+                                         Node* right) {
+  Node* outer = right->rightNode_;
+  Node* inner = right->leftNode_;
+  if (cachedHeight(inner) <= cachedHeight(left) + 1) {
+    Node* joined = link(middle, left, inner);
+    if (cachedHeight(joined) <= cachedHeight(outer) + 1) {
+      return link(right, joined, outer);
+    }
+    return rotateRight(link(right, rotateLeft(joined), outer));
+  }
+  Node* joined = joinLeft(left, middle, inner);
+  link(right, joined, outer);
+  if (cachedHeight(joined) <= cachedHeight(outer) + 1) return right;
+  return rotateRight(right);
+}
+
+// Joins two subtrees without a middle node
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::Node*
+Tree<T, Comporator, Allocator>::concat(Node* left, Node* right) {
+  if (left == nullptr) return right;
+  if (right == nullptr) return left;
+  auto parts = splitLast(left);
+  return joinNodes(parts.first, parts.second, right);
+}
+
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::Node*
+Tree<T, Comporator, Allocator>::link(Node* node, Node* left, Node* right) {
+  node->leftNode_ = left;
+  node->rightNode_ = right;
+  if (left) left->parent_ = node;
+  if (right) right->parent_ = node;
+  refresh(node);
+  return node;
+}
+
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::Node*
+Tree<T, Comporator, Allocator>::rotateLeft(Node* node) {
+  Node* pivot = node->rightNode_;
+  link(node, node->leftNode_, pivot->leftNode_);
+  return link(pivot, node, pivot->rightNode_);
+}
+
+template <typename T, typename Comporator, typename Allocator>
+typename Tree<T, Comporator, Allocator>::Node*
+Tree<T, Comporator, Allocator>::rotateRight(Node* node) {
+  Node* pivot = node->leftNode_;
+  link(node, pivot->rightNode_, node->rightNode_);
+  return link(pivot, pivot->leftNode_, node);
+}
+
+// How many times the recursion may fork: enough for one task per core
+template <typename T, typename Comporator, typename Allocator>
+int Tree<T, Comporator, Allocator>::parallelDepth() {
+  unsigned threads = std::thread::hardware_concurrency();
+  int depth = 0;
+  while ((1U << depth) < threads) ++depth;
+  return depth;
+}
+
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::eraseSubtree(Node* node) {
+  teardown(node, true);
+}
+
+/*
+teardown
+Destroys the subtree of node without recursion or extra memory. While the
+current node has a left child, a right rotation lifts that child above it;
+once it has none, it goes and its right child is next. Every rotation puts
+one node for good on the right spine being freed, so it all takes O(n),
+and as only child links are used, parent links may already be stale.
+recycle hands the nodes back to the pool for reuse.
+*/
+
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::teardown(Node* node, bool recycle) {
+  while (node != nullptr) {
+    Node* left = node->leftNode_;
+    if (left != nullptr) {
+      node->leftNode_ = left->rightNode_;
+      left->rightNode_ = node;
+      node = left;
+    } else {
+      Node* right = node->rightNode_;
+      if (recycle) {
+        pool_.erase(node);
+      } else {
+        pool_.destroy(node);
+      }
+      node = right;
+    }
+  }
+}
+
+/*
+walkSubtree
+Calls visit(node, depth) for every node under top in order, with depth 1
+for top itself. It follows parent links back up instead of keeping a
+stack and never climbs above top.
+*/
+
+template <typename T, typename Comporator, typename Allocator>
+template <typename Visit>
+void Tree<T, Comporator, Allocator>::walkSubtree(Node* top, Visit visit) {
+  if (top == nullptr) return;
+  Node* node = top;
+  int depth = 1;
+  for (;;) {
+    while (node->leftNode_ != nullptr) {
+      node = node->leftNode_;
+      ++depth;
+    }
+    visit(node, depth);
+    // Up to the first node whose right subtree is still to visit
+    while (node->rightNode_ == nullptr) {
+      while (node != top && node->parent_->rightNode_ == node) {
+        node = node->parent_;
+        --depth;
+      }
+      if (node == top) return;
+      node = node->parent_;
+      --depth;
+      visit(node, depth);
+    }
+    node = node->rightNode_;
+    ++depth;
+  }
+}
+
 // -----------------------------------------------------------------------------------------------
 // BALANCE
 
-template <typename T, typename Comporator>
-int Tree<T, Comporator>::getTreeBalance(Node* node) {
+template <typename T, typename Comporator, typename Allocator>
+int Tree<T, Comporator, Allocator>::getTreeBalance(Node* node) {
   if (node == nullptr || node == endNode_) {
     return 0;
   }
-  return heightTree(node->rightNode_) - heightTree(node->leftNode_);
+  return cachedHeight(node->rightNode_) - cachedHeight(node->leftNode_);
 }
 
-template <typename T, typename Comporator>
-void Tree<T, Comporator>::turnLeft(Node** node) {
-  Node* subR = (*node)->rightNode_;
+// Rotations refresh the cached height and size of the two nodes they move,
+// lower one first. *node may alias a child pointer that gets overwritten, so
+// it is read once up front.
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::turnLeft(Node** node) {
+  Node* pivot = *node;
+  Node* subR = pivot->rightNode_;
   Node* subRL = subR->leftNode_;
 
-  (*node)->rightNode_ = subRL;
+  pivot->rightNode_ = subRL;
   if (subRL) {
-    subRL->parent_ = (*node);
+    subRL->parent_ = pivot;
   }
 
-  subR->leftNode_ = (*node);
-  Node* pParent = (*node)->parent_;
-  (*node)->parent_ = subR;
+  subR->leftNode_ = pivot;
+  Node* pParent = pivot->parent_;
+  pivot->parent_ = subR;
   subR->parent_ = pParent;
 
-  if ((*node) == root_) {
+  if (pivot == root_) {
     root_ = subR;
   } else {
-    if (pParent->leftNode_ == (*node)) {
+    if (pParent->leftNode_ == pivot) {
       pParent->leftNode_ = subR;
     } else {
       pParent->rightNode_ = subR;
     }
   }
+  updateHeight(pivot);
+  updateHeight(subR);
 }
 
-template <typename T, typename Comporator>
-void Tree<T, Comporator>::turnRight(Node** node) {
-  Node* subL = (*node)->leftNode_;
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::turnRight(Node** node) {
+  Node* pivot = *node;
+  Node* subL = pivot->leftNode_;
   Node* subLR = subL->rightNode_;
 
-  (*node)->leftNode_ = subLR;
+  pivot->leftNode_ = subLR;
   if (subLR) {
-    subLR->parent_ = (*node);
+    subLR->parent_ = pivot;
   }
 
-  subL->rightNode_ = (*node);
-  Node* pParent = (*node)->parent_;
-  (*node)->parent_ = subL;
+  subL->rightNode_ = pivot;
+  Node* pParent = pivot->parent_;
+  pivot->parent_ = subL;
   subL->parent_ = pParent;
 
-  if ((*node) == root_) {
+  if (pivot == root_) {
     root_ = subL;
   } else {
-    if (pParent->leftNode_ == (*node)) {
+    if (pParent->leftNode_ == pivot) {
       pParent->leftNode_ = subL;
     } else {
       pParent->rightNode_ = subL;
     }
   }
+  updateHeight(pivot);
+  updateHeight(subL);
 }
 
-template <typename T, typename Comporator>
-void Tree<T, Comporator>::turnRightLeft(Node** node) {
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::turnRightLeft(Node** node) {
   turnRight(&(*node)->rightNode_);
   turnLeft(&(*node));
 }
 
-template <typename T, typename Comporator>
-void Tree<T, Comporator>::turnLeftRight(Node** node) {
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::turnLeftRight(Node** node) {
   turnLeft(&(*node)->leftNode_);
   turnRight(&(*node));
 }
 
-template <typename T, typename Comporator>
-void Tree<T, Comporator>::balancingTree(Node** node) {
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::balancingTree(Node** node) {
   if (*node == nullptr || *node == endNode_) {
     return;
   }
@@ -577,11 +1561,13 @@ void Tree<T, Comporator>::balancingTree(Node** node) {
   int rightBalance = getTreeBalance((*node)->rightNode_);
   int rootBalance = getTreeBalance((*node));
 
-  if (rootBalance == 2 && rightBalance == 1) {
+  // A zero child balance only happens after erase; a single rotation fixes
+  // it.
+  if (rootBalance == 2 && rightBalance >= 0) {
     turnLeft(&(*node));
   }
 
-  if (rootBalance == -2 && leftBalance == -1) {
+  if (rootBalance == -2 && leftBalance <= 0) {
     turnRight(&(*node));
   }
 
@@ -597,29 +1583,22 @@ void Tree<T, Comporator>::balancingTree(Node** node) {
 // -----------------------------------------------------------------------------------------------
 // PRINT
 
-template <typename T, typename Comporator>
-void Tree<T, Comporator>::printTree() {
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::printTree() {
   std::cout << "==== TREE ====" << std::endl;
   printTree(root_);
   std::cout << std::endl << "==== TREE ====" << std::endl;
 }
 
-template <typename T, typename Comporator>
-void Tree<T, Comporator>::printTree(Node* node) {
+template <typename T, typename Comporator, typename Allocator>
+void Tree<T, Comporator, Allocator>::printTree(Node* node) {
   if (node != nullptr) {
-    static int depth = 0;
-    if (depth == 0) {
-      std::cout << "root -> ";
-      std::cout << node->value_ << " ";
-      std::cout << "<- root " << std::endl;
-    }
-    depth++;
-
-    printTree(node->leftNode_);
+    std::cout << "root -> ";
     std::cout << node->value_ << " ";
-    printTree(node->rightNode_);
-
-    depth--;
+    std::cout << "<- root " << std::endl;
+    walkSubtree(node, [](Node* current, int) {
+      std::cout << current->value_ << " ";
+    });
   }
 }
 
@@ -0,0 +1,291 @@
+#ifndef S21_B_TREE
+#define S21_B_TREE
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+/*
+BTree
+B+-tree with all values in the leaves and copies of keys in the inner nodes.
+Each node holds about kNodeBytes of payload (four cache lines), so a lookup
+among 10^7 int keys touches 4-5 nodes instead of ~24 in the binary tree.
+Leaves are chained for iteration. Iterators are (leaf, slot) pairs and are
+invalidated by any insert or erase, unlike in Tree.
+Inner keys only bound their subtrees: sep[i - 1] <= keys of child i <=
+sep[i]. They stay valid when values are erased, which keeps erase local.
+*/
+
+// Tags for choosing the storage of the ordered containers
+struct avl_tree_tag {};
+struct btree_tag {};
+
+// Key of a stored value: the value itself for sets, .first for maps
+struct BTreeIdentity {
+  template <typename T>
+  const T& operator()(const T& value) const {
+    return value;
+  }
+};
+
+struct BTreeSelectFirst {
+  template <typename T>
+  const typename T::first_type& operator()(const T& value) const {
+    return value.first;
+  }
+};
+
+template <typename Tree, bool Const>
+class BTreeIterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename Tree::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference =
+      std::conditional_t<Const, const value_type&, value_type&>;
+  using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+  using size_type = typename Tree::size_type;
+
+  BTreeIterator() = default;
+  // iterator converts to const_iterator
+  template <bool C = Const, typename = std::enable_if_t<C>>
+  BTreeIterator(const BTreeIterator<Tree, false>& other)
+      : tree_(other.tree_), leaf_(other.leaf_), index_(other.index_) {}
+
+  reference operator*() const { return leaf_->value(index_); }
+  pointer operator->() const { return &leaf_->value(index_); }
+  BTreeIterator& operator++() {
+    if (++index_ == leaf_->count) {
+      leaf_ = leaf_->next;
+      index_ = 0U;
+    }
+    return *this;
+  }
+  BTreeIterator& operator--() {
+    if (!leaf_) {
+      leaf_ = tree_->last_;
+      index_ = leaf_->count;
+    } else if (!index_) {
+      leaf_ = leaf_->prev;
+      index_ = leaf_->count;
+    }
+    --index_;
+    return *this;
+  }
+  BTreeIterator operator++(int) {
+    BTreeIterator result = *this;
+    ++*this;
+    return result;
+  }
+  BTreeIterator operator--(int) {
+    BTreeIterator result = *this;
+    --*this;
+    return result;
+  }
+  bool operator==(const BTreeIterator& other) const {
+    return leaf_ == other.leaf_ && index_ == other.index_;
+  }
+  bool operator!=(const BTreeIterator& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  using Leaf = typename Tree::Leaf;
+
+  friend Tree;
+  friend class BTreeIterator<Tree, true>;
+
+  BTreeIterator(const Tree* tree, Leaf* leaf, size_type index)
+      : tree_(tree), leaf_(leaf), index_(index) {}
+
+  const Tree* tree_ = nullptr;
+  Leaf* leaf_ = nullptr;  // nullptr is end()
+  size_type index_ = 0U;
+};
+
+template <typename Key, typename Value, typename KeyOf,
+          typename Comparator = std::less<Key>,
+          typename Allocator = std::allocator<Value>>
+class BTree {
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = Allocator;
+  using iterator = BTreeIterator<BTree, false>;
+  using const_iterator = BTreeIterator<BTree, true>;
+
+  BTree() = default;
+  explicit BTree(const Allocator& alloc)
+      : leafAlloc_(alloc), innerAlloc_(alloc) {}
+  BTree(const BTree& other);
+  BTree(BTree&& other) noexcept;
+  ~BTree();
+
+  BTree& operator=(const BTree& other);
+  BTree& operator=(BTree&& other) noexcept;
+
+  iterator begin() { return iterator(this, first_, 0U); }
+  iterator end() { return iterator(this, nullptr, 0U); }
+  const_iterator begin() const { return const_iterator(this, first_, 0U); }
+  const_iterator end() const { return const_iterator(this, nullptr, 0U); }
+
+  bool empty() const { return size_ == 0U; }
+  size_type size() const { return size_; }
+  size_type max_size() const;
+  int height() const;
+  allocator_type get_allocator() const { return allocator_type(leafAlloc_); }
+
+  void clear();
+  void swap(BTree& other) noexcept;
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last, bool unique);
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(bool unique, Args&&... args);
+  std::pair<iterator, bool> insert(const value_type& value, bool unique);
+  std::pair<iterator, bool> insert(value_type&& value, bool unique);
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+
+  template <typename K>
+  iterator find(const K& key) {
+    return findPosition(key);
+  }
+  template <typename K>
+  const_iterator find(const K& key) const {
+    return findPosition(key);
+  }
+  template <typename K>
+  iterator lower_bound(const K& key) {
+    return bound<false>(key);
+  }
+  template <typename K>
+  const_iterator lower_bound(const K& key) const {
+    return bound<false>(key);
+  }
+  template <typename K>
+  iterator upper_bound(const K& key) {
+    return bound<true>(key);
+  }
+  template <typename K>
+  const_iterator upper_bound(const K& key) const {
+    return bound<true>(key);
+  }
+  template <typename K>
+  bool contains(const K& key) const {
+    return findPosition(key).leaf_ != nullptr;
+  }
+  template <typename K>
+  size_type count(const K& key) const;
+
+  static constexpr size_type kNodeBytes = 256U;
+  // Values per leaf and keys per inner node
+  static constexpr size_type kLeafSlots =
+      kNodeBytes / sizeof(Value) < 4U ? 4U : kNodeBytes / sizeof(Value);
+  static constexpr size_type kInnerSlots =
+      kNodeBytes / (sizeof(Key) + sizeof(void*)) < 4U
+          ? 4U
+          : kNodeBytes / (sizeof(Key) + sizeof(void*));
+
+ private:
+  template <typename, bool>
+  friend class BTreeIterator;
+
+  static constexpr size_type kLeafMin = kLeafSlots / 2U;
+  static constexpr size_type kInnerMin = kInnerSlots / 2U;
+
+  struct Inner;
+  struct Node {
+    Inner* parent;
+    std::uint16_t position;  // index in parent->children
+    std::uint16_t count;     // values in a leaf, keys in an inner node
+    bool leaf;
+  };
+  struct Leaf : Node {
+    Leaf* prev;
+    Leaf* next;
+    alignas(Value) unsigned char storage[kLeafSlots * sizeof(Value)];
+
+    Value* slot(size_type i) { return reinterpret_cast<Value*>(storage) + i; }
+    Value& value(size_type i) { return *std::launder(slot(i)); }
+  };
+  // One spare key and child let an inner node overflow before it splits
+  struct Inner : Node {
+    alignas(Key) unsigned char storage[(kInnerSlots + 1U) * sizeof(Key)];
+    Node* children[kInnerSlots + 2U];
+
+    Key* slot(size_type i) { return reinterpret_cast<Key*>(storage) + i; }
+    Key& key(size_type i) { return *std::launder(slot(i)); }
+  };
+
+  using leaf_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Leaf>;
+  using inner_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Inner>;
+  using leaf_traits = std::allocator_traits<leaf_allocator>;
+  using inner_traits = std::allocator_traits<inner_allocator>;
+
+  static const Key& keyOf(const Value& value) { return KeyOf()(value); }
+
+  template <bool Upper, typename Get, typename K>
+  size_type search(Get get, size_type count, const K& key) const;
+  template <bool Upper, typename K>
+  size_type searchLeaf(Leaf* leaf, const K& key) const;
+  template <bool Upper, typename K>
+  Leaf* descend(const K& key) const;
+  template <bool Upper, typename K>
+  iterator bound(const K& key) const;
+  template <typename K>
+  iterator findPosition(const K& key) const;
+
+  template <typename V>
+  std::pair<iterator, bool> insertValue(V&& value, bool unique);
+  template <typename V>
+  iterator placeInLeaf(Leaf* leaf, size_type index, V&& value);
+  void insertSeparator(Node* left, Key&& key, Node* right);
+  void splitInner(Inner* node);
+
+  void fixLeaf(Leaf* leaf, Leaf** next, size_type* nextIndex);
+  void mergeLeaves(Leaf* left, Leaf* right);
+  void fixInner(Inner* node);
+  void mergeInner(Inner* left, Inner* right);
+  void eraseSlot(Inner* node, size_type index);
+  static void setChild(Inner* node, size_type index, Node* child);
+
+  static void moveValue(Leaf* from, size_type i, Leaf* to, size_type j);
+  static void moveKey(Inner* from, size_type i, Inner* to, size_type j);
+
+  Leaf* newLeaf();
+  void reserveSpare(size_type count);
+  Inner* takeSpare();
+  void destroyNode(Node* node);
+  void freeLeaf(Leaf* leaf);
+  void freeInner(Inner* inner);
+
+  Node* root_ = nullptr;
+  Leaf* first_ = nullptr;
+  Leaf* last_ = nullptr;
+  // Inner nodes allocated ahead of a split, chained through parent, so that
+  // a failed allocation never leaves a half split tree behind
+  Inner* spare_ = nullptr;
+  size_type spareCount_ = 0U;
+  size_type size_ = 0U;
+  Comparator comp_;
+  leaf_allocator leafAlloc_;
+  inner_allocator innerAlloc_;
+};
+
+}  // namespace s21
+
+#include "BTree.tpp"
+
+#endif
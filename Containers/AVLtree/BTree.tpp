@@ -0,0 +1,712 @@
+#include "BTree.h"
+
+namespace s21 {
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+BTree<Key, Value, KeyOf, Comparator, Allocator>::BTree(const BTree& other)
+    : comp_(other.comp_),
+      leafAlloc_(leaf_traits::select_on_container_copy_construction(
+          other.leafAlloc_)),
+      innerAlloc_(inner_traits::select_on_container_copy_construction(
+          other.innerAlloc_)) {
+  try {
+    for (const Value& value : other) {
+      placeInLeaf(last_, last_ ? last_->count : 0U, value);
+    }
+  } catch (...) {
+    clear();
+    reserveSpare(0U);
+    throw;
+  }
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+BTree<Key, Value, KeyOf, Comparator, Allocator>::BTree(BTree&& other) noexcept
+    : comp_(other.comp_),
+      leafAlloc_(other.leafAlloc_),
+      innerAlloc_(other.innerAlloc_) {
+  swap(other);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+BTree<Key, Value, KeyOf, Comparator, Allocator>::~BTree() {
+  clear();
+  while (spare_) freeInner(takeSpare());
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+BTree<Key, Value, KeyOf, Comparator, Allocator>&
+BTree<Key, Value, KeyOf, Comparator, Allocator>::operator=(
+    const BTree& other) {
+  if (this != &other) {
+    BTree copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+BTree<Key, Value, KeyOf, Comparator, Allocator>&
+BTree<Key, Value, KeyOf, Comparator, Allocator>::operator=(
+    BTree&& other) noexcept {
+  if (this != &other) {
+    BTree moved(std::move(other));
+    swap(moved);
+  }
+  return *this;
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+void BTree<Key, Value, KeyOf, Comparator, Allocator>::swap(
+    BTree& other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(first_, other.first_);
+  std::swap(last_, other.last_);
+  std::swap(spare_, other.spare_);
+  std::swap(spareCount_, other.spareCount_);
+  std::swap(size_, other.size_);
+  std::swap(comp_, other.comp_);
+  std::swap(leafAlloc_, other.leafAlloc_);
+  std::swap(innerAlloc_, other.innerAlloc_);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+typename BTree<Key, Value, KeyOf, Comparator, Allocator>::size_type
+BTree<Key, Value, KeyOf, Comparator, Allocator>::max_size() const {
+  return std::allocator_traits<Allocator>::max_size(get_allocator());
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+int BTree<Key, Value, KeyOf, Comparator, Allocator>::height() const {
+  int height = 0;
+  for (const Node* node = root_; node;
+       node = node->leaf ? nullptr
+                         : static_cast<const Inner*>(node)->children[0]) {
+    ++height;
+  }
+  return height;
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+void BTree<Key, Value, KeyOf, Comparator, Allocator>::clear() {
+  if (root_) destroyNode(root_);
+  root_ = nullptr;
+  first_ = last_ = nullptr;
+  size_ = 0U;
+}
+
+/*
+assign
+Replaces the contents with [first, last). Every element that sorts after
+the current last one is appended to the last leaf without a search, and a
+full last leaf is split off empty instead of in half, so sorted input is
+loaded in O(n) with full leaves.
+*/
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+template <typename InputIt>
+void BTree<Key, Value, KeyOf, Comparator, Allocator>::assign(InputIt first,
+                                                             InputIt last,
+                                                             bool unique) {
+  clear();
+  for (; first != last; ++first) {
+    bool append = false;
+    if (last_) {
+      const Key& back = keyOf(last_->value(last_->count - 1U));
+      const Key& key = keyOf(*first);
+      append = unique ? comp_(back, key) : !comp_(key, back);
+    }
+    if (append) {
+      placeInLeaf(last_, last_->count, *first);
+    } else {
+      insertValue(*first, unique);
+    }
+  }
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+template <typename... Args>
+std::pair<typename BTree<Key, Value, KeyOf, Comparator, Allocator>::iterator,
+          bool>
+BTree<Key, Value, KeyOf, Comparator, Allocator>::emplace(bool unique,
+                                                         Args&&... args) {
+  // The key is needed before the slot is known
+  Value value(std::forward<Args>(args)...);
+  return insertValue(std::move(value), unique);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+std::pair<typename BTree<Key, Value, KeyOf, Comparator, Allocator>::iterator,
+          bool>
+BTree<Key, Value, KeyOf, Comparator, Allocator>::insert(
+    const value_type& value, bool unique) {
+  return insertValue(value, unique);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+std::pair<typename BTree<Key, Value, KeyOf, Comparator, Allocator>::iterator,
+          bool>
+BTree<Key, Value, KeyOf, Comparator, Allocator>::insert(value_type&& value,
+                                                        bool unique) {
+  return insertValue(std::move(value), unique);
+}
+
+/*
+insertValue
+Unique values go before the first equal key so that it can be found next
+to the slot; others go after the last equal key, as in Tree.
+*/
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+template <typename V>
+std::pair<typename BTree<Key, Value, KeyOf, Comparator, Allocator>::iterator,
+          bool>
+BTree<Key, Value, KeyOf, Comparator, Allocator>::insertValue(V&& value,
+                                                             bool unique) {
+  if (!root_) return {placeInLeaf(nullptr, 0U, std::forward<V>(value)), true};
+  const Key& key = keyOf(value);
+  if (unique) {
+    Leaf* leaf = descend<false>(key);
+    size_type index = searchLeaf<false>(leaf, key);
+    iterator found(this, leaf, index);
+    if (index == leaf->count) found = iterator(this, leaf->next, 0U);
+    if (found.leaf_ && !comp_(key, keyOf(*found))) return {found, false};
+    return {placeInLeaf(leaf, index, std::forward<V>(value)), true};
+  }
+  Leaf* leaf = descend<true>(key);
+  size_type index = searchLeaf<true>(leaf, key);
+  return {placeInLeaf(leaf, index, std::forward<V>(value)), true};
+}
+
+/*
+placeInLeaf
+Puts value at index of leaf, splitting the leaf when it is full. A null
+leaf starts an empty tree. The value is built before anything is touched
+and the nodes a split needs are allocated up front, so an exception leaves
+the tree as it was. Stored values are only moved afterwards.
+*/
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+template <typename V>
+typename BTree<Key, Value, KeyOf, Comparator, Allocator>::iterator
+BTree<Key, Value, KeyOf, Comparator, Allocator>::placeInLeaf(Leaf* leaf,
+                                                             size_type index,
+                                                             V&& value) {
+  Value item(std::forward<V>(value));
+  if (!leaf) {
+    leaf = newLeaf();
+    root_ = first_ = last_ = leaf;
+  }
+  if (leaf->count < kLeafSlots) {
+    for (size_type i = leaf->count; i > index; --i) {
+      moveValue(leaf, i - 1U, leaf, i);
+    }
+    ::new (static_cast<void*>(leaf->slot(index))) Value(std::move(item));
+    ++leaf->count;
+    ++size_;
+    return iterator(this, leaf, index);
+  }
+
+  // Appending to the last leaf leaves it full and starts a new one
+  size_type middle =
+      index == kLeafSlots && !leaf->next ? kLeafSlots : kLeafSlots / 2U;
+  Key separator(middle < kLeafSlots ? keyOf(leaf->value(middle))
+                                    : keyOf(item));
+  size_type splits = 0U;
+  Inner* parent = leaf->parent;
+  for (; parent && parent->count == kInnerSlots; parent = parent->parent) {
+    ++splits;
+  }
+  reserveSpare(parent ? splits : splits + 1U);
+  Leaf* right = newLeaf();
+
+  for (size_type i = middle; i < kLeafSlots; ++i) {
+    moveValue(leaf, i, right, i - middle);
+  }
+  right->count = static_cast<std::uint16_t>(kLeafSlots - middle);
+  leaf->count = static_cast<std::uint16_t>(middle);
+  right->prev = leaf;
+  right->next = leaf->next;
+  if (leaf->next) {
+    leaf->next->prev = right;
+  } else {
+    last_ = right;
+  }
+  leaf->next = right;
+
+  Leaf* target = index <= middle && middle < kLeafSlots ? leaf : right;
+  size_type position = target == leaf ? index : index - middle;
+  for (size_type i = target->count; i > position; --i) {
+    moveValue(target, i - 1U, target, i);
+  }
+  ::new (static_cast<void*>(target->slot(position))) Value(std::move(item));
+  ++target->count;
+  ++size_;
+  insertSeparator(leaf, std::move(separator), right);
+  return iterator(this, target, position);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+void BTree<Key, Value, KeyOf, Comparator, Allocator>::insertSeparator(
+    Node* left, Key&& key, Node* right) {
+  Inner* parent = left->parent;
+  if (!parent) {
+    Inner* root = takeSpare();
+    ::new (static_cast<void*>(root->slot(0U))) Key(std::move(key));
+    root->count = 1U;
+    setChild(root, 0U, left);
+    setChild(root, 1U, right);
+    root_ = root;
+    return;
+  }
+  size_type index = left->position;
+  for (size_type i = parent->count; i > index; --i) {
+    moveKey(parent, i - 1U, parent, i);
+    setChild(parent, i + 1U, parent->children[i]);
+  }
+  ::new (static_cast<void*>(parent->slot(index))) Key(std::move(key));
+  setChild(parent, index + 1U, right);
+  ++parent->count;
+  if (parent->count > kInnerSlots) splitInner(parent);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+void BTree<Key, Value, KeyOf, Comparator, Allocator>::splitInner(
+    Inner* node) {
+  Inner* right = takeSpare();
+  size_type middle = node->count / 2U;
+  for (size_type i = middle + 1U; i < node->count; ++i) {
+    moveKey(node, i, right, i - middle - 1U);
+  }
+  for (size_type i = middle + 1U; i <= node->count; ++i) {
+    setChild(right, i - middle - 1U, node->children[i]);
+  }
+  right->count = static_cast<std::uint16_t>(node->count - middle - 1U);
+  node->count = static_cast<std::uint16_t>(middle);
+  Key median(std::move(node->key(middle)));
+  node->key(middle).~Key();
+  insertSeparator(node, std::move(median), right);
+}
+
+/*
+erase
+Removes the value at pos and returns the position of the next value. An
+underfull leaf borrows from or merges with a sibling, and the fix goes up
+through the inner nodes the same way.
+*/
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+typename BTree<Key, Value, KeyOf, Comparator, Allocator>::iterator
+BTree<Key, Value, KeyOf, Comparator, Allocator>::erase(const_iterator pos) {
+  Leaf* leaf = pos.leaf_;
+  size_type index = pos.index_;
+  leaf->value(index).~Value();
+  for (size_type i = index + 1U; i < leaf->count; ++i) {
+    moveValue(leaf, i, leaf, i - 1U);
+  }
+  --leaf->count;
+  --size_;
+  Leaf* next = leaf;
+  size_type nextIndex = index;
+  if (index == leaf->count) {
+    next = leaf->next;
+    nextIndex = 0U;
+  }
+  if (leaf == root_) {
+    if (!leaf->count) {
+      freeLeaf(leaf);
+      root_ = first_ = last_ = nullptr;
+    }
+  } else if (leaf->count < kLeafMin) {
+    fixLeaf(leaf, &next, &nextIndex);
+  }
+  return iterator(this, next, nextIndex);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+typename BTree<Key, Value, KeyOf, Comparator, Allocator>::iterator
+BTree<Key, Value, KeyOf, Comparator, Allocator>::erase(const_iterator first,
+                                                       const_iterator last) {
+  // Rebalancing moves values between leaves, so last would not survive
+  size_type count = 0U;
+  for (const_iterator it = first; it != last; ++it) ++count;
+  iterator result(this, first.leaf_, first.index_);
+  for (; count; --count) result = erase(result);
+  return result;
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+void BTree<Key, Value, KeyOf, Comparator, Allocator>::fixLeaf(
+    Leaf* leaf, Leaf** next, size_type* nextIndex) {
+  Inner* parent = leaf->parent;
+  size_type index = leaf->position;
+  Leaf* left =
+      index ? static_cast<Leaf*>(parent->children[index - 1U]) : nullptr;
+  Leaf* right = index < parent->count
+                    ? static_cast<Leaf*>(parent->children[index + 1U])
+                    : nullptr;
+  if (left && left->count > kLeafMin) {
+    for (size_type i = leaf->count; i; --i) moveValue(leaf, i - 1U, leaf, i);
+    moveValue(left, left->count - 1U, leaf, 0U);
+    --left->count;
+    ++leaf->count;
+    parent->key(index - 1U) = keyOf(leaf->value(0U));
+    if (*next == leaf) ++*nextIndex;
+  } else if (right && right->count > kLeafMin) {
+    moveValue(right, 0U, leaf, leaf->count);
+    ++leaf->count;
+    for (size_type i = 1U; i < right->count; ++i) {
+      moveValue(right, i, right, i - 1U);
+    }
+    --right->count;
+    parent->key(index) = keyOf(right->value(0U));
+    if (*next == right) {
+      *next = leaf;
+      *nextIndex = leaf->count - 1U;
+    }
+  } else if (left) {
+    if (*next == leaf) {
+      *next = left;
+      *nextIndex += left->count;
+    }
+    mergeLeaves(left, leaf);
+  } else {
+    if (*next == right) {
+      *next = leaf;
+      *nextIndex += leaf->count;
+    }
+    mergeLeaves(leaf, right);
+  }
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+void BTree<Key, Value, KeyOf, Comparator, Allocator>::mergeLeaves(
+    Leaf* left, Leaf* right) {
+  for (size_type i = 0U; i < right->count; ++i) {
+    moveValue(right, i, left, left->count + i);
+  }
+  left->count = static_cast<std::uint16_t>(left->count + right->count);
+  right->count = 0U;
+  left->next = right->next;
+  if (right->next) {
+    right->next->prev = left;
+  } else {
+    last_ = left;
+  }
+  Inner* parent = right->parent;
+  parent->key(right->position - 1U).~Key();
+  eraseSlot(parent, right->position - 1U);
+  freeLeaf(right);
+  fixInner(parent);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+void BTree<Key, Value, KeyOf, Comparator, Allocator>::fixInner(Inner* node) {
+  if (node == root_) {
+    if (!node->count) {
+      root_ = node->children[0];
+      root_->parent = nullptr;
+      root_->position = 0U;
+      freeInner(node);
+    }
+    return;
+  }
+  if (node->count >= kInnerMin) return;
+  Inner* parent = node->parent;
+  size_type index = node->position;
+  Inner* left =
+      index ? static_cast<Inner*>(parent->children[index - 1U]) : nullptr;
+  Inner* right = index < parent->count
+                     ? static_cast<Inner*>(parent->children[index + 1U])
+                     : nullptr;
+  if (left && left->count > kInnerMin) {
+    // Rotate the last child of left through the parent key
+    setChild(node, node->count + 1U, node->children[node->count]);
+    for (size_type i = node->count; i; --i) {
+      moveKey(node, i - 1U, node, i);
+      setChild(node, i, node->children[i - 1U]);
+    }
+    moveKey(parent, index - 1U, node, 0U);
+    moveKey(left, left->count - 1U, parent, index - 1U);
+    setChild(node, 0U, left->children[left->count]);
+    --left->count;
+    ++node->count;
+  } else if (right && right->count > kInnerMin) {
+    moveKey(parent, index, node, node->count);
+    moveKey(right, 0U, parent, index);
+    setChild(node, node->count + 1U, right->children[0]);
+    ++node->count;
+    for (size_type i = 1U; i < right->count; ++i) {
+      moveKey(right, i, right, i - 1U);
+    }
+    for (size_type i = 1U; i <= right->count; ++i) {
+      setChild(right, i - 1U, right->children[i]);
+    }
+    --right->count;
+  } else if (left) {
+    mergeInner(left, node);
+  } else {
+    mergeInner(node, right);
+  }
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+void BTree<Key, Value, KeyOf, Comparator, Allocator>::mergeInner(
+    Inner* left, Inner* right) {
+  Inner* parent = left->parent;
+  size_type index = left->position;
+  size_type offset = left->count + 1U;
+  moveKey(parent, index, left, left->count);
+  for (size_type i = 0U; i < right->count; ++i) {
+    moveKey(right, i, left, offset + i);
+  }
+  for (size_type i = 0U; i <= right->count; ++i) {
+    setChild(left, offset + i, right->children[i]);
+  }
+  left->count = static_cast<std::uint16_t>(offset + right->count);
+  right->count = 0U;
+  eraseSlot(parent, index);
+  freeInner(right);
+  fixInner(parent);
+}
+
+// Closes the gap left by key index and the child right of it; the key
+// itself is already gone
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+void BTree<Key, Value, KeyOf, Comparator, Allocator>::eraseSlot(
+    Inner* node, size_type index) {
+  for (size_type i = index + 1U; i < node->count; ++i) {
+    moveKey(node, i, node, i - 1U);
+    setChild(node, i, node->children[i + 1U]);
+  }
+  --node->count;
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+void BTree<Key, Value, KeyOf, Comparator, Allocator>::setChild(
+    Inner* node, size_type index, Node* child) {
+  node->children[index] = child;
+  child->parent = node;
+  child->position = static_cast<std::uint16_t>(index);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+void BTree<Key, Value, KeyOf, Comparator, Allocator>::moveValue(
+    Leaf* from, size_type i, Leaf* to, size_type j) {
+  ::new (static_cast<void*>(to->slot(j))) Value(std::move(from->value(i)));
+  from->value(i).~Value();
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+void BTree<Key, Value, KeyOf, Comparator, Allocator>::moveKey(
+    Inner* from, size_type i, Inner* to, size_type j) {
+  ::new (static_cast<void*>(to->slot(j))) Key(std::move(from->key(i)));
+  from->key(i).~Key();
+}
+
+/*
+search
+Slot of the first key not less than key, or greater than key when Upper.
+Arithmetic keys under std::less are counted in one branch-free pass that
+the compiler turns into SIMD compares; a node is only a few cache lines, so
+this beats the mispredicted branches of a binary search.
+*/
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+template <bool Upper, typename Get, typename K>
+typename BTree<Key, Value, KeyOf, Comparator, Allocator>::size_type
+BTree<Key, Value, KeyOf, Comparator, Allocator>::search(
+    Get get, size_type count, const K& key) const {
+  if constexpr (std::is_arithmetic_v<Key> && std::is_same_v<K, Key> &&
+                (std::is_same_v<Comparator, std::less<Key>> ||
+                 std::is_same_v<Comparator, std::less<>>)) {
+    size_type result = 0U;
+    for (size_type i = 0U; i < count; ++i) {
+      result += Upper ? !(key < get(i)) : get(i) < key;
+    }
+    return result;
+  } else {
+    size_type low = 0U;
+    while (count) {
+      size_type half = count / 2U;
+      bool before =
+          Upper ? !comp_(key, get(low + half)) : comp_(get(low + half), key);
+      if (before) {
+        low += half + 1U;
+        count -= half + 1U;
+      } else {
+        count = half;
+      }
+    }
+    return low;
+  }
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+template <bool Upper, typename K>
+typename BTree<Key, Value, KeyOf, Comparator, Allocator>::size_type
+BTree<Key, Value, KeyOf, Comparator, Allocator>::searchLeaf(
+    Leaf* leaf, const K& key) const {
+  return search<Upper>(
+      [leaf](size_type i) -> const Key& { return keyOf(leaf->value(i)); },
+      leaf->count, key);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+template <bool Upper, typename K>
+typename BTree<Key, Value, KeyOf, Comparator, Allocator>::Leaf*
+BTree<Key, Value, KeyOf, Comparator, Allocator>::descend(
+    const K& key) const {
+  Node* node = root_;
+  while (!node->leaf) {
+    Inner* inner = static_cast<Inner*>(node);
+    size_type index = search<Upper>(
+        [inner](size_type i) -> const Key& { return inner->key(i); },
+        inner->count, key);
+    node = inner->children[index];
+  }
+  return static_cast<Leaf*>(node);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+template <bool Upper, typename K>
+typename BTree<Key, Value, KeyOf, Comparator, Allocator>::iterator
+BTree<Key, Value, KeyOf, Comparator, Allocator>::bound(const K& key) const {
+  if (!root_) return iterator(this, nullptr, 0U);
+  Leaf* leaf = descend<Upper>(key);
+  size_type index = searchLeaf<Upper>(leaf, key);
+  // Every key of the next leaf is past the bound already
+  if (index == leaf->count) return iterator(this, leaf->next, 0U);
+  return iterator(this, leaf, index);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+template <typename K>
+typename BTree<Key, Value, KeyOf, Comparator, Allocator>::iterator
+BTree<Key, Value, KeyOf, Comparator, Allocator>::findPosition(
+    const K& key) const {
+  iterator it = bound<false>(key);
+  if (it.leaf_ && comp_(key, keyOf(*it))) it = iterator(this, nullptr, 0U);
+  return it;
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+template <typename K>
+typename BTree<Key, Value, KeyOf, Comparator, Allocator>::size_type
+BTree<Key, Value, KeyOf, Comparator, Allocator>::count(const K& key) const {
+  size_type result = 0U;
+  for (const_iterator it = lower_bound(key);
+       it != end() && !comp_(key, keyOf(*it)); ++it) {
+    ++result;
+  }
+  return result;
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+typename BTree<Key, Value, KeyOf, Comparator, Allocator>::Leaf*
+BTree<Key, Value, KeyOf, Comparator, Allocator>::newLeaf() {
+  Leaf* leaf = leaf_traits::allocate(leafAlloc_, 1U);
+  ::new (static_cast<void*>(leaf)) Leaf;
+  leaf->parent = nullptr;
+  leaf->position = leaf->count = 0U;
+  leaf->leaf = true;
+  leaf->prev = leaf->next = nullptr;
+  return leaf;
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+void BTree<Key, Value, KeyOf, Comparator, Allocator>::reserveSpare(
+    size_type count) {
+  while (spareCount_ < count) {
+    Inner* inner = inner_traits::allocate(innerAlloc_, 1U);
+    ::new (static_cast<void*>(inner)) Inner;
+    inner->parent = spare_;
+    spare_ = inner;
+    ++spareCount_;
+  }
+  // count == 0 returns every spare node, as after a failed copy
+  while (!count && spare_) freeInner(takeSpare());
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+typename BTree<Key, Value, KeyOf, Comparator, Allocator>::Inner*
+BTree<Key, Value, KeyOf, Comparator, Allocator>::takeSpare() {
+  Inner* inner = spare_;
+  spare_ = inner->parent;
+  --spareCount_;
+  inner->parent = nullptr;
+  inner->position = inner->count = 0U;
+  inner->leaf = false;
+  return inner;
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+void BTree<Key, Value, KeyOf, Comparator, Allocator>::destroyNode(
+    Node* node) {
+  if (node->leaf) {
+    Leaf* leaf = static_cast<Leaf*>(node);
+    for (size_type i = 0U; i < leaf->count; ++i) leaf->value(i).~Value();
+    freeLeaf(leaf);
+  } else {
+    Inner* inner = static_cast<Inner*>(node);
+    for (size_type i = 0U; i <= inner->count; ++i) {
+      destroyNode(inner->children[i]);
+    }
+    for (size_type i = 0U; i < inner->count; ++i) inner->key(i).~Key();
+    freeInner(inner);
+  }
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+void BTree<Key, Value, KeyOf, Comparator, Allocator>::freeLeaf(Leaf* leaf) {
+  leaf->~Leaf();
+  leaf_traits::deallocate(leafAlloc_, leaf, 1U);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Comparator,
+          typename Allocator>
+void BTree<Key, Value, KeyOf, Comparator, Allocator>::freeInner(
+    Inner* inner) {
+  inner->~Inner();
+  inner_traits::deallocate(innerAlloc_, inner, 1U);
+}
+
+}  // namespace s21
@@ -0,0 +1,203 @@
+#ifndef S21_COMPACT_TREE
+#define S21_COMPACT_TREE
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+/*
+CompactTree
+AVL tree whose nodes live in one growable array and link to each other by
+32-bit indices instead of pointers. A node is the value, three indices and
+an int8_t height: 20 bytes for int instead of 40 in Tree. Index 0 is the
+null link and the end() position. Freed slots are chained through their
+left index and reused.
+Unlike Tree, an insert that finds no free slot and a full array (see
+capacity()) moves every element into a bigger array: references and
+pointers to elements are invalidated, iterators are not, as they hold an
+index. reserve() ahead of the inserts keeps references valid. erase only
+invalidates the erased element.
+*/
+
+template <typename T, typename Comparator = std::less<T>,
+          typename Allocator = std::allocator<T>>
+class CompactTree;
+
+template <typename Tree, bool Const>
+class CompactIterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename Tree::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference =
+      std::conditional_t<Const, const value_type&, value_type&>;
+  using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+  using index_type = typename Tree::index_type;
+  using tree_pointer = std::conditional_t<Const, const Tree*, Tree*>;
+
+  CompactIterator() = default;
+  CompactIterator(tree_pointer tree, index_type index)
+      : tree_(tree), index_(index) {}
+  // iterator converts to const_iterator
+  template <bool C = Const, typename = std::enable_if_t<C>>
+  CompactIterator(const CompactIterator<Tree, false>& other)
+      : tree_(other.tree_), index_(other.index_) {}
+
+  reference operator*() const { return tree_->value(index_); }
+  pointer operator->() const { return &tree_->value(index_); }
+  CompactIterator& operator++() {
+    index_ = tree_->next(index_);
+    return *this;
+  }
+  CompactIterator& operator--() {
+    index_ = tree_->prev(index_);
+    return *this;
+  }
+  CompactIterator operator++(int) {
+    CompactIterator result = *this;
+    ++*this;
+    return result;
+  }
+  CompactIterator operator--(int) {
+    CompactIterator result = *this;
+    --*this;
+    return result;
+  }
+  bool operator==(const CompactIterator& other) const {
+    return index_ == other.index_;
+  }
+  bool operator!=(const CompactIterator& other) const {
+    return index_ != other.index_;
+  }
+
+  index_type getIndex() const { return index_; }
+
+ private:
+  friend class CompactIterator<Tree, true>;
+
+  tree_pointer tree_ = nullptr;
+  index_type index_ = 0U;
+};
+
+template <typename T, typename Comparator, typename Allocator>
+class CompactTree {
+ public:
+  using value_type = T;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using index_type = std::uint32_t;
+  using allocator_type = Allocator;
+  using iterator = CompactIterator<CompactTree, false>;
+  using const_iterator = CompactIterator<CompactTree, true>;
+
+  CompactTree() = default;
+  explicit CompactTree(const Allocator& alloc) : alloc_(alloc) {}
+  CompactTree(const CompactTree& other);
+  CompactTree(CompactTree&& other) noexcept;
+  ~CompactTree();
+
+  CompactTree& operator=(const CompactTree& other);
+  CompactTree& operator=(CompactTree&& other) noexcept;
+
+  iterator begin() { return iterator(this, first()); }
+  iterator end() { return iterator(this, 0U); }
+  const_iterator begin() const { return const_iterator(this, first()); }
+  const_iterator end() const { return const_iterator(this, 0U); }
+
+  bool empty() const { return size_ == 0U; }
+  size_type size() const { return size_; }
+  size_type max_size() const;
+  size_type capacity() const { return capacity_ ? capacity_ - 1U : 0U; }
+  int height() const { return heightOf(root_); }
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+  void clear();
+  void reserve(size_type count);
+  void swap(CompactTree& other) noexcept;
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(bool unique, Args&&... args);
+  std::pair<iterator, bool> insert(const value_type& value, bool unique);
+  std::pair<iterator, bool> insert(value_type&& value, bool unique);
+  iterator erase(const_iterator pos);
+
+  template <typename K>
+  iterator find(const K& key);
+  template <typename K>
+  iterator lower_bound(const K& key);
+  template <typename K>
+  iterator upper_bound(const K& key);
+  template <typename K>
+  bool contains(const K& key) const;
+
+  // Bytes taken by one node in the array
+  static constexpr size_type node_size() { return sizeof(Slot); }
+
+ private:
+  template <typename, bool>
+  friend class CompactIterator;
+
+  struct Slot {
+    alignas(T) unsigned char storage[sizeof(T)];
+    index_type left;
+    index_type right;
+    index_type parent;
+    std::int8_t height;  // 0 marks a free slot
+  };
+  using slot_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+  using slot_traits = std::allocator_traits<slot_allocator>;
+
+  T& value(index_type index) const {
+    return *std::launder(reinterpret_cast<T*>(slots_[index].storage));
+  }
+  int heightOf(index_type index) const {
+    return index ? slots_[index].height : 0;
+  }
+  index_type first() const;
+  index_type last() const;
+  index_type next(index_type index) const;
+  index_type prev(index_type index) const;
+  template <typename K>
+  index_type lowerBoundIndex(const K& key) const;
+
+  template <typename V>
+  std::pair<iterator, bool> insertValue(bool unique, V&& item);
+  template <typename... Args>
+  index_type createSlot(Args&&... args);
+  void freeSlot(index_type index);
+  void relocate(Slot* slots, size_type count);
+  void destroyAll();
+  void transplant(index_type from, index_type to);
+
+  void fixHeight(index_type index);
+  void replaceChild(index_type parent, index_type from, index_type to);
+  index_type rotateLeft(index_type index);
+  index_type rotateRight(index_type index);
+  index_type rebalance(index_type index);
+  void rebalanceFrom(index_type index);
+
+  Slot* slots_ = nullptr;
+  size_type capacity_ = 0U;  // slots allocated, slot 0 included
+  size_type used_ = 1U;      // slots below this index have been handed out
+  index_type free_ = 0U;
+  index_type root_ = 0U;
+  size_type size_ = 0U;
+  Comparator comp_;
+  slot_allocator alloc_;
+};
+
+}  // namespace s21
+
+#include "CompactTree.tpp"
+
+#endif
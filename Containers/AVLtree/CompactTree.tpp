@@ -0,0 +1,520 @@
+#include "CompactTree.h"
+
+namespace s21 {
+
+template <typename T, typename Comparator, typename Allocator>
+CompactTree<T, Comparator, Allocator>::CompactTree(const CompactTree& other)
+    : comp_(other.comp_),
+      alloc_(slot_traits::select_on_container_copy_construction(
+          other.alloc_)) {
+  if (other.used_ == 1U) return;
+  slots_ = slot_traits::allocate(alloc_, other.used_);
+  capacity_ = other.used_;
+  try {
+    // Same indices as in other, so the shape is copied without a single
+    // comparison
+    for (; used_ != other.used_; ++used_) {
+      const Slot& source = other.slots_[used_];
+      Slot& slot = slots_[used_];
+      slot.left = source.left;
+      slot.right = source.right;
+      slot.parent = source.parent;
+      slot.height = 0;
+      if (source.height) {
+        ::new (static_cast<void*>(slot.storage)) T(other.value(used_));
+      }
+      slot.height = source.height;
+    }
+  } catch (...) {
+    destroyAll();
+    throw;
+  }
+  free_ = other.free_;
+  root_ = other.root_;
+  size_ = other.size_;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+CompactTree<T, Comparator, Allocator>::CompactTree(
+    CompactTree&& other) noexcept
+    : comp_(other.comp_), alloc_(std::move(other.alloc_)) {
+  swap(other);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+CompactTree<T, Comparator, Allocator>::~CompactTree() {
+  destroyAll();
+}
+
+template <typename T, typename Comparator, typename Allocator>
+CompactTree<T, Comparator, Allocator>&
+CompactTree<T, Comparator, Allocator>::operator=(const CompactTree& other) {
+  if (this != &other) {
+    CompactTree copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+CompactTree<T, Comparator, Allocator>&
+CompactTree<T, Comparator, Allocator>::operator=(
+    CompactTree&& other) noexcept {
+  if (this != &other) {
+    CompactTree moved(std::move(other));
+    swap(moved);
+  }
+  return *this;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+void CompactTree<T, Comparator, Allocator>::swap(CompactTree& other) noexcept {
+  std::swap(slots_, other.slots_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(used_, other.used_);
+  std::swap(free_, other.free_);
+  std::swap(root_, other.root_);
+  std::swap(size_, other.size_);
+  std::swap(comp_, other.comp_);
+  std::swap(alloc_, other.alloc_);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+typename CompactTree<T, Comparator, Allocator>::size_type
+CompactTree<T, Comparator, Allocator>::max_size() const {
+  size_type slots = slot_traits::max_size(alloc_) - 1U;
+  size_type indices = std::numeric_limits<index_type>::max();
+  return slots < indices ? slots : indices;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+void CompactTree<T, Comparator, Allocator>::clear() {
+  for (size_type i = 1U; i < used_; ++i) {
+    if (slots_[i].height) value(i).~T();
+  }
+  used_ = 1U;
+  free_ = root_ = 0U;
+  size_ = 0U;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+void CompactTree<T, Comparator, Allocator>::destroyAll() {
+  clear();
+  if (slots_) slot_traits::deallocate(alloc_, slots_, capacity_);
+  slots_ = nullptr;
+  capacity_ = 0U;
+}
+
+/*
+reserve
+Makes room for count nodes in total, so that inserting up to count elements
+never moves the array again
+*/
+
+template <typename T, typename Comparator, typename Allocator>
+void CompactTree<T, Comparator, Allocator>::reserve(size_type count) {
+  if (count > max_size()) {
+    throw std::length_error("CompactTree: reserve exceeds max_size");
+  }
+  if (count < capacity_) return;
+  Slot* slots = slot_traits::allocate(alloc_, count + 1U);
+  try {
+    relocate(slots, count + 1U);
+  } catch (...) {
+    slot_traits::deallocate(alloc_, slots, count + 1U);
+    throw;
+  }
+}
+
+/*
+relocate
+Moves every handed out slot into slots and makes it the array. Values are
+moved when that cannot throw and copied otherwise, so a failure leaves the
+tree untouched.
+*/
+
+template <typename T, typename Comparator, typename Allocator>
+void CompactTree<T, Comparator, Allocator>::relocate(Slot* slots,
+                                                      size_type count) {
+  size_type i = 1U;
+  try {
+    for (; i < used_; ++i) {
+      slots[i] = slots_[i];
+      if (slots_[i].height) {
+        ::new (static_cast<void*>(slots[i].storage))
+            T(std::move_if_noexcept(value(i)));
+      }
+    }
+  } catch (...) {
+    for (size_type j = 1U; j < i; ++j) {
+      if (slots[j].height) {
+        std::launder(reinterpret_cast<T*>(slots[j].storage))->~T();
+      }
+    }
+    throw;
+  }
+  for (i = 1U; i < used_; ++i) {
+    if (slots_[i].height) value(i).~T();
+  }
+  if (slots_) slot_traits::deallocate(alloc_, slots_, capacity_);
+  slots_ = slots;
+  capacity_ = count;
+}
+
+/*
+createSlot
+Builds a detached leaf holding T(args...) and returns its index. Freed slots
+are reused first. When the array is full the value is built in the new
+array before the old one is released, so args may refer to elements of
+this tree.
+*/
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename... Args>
+typename CompactTree<T, Comparator, Allocator>::index_type
+CompactTree<T, Comparator, Allocator>::createSlot(Args&&... args) {
+  index_type index = free_;
+  if (!index && used_ < capacity_) index = static_cast<index_type>(used_);
+  if (index) {
+    ::new (static_cast<void*>(slots_[index].storage))
+        T(std::forward<Args>(args)...);
+    if (index == free_) {
+      free_ = slots_[index].left;
+    } else {
+      ++used_;
+    }
+  } else {
+    if (used_ > max_size()) {
+      throw std::length_error("CompactTree: too many nodes");
+    }
+    size_type count = capacity_ ? capacity_ * 2U : 16U;
+    if (count > max_size() + 1U) count = max_size() + 1U;
+    Slot* slots = slot_traits::allocate(alloc_, count);
+    index = static_cast<index_type>(used_);
+    T* created = nullptr;
+    try {
+      created = ::new (static_cast<void*>(slots[index].storage))
+          T(std::forward<Args>(args)...);
+      relocate(slots, count);
+    } catch (...) {
+      if (created) created->~T();
+      slot_traits::deallocate(alloc_, slots, count);
+      throw;
+    }
+    ++used_;
+  }
+  Slot& slot = slots_[index];
+  slot.left = slot.right = slot.parent = 0U;
+  slot.height = 1;
+  return index;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+void CompactTree<T, Comparator, Allocator>::freeSlot(index_type index) {
+  value(index).~T();
+  slots_[index].height = 0;
+  slots_[index].left = free_;
+  free_ = index;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename... Args>
+std::pair<typename CompactTree<T, Comparator, Allocator>::iterator, bool>
+CompactTree<T, Comparator, Allocator>::emplace(bool unique, Args&&... args) {
+  value_type built(std::forward<Args>(args)...);
+  return insertValue(unique, std::move(built));
+}
+
+template <typename T, typename Comparator, typename Allocator>
+std::pair<typename CompactTree<T, Comparator, Allocator>::iterator, bool>
+CompactTree<T, Comparator, Allocator>::insert(const value_type& value,
+                                              bool unique) {
+  return insertValue(unique, value);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+std::pair<typename CompactTree<T, Comparator, Allocator>::iterator, bool>
+CompactTree<T, Comparator, Allocator>::insert(value_type&& value,
+                                              bool unique) {
+  return insertValue(unique, std::move(value));
+}
+
+/*
+insertValue
+Finds the place of value before a slot is taken, so a duplicate rejected
+by a unique insert never grows or relocates the array. The place is kept
+as an index, which stays valid when createSlot relocates.
+*/
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename V>
+std::pair<typename CompactTree<T, Comparator, Allocator>::iterator, bool>
+CompactTree<T, Comparator, Allocator>::insertValue(bool unique, V&& item) {
+  index_type parent = 0U;
+  bool left = false;
+  for (index_type current = root_; current;) {
+    parent = current;
+    left = comp_(item, value(current));
+    if (unique && !left && !comp_(value(current), item)) {
+      return {iterator(this, current), false};
+    }
+    current = left ? slots_[current].left : slots_[current].right;
+  }
+  index_type node = createSlot(std::forward<V>(item));
+  slots_[node].parent = parent;
+  if (!parent) {
+    root_ = node;
+  } else if (left) {
+    slots_[parent].left = node;
+  } else {
+    slots_[parent].right = node;
+  }
+  ++size_;
+  rebalanceFrom(parent);
+  return {iterator(this, node), true};
+}
+
+/*
+erase
+Unlinks the node at pos and returns the position after it. A node with two
+children is replaced by its successor slot rather than by a copy of its
+value, so iterators to other elements stay valid.
+*/
+
+template <typename T, typename Comparator, typename Allocator>
+typename CompactTree<T, Comparator, Allocator>::iterator
+CompactTree<T, Comparator, Allocator>::erase(const_iterator pos) {
+  index_type node = pos.getIndex();
+  index_type result = next(node);
+  Slot& slot = slots_[node];
+  index_type start = slot.parent;
+  if (!slot.left) {
+    transplant(node, slot.right);
+  } else if (!slot.right) {
+    transplant(node, slot.left);
+  } else {
+    index_type successor = result;
+    if (slots_[successor].parent != node) {
+      start = slots_[successor].parent;
+      transplant(successor, slots_[successor].right);
+      slots_[successor].right = slot.right;
+      slots_[slot.right].parent = successor;
+    } else {
+      start = successor;
+    }
+    transplant(node, successor);
+    slots_[successor].left = slot.left;
+    slots_[slot.left].parent = successor;
+    slots_[successor].height = slot.height;
+  }
+  freeSlot(node);
+  --size_;
+  rebalanceFrom(start);
+  return iterator(this, result);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+void CompactTree<T, Comparator, Allocator>::transplant(index_type from,
+                                                        index_type to) {
+  index_type parent = slots_[from].parent;
+  replaceChild(parent, from, to);
+  if (to) slots_[to].parent = parent;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+void CompactTree<T, Comparator, Allocator>::replaceChild(index_type parent,
+                                                          index_type from,
+                                                          index_type to) {
+  if (!parent) {
+    root_ = to;
+  } else if (slots_[parent].left == from) {
+    slots_[parent].left = to;
+  } else {
+    slots_[parent].right = to;
+  }
+}
+
+template <typename T, typename Comparator, typename Allocator>
+void CompactTree<T, Comparator, Allocator>::fixHeight(index_type index) {
+  int left = heightOf(slots_[index].left);
+  int right = heightOf(slots_[index].right);
+  slots_[index].height =
+      static_cast<std::int8_t>((left > right ? left : right) + 1);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+typename CompactTree<T, Comparator, Allocator>::index_type
+CompactTree<T, Comparator, Allocator>::rotateLeft(index_type index) {
+  index_type pivot = slots_[index].right;
+  index_type inner = slots_[pivot].left;
+  index_type parent = slots_[index].parent;
+  slots_[index].right = inner;
+  if (inner) slots_[inner].parent = index;
+  slots_[pivot].left = index;
+  slots_[index].parent = pivot;
+  slots_[pivot].parent = parent;
+  replaceChild(parent, index, pivot);
+  fixHeight(index);
+  fixHeight(pivot);
+  return pivot;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+typename CompactTree<T, Comparator, Allocator>::index_type
+CompactTree<T, Comparator, Allocator>::rotateRight(index_type index) {
+  index_type pivot = slots_[index].left;
+  index_type inner = slots_[pivot].right;
+  index_type parent = slots_[index].parent;
+  slots_[index].left = inner;
+  if (inner) slots_[inner].parent = index;
+  slots_[pivot].right = index;
+  slots_[index].parent = pivot;
+  slots_[pivot].parent = parent;
+  replaceChild(parent, index, pivot);
+  fixHeight(index);
+  fixHeight(pivot);
+  return pivot;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+typename CompactTree<T, Comparator, Allocator>::index_type
+CompactTree<T, Comparator, Allocator>::rebalance(index_type index) {
+  fixHeight(index);
+  const Slot& slot = slots_[index];
+  int balance = heightOf(slot.left) - heightOf(slot.right);
+  if (balance > 1) {
+    const Slot& left = slots_[slot.left];
+    if (heightOf(left.left) < heightOf(left.right)) rotateLeft(slot.left);
+    return rotateRight(index);
+  }
+  if (balance < -1) {
+    const Slot& right = slots_[slot.right];
+    if (heightOf(right.right) < heightOf(right.left)) rotateRight(slot.right);
+    return rotateLeft(index);
+  }
+  return index;
+}
+
+/*
+rebalanceFrom
+Restores the AVL invariant on the path from index to the root. The walk
+stops at the first subtree whose height did not change, since nothing
+above it can be affected.
+*/
+
+template <typename T, typename Comparator, typename Allocator>
+void CompactTree<T, Comparator, Allocator>::rebalanceFrom(index_type index) {
+  while (index) {
+    int height = slots_[index].height;
+    index_type parent = slots_[index].parent;
+    if (slots_[rebalance(index)].height == height) break;
+    index = parent;
+  }
+}
+
+template <typename T, typename Comparator, typename Allocator>
+typename CompactTree<T, Comparator, Allocator>::index_type
+CompactTree<T, Comparator, Allocator>::first() const {
+  index_type index = root_;
+  while (index && slots_[index].left) index = slots_[index].left;
+  return index;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+typename CompactTree<T, Comparator, Allocator>::index_type
+CompactTree<T, Comparator, Allocator>::last() const {
+  index_type index = root_;
+  while (index && slots_[index].right) index = slots_[index].right;
+  return index;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+typename CompactTree<T, Comparator, Allocator>::index_type
+CompactTree<T, Comparator, Allocator>::next(index_type index) const {
+  if (!index) return first();
+  if (slots_[index].right) {
+    index = slots_[index].right;
+    while (slots_[index].left) index = slots_[index].left;
+    return index;
+  }
+  index_type parent = slots_[index].parent;
+  while (parent && slots_[parent].right == index) {
+    index = parent;
+    parent = slots_[parent].parent;
+  }
+  return parent;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+typename CompactTree<T, Comparator, Allocator>::index_type
+CompactTree<T, Comparator, Allocator>::prev(index_type index) const {
+  if (!index) return last();
+  if (slots_[index].left) {
+    index = slots_[index].left;
+    while (slots_[index].right) index = slots_[index].right;
+    return index;
+  }
+  index_type parent = slots_[index].parent;
+  while (parent && slots_[parent].left == index) {
+    index = parent;
+    parent = slots_[parent].parent;
+  }
+  return parent;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+typename CompactTree<T, Comparator, Allocator>::index_type
+CompactTree<T, Comparator, Allocator>::lowerBoundIndex(const K& key) const {
+  index_type result = 0U;
+  for (index_type index = root_; index;) {
+    if (comp_(value(index), key)) {
+      index = slots_[index].right;
+    } else {
+      result = index;
+      index = slots_[index].left;
+    }
+  }
+  return result;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+typename CompactTree<T, Comparator, Allocator>::iterator
+CompactTree<T, Comparator, Allocator>::lower_bound(const K& key) {
+  return iterator(this, lowerBoundIndex(key));
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+typename CompactTree<T, Comparator, Allocator>::iterator
+CompactTree<T, Comparator, Allocator>::upper_bound(const K& key) {
+  index_type result = 0U;
+  for (index_type index = root_; index;) {
+    if (comp_(key, value(index))) {
+      result = index;
+      index = slots_[index].left;
+    } else {
+      index = slots_[index].right;
+    }
+  }
+  return iterator(this, result);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+typename CompactTree<T, Comparator, Allocator>::iterator
+CompactTree<T, Comparator, Allocator>::find(const K& key) {
+  index_type index = lowerBoundIndex(key);
+  if (index && comp_(key, value(index))) index = 0U;
+  return iterator(this, index);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+bool CompactTree<T, Comparator, Allocator>::contains(const K& key) const {
+  index_type index = lowerBoundIndex(key);
+  return index && !comp_(key, value(index));
+}
+
+}  // namespace s21
@@ -0,0 +1,204 @@
+#ifndef S21_EPOCH
+#define S21_EPOCH
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <utility>
+
+namespace s21 {
+
+// Intrusive header of everything an EpochDomain may retire
+struct EpochNode {
+  EpochNode* retiredNext = nullptr;
+  std::uint64_t retiredEpoch = 0U;
+};
+
+// One pin: the epoch a thread works in
+struct alignas(64) EpochSlot {
+  std::atomic<std::uint64_t> epoch{0U};  // 0 while the slot is free
+};
+
+/*
+EpochDomain
+Epoch-based reclamation for lock-free structures. A thread pins the
+current epoch for as long as it may hold pointers into the structure, and
+an unlinked node is retired with the epoch it was unlinked in instead of
+being freed. The epoch only advances once every pinned thread has seen the
+current one, so a node retired in epoch e is unreachable for everyone once
+the epoch reaches e + 2, and is handed to the reclaim callback then.
+Pins live in blocks of slots, and a Guard owns one slot. A new block is
+appended once every slot is taken, so any number of guards may be live;
+blocks are only freed with the domain.
+*/
+
+class EpochDomain {
+ public:
+  using Reclaim = void (*)(EpochNode* node, void* context);
+
+  class Guard {
+   public:
+    Guard() = default;
+    // The copy pins the epoch other holds, not the current one, so it
+    // protects everything other protects
+    Guard(const Guard& other)
+        : Guard(other.domain_
+                    ? other.domain_->pin(other.slot_->epoch.load())
+                    : Guard()) {}
+    Guard(Guard&& other) noexcept
+        : domain_(other.domain_), slot_(other.slot_) {
+      other.domain_ = nullptr;
+    }
+    Guard& operator=(Guard other) noexcept {
+      std::swap(domain_, other.domain_);
+      std::swap(slot_, other.slot_);
+      return *this;
+    }
+    ~Guard() {
+      if (domain_) slot_->epoch.store(0U);
+    }
+
+   private:
+    friend class EpochDomain;
+    Guard(EpochDomain* domain, EpochSlot* slot)
+        : domain_(domain), slot_(slot) {}
+
+    EpochDomain* domain_ = nullptr;
+    EpochSlot* slot_ = nullptr;
+  };
+
+  EpochDomain(Reclaim reclaim, void* context)
+      : reclaim_(reclaim), context_(context) {}
+  EpochDomain(const EpochDomain&) = delete;
+  EpochDomain& operator=(const EpochDomain&) = delete;
+  // No thread may be pinned any more: everything retired is reclaimed
+  ~EpochDomain();
+
+  Guard pin() { return pin(0U); }
+  // node must already be unreachable for threads that pin after this call
+  void retire(EpochNode* node);
+
+ private:
+  static constexpr std::size_t kSlots = 64U;  // per block
+  // Retirements between two attempts to advance the epoch
+  static constexpr std::size_t kAdvanceEvery = 64U;
+
+  using Slot = EpochSlot;
+  struct SlotBlock {
+    Slot slots[kSlots];
+    std::atomic<SlotBlock*> next{nullptr};
+  };
+
+  // epoch 0 pins the current one
+  Guard pin(std::uint64_t epoch);
+  void tryAdvance();
+  void reclaim(std::uint64_t epoch, EpochNode* list);
+
+  SlotBlock slots_;
+  std::atomic<std::uint64_t> epoch_{1U};
+  std::atomic<EpochNode*> retired_{nullptr};
+  std::atomic<std::size_t> retiredCount_{0U};
+  Reclaim reclaim_;
+  void* context_;
+};
+
+// Implementation of methods
+
+inline EpochDomain::~EpochDomain() {
+  reclaim(std::numeric_limits<std::uint64_t>::max(),
+          retired_.exchange(nullptr));
+  SlotBlock* block = slots_.next.load();
+  while (block) {
+    SlotBlock* next = block->next.load();
+    delete block;
+    block = next;
+  }
+}
+
+/*
+pin
+Claims a free slot, starting in every block from one picked by the thread
+id so that threads rarely compete for the same slot, and appends a block
+when all are taken. Copying a guard pins the epoch it holds: that epoch
+cannot be left behind while the source guard still holds it. The fence
+keeps the loads of the protected structure from being ordered before the
+pin becomes visible. Every live Guard, iterators included, holds a slot.
+*/
+
+inline EpochDomain::Guard EpochDomain::pin(std::uint64_t epoch) {
+  std::size_t start =
+      std::hash<std::thread::id>()(std::this_thread::get_id());
+  SlotBlock* block = &slots_;
+  for (;;) {
+    for (std::size_t i = 0U; i < kSlots; ++i) {
+      Slot& slot = block->slots[(start + i) % kSlots];
+      std::uint64_t expected = 0U;
+      if (slot.epoch.load(std::memory_order_relaxed) == 0U &&
+          slot.epoch.compare_exchange_strong(
+              expected, epoch ? epoch : epoch_.load())) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return Guard(this, &slot);
+      }
+    }
+    SlotBlock* next = block->next.load();
+    if (!next) {
+      SlotBlock* fresh = new SlotBlock();
+      if (block->next.compare_exchange_strong(next, fresh)) {
+        next = fresh;
+      } else {
+        delete fresh;  // another thread appended one first
+      }
+    }
+    block = next;
+  }
+}
+
+inline void EpochDomain::retire(EpochNode* node) {
+  node->retiredEpoch = epoch_.load();
+  node->retiredNext = retired_.load(std::memory_order_relaxed);
+  while (!retired_.compare_exchange_weak(node->retiredNext, node)) {
+  }
+  if (retiredCount_.fetch_add(1U) % kAdvanceEvery == kAdvanceEvery - 1U) {
+    tryAdvance();
+  }
+}
+
+inline void EpochDomain::tryAdvance() {
+  std::uint64_t epoch = epoch_.load();
+  for (const SlotBlock* block = &slots_; block; block = block->next.load()) {
+    for (const Slot& slot : block->slots) {
+      std::uint64_t pinned = slot.epoch.load();
+      if (pinned && pinned != epoch) return;
+    }
+  }
+  if (epoch_.compare_exchange_strong(epoch, epoch + 1U)) {
+    reclaim(epoch + 1U, retired_.exchange(nullptr));
+  }
+}
+
+// Reclaims the nodes of list that are old enough and gives back the rest
+inline void EpochDomain::reclaim(std::uint64_t epoch, EpochNode* list) {
+  EpochNode* keep = nullptr;
+  EpochNode* keepTail = nullptr;
+  while (list) {
+    EpochNode* next = list->retiredNext;
+    if (list->retiredEpoch + 2U <= epoch) {
+      reclaim_(list, context_);
+    } else {
+      list->retiredNext = keep;
+      keep = list;
+      if (!keepTail) keepTail = list;
+    }
+    list = next;
+  }
+  if (!keep) return;
+  keepTail->retiredNext = retired_.load(std::memory_order_relaxed);
+  while (!retired_.compare_exchange_weak(keepTail->retiredNext, keep)) {
+  }
+}
+
+}  // namespace s21
+
+#endif
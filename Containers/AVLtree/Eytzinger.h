@@ -0,0 +1,95 @@
+#ifndef S21_EYTZINGER
+#define S21_EYTZINGER
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace s21 {
+
+/*
+Eytzinger
+Implicit complete binary tree stored in BFS order: the root is at position
+1 and the children of k are 2k and 2k + 1, so a search needs no pointers
+and the first levels share a few cache lines. Position 0 means "none".
+*/
+
+struct Eytzinger {
+  using size_type = std::size_t;
+
+  // Leftmost and rightmost positions of a tree with n nodes
+  static size_type first(size_type n) {
+    if (!n) return 0U;
+    size_type k = 1U;
+    while (2U * k <= n) k *= 2U;
+    return k;
+  }
+  static size_type last(size_type n) {
+    if (!n) return 0U;
+    size_type k = 1U;
+    while (2U * k + 1U <= n) k = 2U * k + 1U;
+    return k;
+  }
+
+  // In-order successor and predecessor, 0 past either end
+  static size_type next(size_type k, size_type n) {
+    if (2U * k + 1U <= n) {
+      k = 2U * k + 1U;
+      while (2U * k <= n) k *= 2U;
+      return k;
+    }
+    while (k & 1U) k >>= 1U;
+    return k >> 1U;
+  }
+  static size_type prev(size_type k, size_type n) {
+    if (!k) return last(n);
+    if (2U * k <= n) {
+      k = 2U * k;
+      while (2U * k + 1U <= n) k = 2U * k + 1U;
+      return k;
+    }
+    while (k && !(k & 1U)) k >>= 1U;
+    return k >> 1U;
+  }
+
+  // ranks[k] is the sorted index of the value stored at position k
+  static std::vector<size_type> ranks(size_type n) {
+    std::vector<size_type> result(n + 1U);
+    size_type rank = 0U;
+    for (size_type k = first(n); k; k = next(k, n)) result[k] = rank++;
+    return result;
+  }
+
+  /*
+  search
+  Position of the first key that is not before key (Upper == false) or
+  after key (Upper == true), 0 when there is none. The descent has no
+  branch to mispredict: every level is one compare folded into the next
+  index. The descendants kLine levels down share a cache line and are
+  prefetched while the current level is compared. When the walk falls off
+  the tree, the answer is the last node where it went left; k records the
+  path in binary, so that node is k with the trailing right turns (ones)
+  and the final left turn shifted out.
+  */
+  template <bool Upper, typename Key, typename K, typename Less>
+  static size_type search(const Key* keys, size_type n, const K& key,
+                          const Less& less) {
+    constexpr size_type kLine = 64U / sizeof(Key) ? 64U / sizeof(Key) : 1U;
+    size_type k = 1U;
+    while (k <= n) {
+#if defined(__GNUC__) || defined(__clang__)
+      __builtin_prefetch(keys + std::min(k * kLine, n));
+#endif
+      k = 2U * k + (Upper ? !less(key, keys[k]) : less(keys[k], key));
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    return k >> (__builtin_ctzll(~static_cast<unsigned long long>(k)) + 1);
+#else
+    while (k & 1U) k >>= 1U;
+    return k >> 1U;
+#endif
+  }
+};
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,288 @@
+#ifndef S21_HASH_TABLE
+#define S21_HASH_TABLE
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace s21 {
+
+/*
+HashTable
+Open addressing hash table in the Swiss table layout: the values sit in one
+flat array and a parallel array keeps one control byte per slot. A control
+byte is either empty, deleted or the low 7 bits of the hash of the value in
+the slot. Lookups probe 16 control bytes at a time and compare values only
+where those 7 bits match, so a miss rarely touches the values at all. Any
+rehash invalidates iterators.
+*/
+
+// Key of a stored value: the value itself for sets, .first for maps
+struct HashIdentity {
+  template <typename T>
+  const T& operator()(const T& value) const {
+    return value;
+  }
+};
+
+struct HashSelectFirst {
+  template <typename T>
+  const typename T::first_type& operator()(const T& value) const {
+    return value.first;
+  }
+};
+
+/*
+HashGroup
+16 control bytes compared at once, with SSE2 when the target has it and
+one byte at a time otherwise. Bit i of a mask stands for byte i.
+*/
+
+struct HashGroup {
+  using ctrl_type = std::int8_t;
+
+  static constexpr std::size_t kWidth = 16U;
+  static constexpr ctrl_type kEmpty = -128;
+  static constexpr ctrl_type kDeleted = -2;
+
+  explicit HashGroup(const ctrl_type* ctrl) : ctrl_(ctrl) {}
+
+  std::uint32_t match(ctrl_type hash) const {
+#if defined(__SSE2__)
+    return maskOf(_mm_cmpeq_epi8(_mm_set1_epi8(hash), load()));
+#else
+    return maskIf([hash](ctrl_type c) { return c == hash; });
+#endif
+  }
+  std::uint32_t matchEmpty() const {
+#if defined(__SSE2__)
+    return maskOf(_mm_cmpeq_epi8(_mm_set1_epi8(kEmpty), load()));
+#else
+    return maskIf([](ctrl_type c) { return c == kEmpty; });
+#endif
+  }
+  // Both special values are negative and full slots never are
+  std::uint32_t matchFree() const {
+#if defined(__SSE2__)
+    return maskOf(_mm_cmpgt_epi8(_mm_setzero_si128(), load()));
+#else
+    return maskIf([](ctrl_type c) { return c < 0; });
+#endif
+  }
+  std::uint32_t matchFull() const { return ~matchFree() & 0xFFFFU; }
+
+  static unsigned lowestBit(std::uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned bit = 0U;
+    while (!(mask & 1U)) {
+      mask >>= 1U;
+      ++bit;
+    }
+    return bit;
+#endif
+  }
+
+ private:
+#if defined(__SSE2__)
+  __m128i load() const {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl_));
+  }
+  static std::uint32_t maskOf(__m128i bytes) {
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(bytes));
+  }
+#else
+  template <typename Pred>
+  std::uint32_t maskIf(Pred pred) const {
+    std::uint32_t mask = 0U;
+    for (std::size_t i = 0U; i < kWidth; ++i) {
+      mask |= static_cast<std::uint32_t>(pred(ctrl_[i])) << i;
+    }
+    return mask;
+  }
+#endif
+
+  const ctrl_type* ctrl_;
+};
+
+template <typename Table, bool Const>
+class HashIterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = typename Table::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference =
+      std::conditional_t<Const, const value_type&, value_type&>;
+  using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+  using size_type = typename Table::size_type;
+
+  HashIterator() = default;
+  // iterator converts to const_iterator
+  template <bool C = Const, typename = std::enable_if_t<C>>
+  HashIterator(const HashIterator<Table, false>& other)
+      : table_(other.table_), index_(other.index_) {}
+
+  reference operator*() const { return table_->slots_[index_]; }
+  pointer operator->() const { return table_->slots_ + index_; }
+  HashIterator& operator++() {
+    index_ = table_->nextFull(index_ + 1U);
+    return *this;
+  }
+  HashIterator operator++(int) {
+    HashIterator result = *this;
+    ++*this;
+    return result;
+  }
+  bool operator==(const HashIterator& other) const {
+    return index_ == other.index_;
+  }
+  bool operator!=(const HashIterator& other) const {
+    return index_ != other.index_;
+  }
+
+ private:
+  friend Table;
+  friend class HashIterator<Table, true>;
+
+  HashIterator(const Table* table, size_type index)
+      : table_(table), index_(index) {}
+
+  const Table* table_ = nullptr;
+  size_type index_ = 0U;  // capacity() is end()
+};
+
+template <typename Key, typename Value, typename KeyOf,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<Value>>
+class HashTable {
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+  using iterator = HashIterator<HashTable, false>;
+  using const_iterator = HashIterator<HashTable, true>;
+
+  HashTable() = default;
+  explicit HashTable(size_type bucketCount, const Hash& hash = Hash(),
+                     const KeyEqual& equal = KeyEqual(),
+                     const Allocator& alloc = Allocator());
+  HashTable(const HashTable& other);
+  HashTable(HashTable&& other) noexcept;
+  ~HashTable();
+
+  HashTable& operator=(const HashTable& other);
+  HashTable& operator=(HashTable&& other) noexcept;
+
+  iterator begin() { return iterator(this, nextFull(0U)); }
+  iterator end() { return iterator(this, capacity_); }
+  const_iterator begin() const { return const_iterator(this, nextFull(0U)); }
+  const_iterator end() const { return const_iterator(this, capacity_); }
+
+  bool empty() const { return size_ == 0U; }
+  size_type size() const { return size_; }
+  size_type max_size() const;
+  size_type capacity() const { return capacity_; }
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return equal_; }
+
+  // Hash policy
+  float load_factor() const;
+  float max_load_factor() const { return maxLoad_; }
+  void max_load_factor(float ml);
+  void rehash(size_type count);
+  void reserve(size_type count);
+
+  void clear();
+  void swap(HashTable& other) noexcept;
+
+  // Inserts a value built from args unless key is already there
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> tryEmplace(const K& key, Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  iterator erase(const_iterator pos);
+  template <typename K>
+  size_type eraseKey(const K& key);
+
+  template <typename K>
+  iterator find(const K& key) {
+    return iterator(this, findIndex(key));
+  }
+  template <typename K>
+  const_iterator find(const K& key) const {
+    return const_iterator(this, findIndex(key));
+  }
+  template <typename K>
+  bool contains(const K& key) const {
+    return findIndex(key) != capacity_;
+  }
+
+  static constexpr float kDefaultMaxLoad = 0.875F;
+
+ private:
+  template <typename, bool>
+  friend class HashIterator;
+
+  using ctrl_type = HashGroup::ctrl_type;
+  using value_traits = std::allocator_traits<Allocator>;
+  using ctrl_allocator = typename value_traits::template rebind_alloc<
+      ctrl_type>;
+  using ctrl_traits = std::allocator_traits<ctrl_allocator>;
+
+  static constexpr size_type kWidth = HashGroup::kWidth;
+
+  static const Key& keyOf(const Value& value) { return KeyOf()(value); }
+  template <typename K>
+  size_type hashOf(const K& key) const;
+  static ctrl_type shortHash(size_type hash) {
+    return static_cast<ctrl_type>(hash & 0x7FU);
+  }
+
+  template <typename K>
+  size_type findIndex(const K& key) const;
+  template <typename K>
+  size_type findIndex(const K& key, size_type hash) const;
+  size_type findFree(size_type hash) const;
+  size_type nextFull(size_type index) const;
+  void setCtrl(size_type index, ctrl_type ctrl);
+
+  size_type growthLimit(size_type capacity) const;
+  size_type capacityFor(size_type count) const;
+  static size_type roundCapacity(size_type count);
+  template <typename... Args>
+  size_type insertAt(size_type hash, Args&&... args);
+  void resize(size_type capacity);
+  void allocate(size_type capacity);
+  void deallocate();
+  void destroyAll();
+
+  ctrl_type* ctrl_ = nullptr;  // capacity_ + kWidth bytes, see setCtrl
+  Value* slots_ = nullptr;
+  size_type capacity_ = 0U;  // 0 or a power of two not below kWidth
+  size_type size_ = 0U;
+  size_type growthLeft_ = 0U;  // empty slots that may still be filled
+  float maxLoad_ = kDefaultMaxLoad;
+  Hash hash_;
+  KeyEqual equal_;
+  Allocator alloc_;
+};
+
+}  // namespace s21
+
+#include "HashTable.tpp"
+
+#endif
@@ -0,0 +1,461 @@
+#include <algorithm>
+
+#include "HashTable.h"
+
+namespace s21 {
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::HashTable(
+    size_type bucketCount, const Hash& hash, const KeyEqual& equal,
+    const Allocator& alloc)
+    : hash_(hash), equal_(equal), alloc_(alloc) {
+  if (bucketCount) allocate(roundCapacity(bucketCount));
+}
+
+/*
+HashTable(const HashTable&)
+Copies every slot to the same index, deleted markers included, so no value
+is hashed again and every probe sequence stays intact
+*/
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::HashTable(
+    const HashTable& other)
+    : maxLoad_(other.maxLoad_),
+      hash_(other.hash_),
+      equal_(other.equal_),
+      alloc_(value_traits::select_on_container_copy_construction(
+          other.alloc_)) {
+  if (!other.capacity_) return;
+  allocate(other.capacity_);
+  try {
+    for (size_type i = 0U; i < capacity_; ++i) {
+      if (other.ctrl_[i] >= 0) {
+        value_traits::construct(alloc_, slots_ + i, other.slots_[i]);
+        ++size_;
+      }
+      setCtrl(i, other.ctrl_[i]);
+    }
+  } catch (...) {
+    destroyAll();
+    deallocate();
+    throw;
+  }
+  growthLeft_ = other.growthLeft_;
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::HashTable(
+    HashTable&& other) noexcept
+    : hash_(other.hash_), equal_(other.equal_), alloc_(other.alloc_) {
+  swap(other);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::~HashTable() {
+  destroyAll();
+  deallocate();
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>&
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::operator=(
+    const HashTable& other) {
+  if (this != &other) {
+    HashTable copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>&
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::operator=(
+    HashTable&& other) noexcept {
+  if (this != &other) {
+    HashTable moved(std::move(other));
+    swap(moved);
+  }
+  return *this;
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::swap(
+    HashTable& other) noexcept {
+  std::swap(ctrl_, other.ctrl_);
+  std::swap(slots_, other.slots_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(size_, other.size_);
+  std::swap(growthLeft_, other.growthLeft_);
+  std::swap(maxLoad_, other.maxLoad_);
+  std::swap(hash_, other.hash_);
+  std::swap(equal_, other.equal_);
+  std::swap(alloc_, other.alloc_);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::max_size() const {
+  return value_traits::max_size(alloc_) / 2U;
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+float HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::load_factor()
+    const {
+  return capacity_ ? static_cast<float>(size_) / capacity_ : 0.0F;
+}
+
+/*
+max_load_factor
+Sets how full the table may get before it grows. The table always keeps at
+least one empty slot, so values of 1 and above act as "as full as possible".
+*/
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::max_load_factor(
+    float ml) {
+  if (!(ml > 0.0F)) {
+    throw std::invalid_argument("HashTable: max_load_factor must be positive");
+  }
+  size_type oldLimit = growthLimit(capacity_);
+  maxLoad_ = ml;
+  size_type newLimit = growthLimit(capacity_);
+  if (growthLeft_ + newLimit < oldLimit) {
+    resize(std::max(capacity_, capacityFor(size_)));
+  } else {
+    growthLeft_ = growthLeft_ + newLimit - oldLimit;
+  }
+}
+
+// Makes room for at least count buckets and drops the deleted markers
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::rehash(
+    size_type count) {
+  resize(std::max(capacityFor(size_), roundCapacity(count)));
+}
+
+// Makes room for count values in total without another rehash
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::reserve(
+    size_type count) {
+  if (count > size_ + growthLeft_) resize(capacityFor(count));
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::clear() {
+  destroyAll();
+  if (ctrl_) std::fill(ctrl_, ctrl_ + capacity_ + kWidth, HashGroup::kEmpty);
+  growthLeft_ = growthLimit(capacity_);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename K, typename... Args>
+std::pair<typename HashTable<Key, Value, KeyOf, Hash, KeyEqual,
+                             Allocator>::iterator,
+          bool>
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::tryEmplace(
+    const K& key, Args&&... args) {
+  size_type hash = hashOf(key);
+  size_type index = findIndex(key, hash);
+  if (index != capacity_) return {iterator(this, index), false};
+  index = insertAt(hash, std::forward<Args>(args)...);
+  return {iterator(this, index), true};
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename... Args>
+std::pair<typename HashTable<Key, Value, KeyOf, Hash, KeyEqual,
+                             Allocator>::iterator,
+          bool>
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::emplace(
+    Args&&... args) {
+  Value value(std::forward<Args>(args)...);
+  return tryEmplace(keyOf(value), std::move(value));
+}
+
+/*
+erase
+A slot may go back to empty, instead of being marked deleted, when no probe
+can have passed over it: every group that covers it then holds an empty
+slot, because the full slots around it form a run shorter than a group.
+*/
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::iterator
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::erase(
+    const_iterator pos) {
+  size_type index = pos.index_;
+  value_traits::destroy(alloc_, slots_ + index);
+  --size_;
+  size_type before = (index - kWidth) & (capacity_ - 1U);
+  std::uint32_t emptyAfter = HashGroup(ctrl_ + index).matchEmpty();
+  std::uint32_t emptyBefore = HashGroup(ctrl_ + before).matchEmpty();
+  size_type runAfter = emptyAfter ? HashGroup::lowestBit(emptyAfter) : kWidth;
+  size_type runBefore = kWidth;
+  if (emptyBefore) {
+    runBefore = 0U;
+    while (!(emptyBefore & (1U << (kWidth - 1U - runBefore)))) ++runBefore;
+  }
+  if (runAfter + runBefore < kWidth) {
+    setCtrl(index, HashGroup::kEmpty);
+    ++growthLeft_;
+  } else {
+    setCtrl(index, HashGroup::kDeleted);
+  }
+  return iterator(this, nextFull(index + 1U));
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename K>
+typename HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::eraseKey(
+    const K& key) {
+  size_type index = findIndex(key);
+  if (index == capacity_) return 0U;
+  erase(const_iterator(this, index));
+  return 1U;
+}
+
+/*
+hashOf
+Mixes the user hash (the 64-bit MurmurHash3 finalizer) so that identity
+hashes such as std::hash<int> still spread over both the probe start and
+the 7 bits kept in the control byte
+*/
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename K>
+typename HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::hashOf(
+    const K& key) const {
+  std::uint64_t hash = hash_(key);
+  hash ^= hash >> 33U;
+  hash *= 0xFF51AFD7ED558CCDULL;
+  hash ^= hash >> 33U;
+  hash *= 0xC4CEB9FE1A85EC53ULL;
+  hash ^= hash >> 33U;
+  return static_cast<size_type>(hash);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename K>
+typename HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::findIndex(
+    const K& key) const {
+  return findIndex(key, hashOf(key));
+}
+
+/*
+findIndex
+Probes whole groups, starting at the slot picked by the high bits of hash
+and moving by one more group each time. On a power of two table these
+triangular steps reach every group. An empty slot in a group ends the
+search since an insert would have stopped there.
+*/
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename K>
+typename HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::findIndex(
+    const K& key, size_type hash) const {
+  if (!capacity_) return capacity_;
+  const size_type mask = capacity_ - 1U;
+  const ctrl_type tag = shortHash(hash);
+  size_type pos = (hash >> 7U) & mask;
+  for (size_type step = kWidth;; step += kWidth) {
+    HashGroup group(ctrl_ + pos);
+    for (std::uint32_t m = group.match(tag); m; m &= m - 1U) {
+      size_type index = (pos + HashGroup::lowestBit(m)) & mask;
+      if (equal_(keyOf(slots_[index]), key)) return index;
+    }
+    if (group.matchEmpty()) return capacity_;
+    pos = (pos + step) & mask;
+  }
+}
+
+// First empty or deleted slot on the probe sequence of hash
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::findFree(
+    size_type hash) const {
+  const size_type mask = capacity_ - 1U;
+  size_type pos = (hash >> 7U) & mask;
+  for (size_type step = kWidth;; step += kWidth) {
+    std::uint32_t free = HashGroup(ctrl_ + pos).matchFree();
+    if (free) return (pos + HashGroup::lowestBit(free)) & mask;
+    pos = (pos + step) & mask;
+  }
+}
+
+// First full slot at or after index, capacity_ when there is none
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::nextFull(
+    size_type index) const {
+  for (; index < capacity_; index += kWidth) {
+    std::uint32_t full = HashGroup(ctrl_ + index).matchFull();
+    if (full) return std::min(index + HashGroup::lowestBit(full), capacity_);
+  }
+  return capacity_;
+}
+
+/*
+setCtrl
+The first kWidth control bytes are repeated after the last slot, so that a
+group starting near the end reads the wrapped around bytes in one load
+*/
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::setCtrl(
+    size_type index, ctrl_type ctrl) {
+  ctrl_[index] = ctrl;
+  if (index < kWidth) ctrl_[capacity_ + index] = ctrl;
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::growthLimit(
+    size_type capacity) const {
+  double limit = static_cast<double>(capacity) * maxLoad_;
+  if (limit < static_cast<double>(capacity)) {
+    return static_cast<size_type>(limit);
+  }
+  return capacity ? capacity - 1U : 0U;
+}
+
+// Power of two capacity with at least count slots, 0 for none
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::roundCapacity(
+    size_type count) {
+  if (!count) return 0U;
+  size_type capacity = kWidth;
+  while (capacity < count) capacity *= 2U;
+  return capacity;
+}
+
+// Smallest valid capacity that holds count values, kWidth for none
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::capacityFor(
+    size_type count) const {
+  if (count > max_size()) {
+    throw std::length_error("HashTable: reserve exceeds max_size");
+  }
+  size_type capacity = kWidth;
+  while (growthLimit(capacity) < count) capacity *= 2U;
+  return capacity;
+}
+
+/*
+insertAt
+Builds a value in the first free slot for hash. A full table grows first;
+it is rebuilt at the same size when deleted markers are what fills it.
+*/
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename... Args>
+typename HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::insertAt(
+    size_type hash, Args&&... args) {
+  size_type index = capacity_ ? findFree(hash) : 0U;
+  if (!capacity_ ||
+      (!growthLeft_ && ctrl_[index] != HashGroup::kDeleted)) {
+    resize(capacityFor(size_ + 1U));
+    index = findFree(hash);
+  }
+  value_traits::construct(alloc_, slots_ + index, std::forward<Args>(args)...);
+  if (ctrl_[index] == HashGroup::kEmpty) --growthLeft_;
+  setCtrl(index, shortHash(hash));
+  ++size_;
+  return index;
+}
+
+/*
+resize
+Moves the values into a new table of the given capacity. They are moved
+when that cannot throw and copied otherwise, so a failure leaves this table
+as it was.
+*/
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::resize(
+    size_type capacity) {
+  HashTable other(0U, hash_, equal_, alloc_);
+  other.maxLoad_ = maxLoad_;
+  if (capacity) other.allocate(capacity);
+  for (size_type i = nextFull(0U); i < capacity_; i = nextFull(i + 1U)) {
+    other.insertAt(hashOf(keyOf(slots_[i])), std::move_if_noexcept(slots_[i]));
+  }
+  swap(other);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::allocate(
+    size_type capacity) {
+  ctrl_allocator ctrlAlloc(alloc_);
+  ctrl_ = ctrl_traits::allocate(ctrlAlloc, capacity + kWidth);
+  try {
+    slots_ = value_traits::allocate(alloc_, capacity);
+  } catch (...) {
+    ctrl_traits::deallocate(ctrlAlloc, ctrl_, capacity + kWidth);
+    ctrl_ = nullptr;
+    throw;
+  }
+  std::fill(ctrl_, ctrl_ + capacity + kWidth, HashGroup::kEmpty);
+  capacity_ = capacity;
+  growthLeft_ = growthLimit(capacity);
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::deallocate() {
+  if (!ctrl_) return;
+  ctrl_allocator ctrlAlloc(alloc_);
+  ctrl_traits::deallocate(ctrlAlloc, ctrl_, capacity_ + kWidth);
+  value_traits::deallocate(alloc_, slots_, capacity_);
+  ctrl_ = nullptr;
+  slots_ = nullptr;
+  capacity_ = 0U;
+  growthLeft_ = 0U;
+}
+
+template <typename Key, typename Value, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOf, Hash, KeyEqual, Allocator>::destroyAll() {
+  for (size_type i = nextFull(0U); i < capacity_; i = nextFull(i + 1U)) {
+    value_traits::destroy(alloc_, slots_ + i);
+  }
+  size_ = 0U;
+}
+
+}  // namespace s21
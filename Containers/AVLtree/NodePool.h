@@ -0,0 +1,191 @@
+#ifndef S21_NODE_POOL
+#define S21_NODE_POOL
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+/*
+NodePool
+Slab allocator for tree nodes. Nodes are cut from contiguous chunks that grow
+geometrically, freed nodes go to an intrusive free list for reuse, and
+release() hands every chunk back to the allocator in O(chunks).
+*/
+
+template <typename Node, typename Allocator = std::allocator<Node>>
+class NodePool {
+ public:
+  using allocator_type =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using size_type = std::size_t;
+
+  explicit NodePool(const Allocator& alloc = Allocator()) : alloc_(alloc) {}
+  NodePool(const NodePool& other) = delete;
+  NodePool& operator=(const NodePool& other) = delete;
+  ~NodePool() { release(); }
+
+  template <typename... Args>
+  Node* create(Args&&... args);
+  void destroy(Node* node);
+  void deallocate(Node* node);
+  void erase(Node* node);
+
+  void reserve(size_type count);
+  void release();
+  void swap(NodePool& other);
+  void splice(NodePool& other);
+
+  allocator_type get_allocator() const { return alloc_; }
+
+ private:
+  using traits = std::allocator_traits<allocator_type>;
+
+  struct FreeSlot {
+    FreeSlot* next;
+  };
+  struct Chunk {
+    Node* nodes;
+    size_type capacity;
+  };
+
+  static constexpr size_type kFirstChunk = 32U;
+  static constexpr size_type kMaxChunk = 4096U;
+
+  Node* allocate();
+  void addChunk(size_type capacity);
+
+  allocator_type alloc_;
+  std::vector<Chunk> chunks_;
+  FreeSlot* freeList_ = nullptr;
+  Node* cursor_ = nullptr;
+  Node* chunkEnd_ = nullptr;
+  size_type nextChunk_ = kFirstChunk;
+};
+
+template <typename Node, typename Allocator>
+template <typename... Args>
+Node* NodePool<Node, Allocator>::create(Args&&... args) {
+  Node* node = allocate();
+  try {
+    traits::construct(alloc_, node, std::forward<Args>(args)...);
+  } catch (...) {
+    deallocate(node);
+    throw;
+  }
+  return node;
+}
+
+template <typename Node, typename Allocator>
+void NodePool<Node, Allocator>::destroy(Node* node) {
+  traits::destroy(alloc_, node);
+}
+
+template <typename Node, typename Allocator>
+void NodePool<Node, Allocator>::deallocate(Node* node) {
+  FreeSlot* slot = reinterpret_cast<FreeSlot*>(node);
+  slot->next = freeList_;
+  freeList_ = slot;
+}
+
+template <typename Node, typename Allocator>
+void NodePool<Node, Allocator>::erase(Node* node) {
+  destroy(node);
+  deallocate(node);
+}
+
+template <typename Node, typename Allocator>
+Node* NodePool<Node, Allocator>::allocate() {
+  if (freeList_) {
+    FreeSlot* slot = freeList_;
+    freeList_ = slot->next;
+    return reinterpret_cast<Node*>(slot);
+  }
+  if (cursor_ == chunkEnd_) {
+    addChunk(nextChunk_);
+    if (nextChunk_ < kMaxChunk) nextChunk_ *= 2U;
+  }
+  return cursor_++;
+}
+
+template <typename Node, typename Allocator>
+void NodePool<Node, Allocator>::addChunk(size_type capacity) {
+  chunks_.reserve(chunks_.size() + 1U);
+  Node* nodes = traits::allocate(alloc_, capacity);
+  chunks_.push_back({nodes, capacity});
+  // The unused tail of the previous chunk is not lost: push it to the free
+  // list so reserve() never wastes memory.
+  while (cursor_ != chunkEnd_) deallocate(cursor_++);
+  cursor_ = nodes;
+  chunkEnd_ = nodes + capacity;
+}
+
+/*
+reserve
+Makes room for count more nodes with at most one new chunk
+*/
+
+template <typename Node, typename Allocator>
+void NodePool<Node, Allocator>::reserve(size_type count) {
+  size_type available = static_cast<size_type>(chunkEnd_ - cursor_);
+  for (FreeSlot* slot = freeList_; slot && available < count;
+       slot = slot->next) {
+    ++available;
+  }
+  if (available < count) addChunk(count - available);
+}
+
+/*
+release
+Returns all chunks to the allocator. Values still living in the pool are not
+destroyed; the owner must do that first when it matters.
+*/
+
+template <typename Node, typename Allocator>
+void NodePool<Node, Allocator>::release() {
+  for (auto& chunk : chunks_) {
+    traits::deallocate(alloc_, chunk.nodes, chunk.capacity);
+  }
+  chunks_.clear();
+  freeList_ = nullptr;
+  cursor_ = chunkEnd_ = nullptr;
+  nextChunk_ = kFirstChunk;
+}
+
+/*
+splice
+Takes over every chunk of other, together with the nodes living in them, so
+nodes can move between trees without being copied. Both pools must use equal
+allocators; other is left empty.
+*/
+
+template <typename Node, typename Allocator>
+void NodePool<Node, Allocator>::splice(NodePool& other) {
+  if (this == &other) return;
+  chunks_.reserve(chunks_.size() + other.chunks_.size());
+  chunks_.insert(chunks_.end(), other.chunks_.begin(), other.chunks_.end());
+  while (other.cursor_ != other.chunkEnd_) deallocate(other.cursor_++);
+  while (other.freeList_) {
+    FreeSlot* slot = other.freeList_;
+    other.freeList_ = slot->next;
+    deallocate(reinterpret_cast<Node*>(slot));
+  }
+  other.chunks_.clear();
+  other.cursor_ = other.chunkEnd_ = nullptr;
+  other.nextChunk_ = kFirstChunk;
+}
+
+template <typename Node, typename Allocator>
+void NodePool<Node, Allocator>::swap(NodePool& other) {
+  std::swap(alloc_, other.alloc_);
+  chunks_.swap(other.chunks_);
+  std::swap(freeList_, other.freeList_);
+  std::swap(cursor_, other.cursor_);
+  std::swap(chunkEnd_, other.chunkEnd_);
+  std::swap(nextChunk_, other.nextChunk_);
+}
+
+}  // namespace s21
+
+#endif
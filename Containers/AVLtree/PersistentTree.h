@@ -0,0 +1,201 @@
+#ifndef S21_PERSISTENT_TREE
+#define S21_PERSISTENT_TREE
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace s21 {
+
+/*
+PersistentTree
+AVL tree whose nodes never change once built. An update copies the nodes
+on the path from the root to the change and links the copies to every
+untouched subtree of the old version, so it costs O(log n) new nodes, and
+a copy of the whole tree is just another reference to the same root. Nodes
+are reference counted: one for every parent and every tree that has them
+as root, and the last release frees a node. Different trees sharing nodes
+may be used from different threads; one tree is not thread-safe itself.
+*/
+
+template <typename T, typename Comparator = std::less<T>,
+          typename Allocator = std::allocator<T>>
+class PersistentTree;
+
+/*
+PersistentIterator
+Nodes have no parent links, since a node has as many parents as there are
+versions sharing it, so the iterator keeps the path from the root instead.
+It stays valid for as long as its tree is not changed, or for as long as
+any copy of the tree taken before the change lives.
+*/
+
+template <typename Tree>
+class PersistentIterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename Tree::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+
+  PersistentIterator() = default;
+
+  reference operator*() const { return path_[depth_ - 1]->value(); }
+  pointer operator->() const { return &path_[depth_ - 1]->value(); }
+  PersistentIterator& operator++();
+  PersistentIterator& operator--();
+  PersistentIterator operator++(int) {
+    PersistentIterator result = *this;
+    ++*this;
+    return result;
+  }
+  PersistentIterator operator--(int) {
+    PersistentIterator result = *this;
+    --*this;
+    return result;
+  }
+  bool operator==(const PersistentIterator& other) const {
+    return node() == other.node();
+  }
+  bool operator!=(const PersistentIterator& other) const {
+    return node() != other.node();
+  }
+
+ private:
+  using Node = typename Tree::Node;
+
+  friend Tree;
+
+  explicit PersistentIterator(const Node* root) : root_(root) {}
+
+  const Node* node() const { return depth_ ? path_[depth_ - 1] : nullptr; }
+  void push(const Node* node) { path_[depth_++] = node; }
+  // Pushes node and goes down from it as far left (or right) as it can
+  void descend(const Node* node, bool right);
+
+  const Node* root_ = nullptr;
+  const Node* path_[Tree::kMaxHeight] = {};
+  int depth_ = 0;  // 0 is end()
+};
+
+template <typename T, typename Comparator, typename Allocator>
+class PersistentTree {
+ public:
+  using value_type = T;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+  using iterator = PersistentIterator<PersistentTree>;
+  using const_iterator = iterator;
+
+  PersistentTree() = default;
+  explicit PersistentTree(const Allocator& alloc) : alloc_(alloc) {}
+  // O(1): the copy shares every node
+  PersistentTree(const PersistentTree& other);
+  PersistentTree(PersistentTree&& other) noexcept;
+  ~PersistentTree() { release(root_); }
+
+  PersistentTree& operator=(PersistentTree other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  iterator begin() const;
+  iterator end() const { return iterator(root_); }
+
+  bool empty() const { return size_ == 0U; }
+  size_type size() const { return size_; }
+  int height() const { return heightOf(root_); }
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+  void clear();
+  void swap(PersistentTree& other) noexcept;
+
+  // Inserts a value built from args unless key is there, and replaces the
+  // value of key with it if replace is set
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplace(const K& key, bool replace,
+                                    Args&&... args);
+  template <typename K>
+  size_type erase(const K& key);
+
+  template <typename K>
+  iterator find(const K& key) const;
+  template <typename K>
+  iterator lower_bound(const K& key) const {
+    return bound<false>(key);
+  }
+  template <typename K>
+  iterator upper_bound(const K& key) const {
+    return bound<true>(key);
+  }
+  template <typename K>
+  bool contains(const K& key) const;
+
+  // Whether both trees are versions that still share their root
+  bool shares_root_with(const PersistentTree& other) const {
+    return root_ == other.root_;
+  }
+
+  // Enough for any AVL tree that fits in memory: one of height 48 has
+  // more than 10^10 nodes
+  static constexpr int kMaxHeight = 48;
+
+ private:
+  template <typename>
+  friend class PersistentIterator;
+
+  struct Node {
+    mutable std::atomic<size_type> refs{1U};
+    Node* left = nullptr;
+    Node* right = nullptr;
+    int height = 1;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    const T& value() const {
+      return *std::launder(reinterpret_cast<const T*>(storage));
+    }
+  };
+
+  using node_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+  using value_traits = std::allocator_traits<Allocator>;
+
+  static int heightOf(const Node* node) { return node ? node->height : 0; }
+  static Node* acquire(Node* node);
+  void release(Node* node);
+
+  template <typename... Args>
+  Node* createNode(Node* left, Node* right, Args&&... args);
+  Node* copyNode(const Node* source, Node* left, Node* right);
+  Node* balance(const Node* source, Node* left, Node* right);
+  Node* rotateRight(const Node* source, Node* left, Node* right);
+  Node* rotateLeft(const Node* source, Node* left, Node* right);
+
+  template <typename K, typename... Args>
+  Node* insertAt(Node* node, const K& key, bool replace, bool& inserted,
+                 Args&&... args);
+  template <typename K>
+  Node* eraseAt(Node* node, const K& key, bool& erased);
+  Node* eraseMin(Node* node, const Node*& min);
+  template <bool Upper, typename K>
+  iterator bound(const K& key) const;
+
+  Node* root_ = nullptr;
+  size_type size_ = 0U;
+  Comparator comp_;
+  Allocator alloc_;
+};
+
+}  // namespace s21
+
+#include "PersistentTree.tpp"
+
+#endif
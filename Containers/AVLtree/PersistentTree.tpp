@@ -0,0 +1,374 @@
+#include "PersistentTree.h"
+
+namespace s21 {
+
+template <typename Tree>
+PersistentIterator<Tree>& PersistentIterator<Tree>::operator++() {
+  const Node* node = path_[depth_ - 1];
+  if (node->right) {
+    descend(node->right, false);
+  } else {
+    // Up to the first ancestor reached from its left subtree
+    const Node* child = nullptr;
+    do {
+      child = path_[--depth_];
+    } while (depth_ && path_[depth_ - 1]->right == child);
+  }
+  return *this;
+}
+
+template <typename Tree>
+PersistentIterator<Tree>& PersistentIterator<Tree>::operator--() {
+  if (!depth_) {
+    if (root_) descend(root_, true);
+    return *this;
+  }
+  const Node* node = path_[depth_ - 1];
+  if (node->left) {
+    descend(node->left, true);
+  } else {
+    const Node* child = nullptr;
+    do {
+      child = path_[--depth_];
+    } while (depth_ && path_[depth_ - 1]->left == child);
+  }
+  return *this;
+}
+
+template <typename Tree>
+void PersistentIterator<Tree>::descend(const Node* node, bool right) {
+  for (; node; node = right ? node->right : node->left) push(node);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+PersistentTree<T, Comparator, Allocator>::PersistentTree(
+    const PersistentTree& other)
+    : root_(acquire(other.root_)),
+      size_(other.size_),
+      comp_(other.comp_),
+      alloc_(value_traits::select_on_container_copy_construction(
+          other.alloc_)) {}
+
+template <typename T, typename Comparator, typename Allocator>
+PersistentTree<T, Comparator, Allocator>::PersistentTree(
+    PersistentTree&& other) noexcept
+    : root_(std::exchange(other.root_, nullptr)),
+      size_(std::exchange(other.size_, 0U)),
+      comp_(other.comp_),
+      alloc_(other.alloc_) {}
+
+template <typename T, typename Comparator, typename Allocator>
+typename PersistentTree<T, Comparator, Allocator>::iterator
+PersistentTree<T, Comparator, Allocator>::begin() const {
+  iterator it(root_);
+  it.descend(root_, false);
+  return it;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+void PersistentTree<T, Comparator, Allocator>::clear() {
+  release(std::exchange(root_, nullptr));
+  size_ = 0U;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+void PersistentTree<T, Comparator, Allocator>::swap(
+    PersistentTree& other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(size_, other.size_);
+  std::swap(comp_, other.comp_);
+  std::swap(alloc_, other.alloc_);
+}
+
+/*
+emplace
+Builds the new path bottom-up and only then lets the tree point to it, so
+the tree is left as it was if building a value throws. Nothing is copied
+when key is already there and replace is not set.
+*/
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K, typename... Args>
+std::pair<typename PersistentTree<T, Comparator, Allocator>::iterator, bool>
+PersistentTree<T, Comparator, Allocator>::emplace(const K& key, bool replace,
+                                                  Args&&... args) {
+  bool inserted = false;
+  Node* root =
+      insertAt(root_, key, replace, inserted, std::forward<Args>(args)...);
+  if (root) {
+    release(root_);
+    root_ = root;
+    if (inserted) ++size_;
+  }
+  return {find(key), inserted};
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+typename PersistentTree<T, Comparator, Allocator>::size_type
+PersistentTree<T, Comparator, Allocator>::erase(const K& key) {
+  bool erased = false;
+  Node* root = eraseAt(root_, key, erased);
+  if (!erased) return 0U;
+  release(root_);
+  root_ = root;
+  --size_;
+  return 1U;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+typename PersistentTree<T, Comparator, Allocator>::iterator
+PersistentTree<T, Comparator, Allocator>::find(const K& key) const {
+  iterator it = lower_bound(key);
+  if (it.depth_ && comp_(key, *it)) return end();
+  return it;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+bool PersistentTree<T, Comparator, Allocator>::contains(const K& key) const {
+  const Node* node = root_;
+  while (node) {
+    if (comp_(key, node->value())) {
+      node = node->left;
+    } else if (comp_(node->value(), key)) {
+      node = node->right;
+    } else {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The path to the first node not before (Upper == false) or after key
+template <typename T, typename Comparator, typename Allocator>
+template <bool Upper, typename K>
+typename PersistentTree<T, Comparator, Allocator>::iterator
+PersistentTree<T, Comparator, Allocator>::bound(const K& key) const {
+  iterator it(root_);
+  int depth = 0;
+  for (const Node* node = root_; node;) {
+    it.push(node);
+    if (Upper ? comp_(key, node->value()) : !comp_(node->value(), key)) {
+      depth = it.depth_;
+      node = node->left;
+    } else {
+      node = node->right;
+    }
+  }
+  it.depth_ = depth;
+  return it;
+}
+
+/*
+insertAt
+Returns the root of the new version of the subtree of node, or nullptr
+when nothing changes. Every new node on the way up shares the child it did
+not go down to with the old node.
+*/
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K, typename... Args>
+typename PersistentTree<T, Comparator, Allocator>::Node*
+PersistentTree<T, Comparator, Allocator>::insertAt(Node* node, const K& key,
+                                                   bool replace,
+                                                   bool& inserted,
+                                                   Args&&... args) {
+  if (!node) {
+    inserted = true;
+    return createNode(nullptr, nullptr, std::forward<Args>(args)...);
+  }
+  if (comp_(key, node->value())) {
+    Node* left = insertAt(node->left, key, replace, inserted,
+                          std::forward<Args>(args)...);
+    return left ? balance(node, left, acquire(node->right)) : nullptr;
+  }
+  if (comp_(node->value(), key)) {
+    Node* right = insertAt(node->right, key, replace, inserted,
+                           std::forward<Args>(args)...);
+    return right ? balance(node, acquire(node->left), right) : nullptr;
+  }
+  if (!replace) return nullptr;
+  return createNode(acquire(node->left), acquire(node->right),
+                    std::forward<Args>(args)...);
+}
+
+// Same as insertAt, with erased telling whether anything changed
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+typename PersistentTree<T, Comparator, Allocator>::Node*
+PersistentTree<T, Comparator, Allocator>::eraseAt(Node* node, const K& key,
+                                                  bool& erased) {
+  if (!node) return nullptr;
+  if (comp_(key, node->value())) {
+    Node* left = eraseAt(node->left, key, erased);
+    return erased ? balance(node, left, acquire(node->right)) : nullptr;
+  }
+  if (comp_(node->value(), key)) {
+    Node* right = eraseAt(node->right, key, erased);
+    return erased ? balance(node, acquire(node->left), right) : nullptr;
+  }
+  erased = true;
+  if (!node->left) return acquire(node->right);
+  if (!node->right) return acquire(node->left);
+  // The old version keeps min alive until the new one is complete
+  const Node* min = nullptr;
+  Node* right = eraseMin(node->right, min);
+  return balance(min, acquire(node->left), right);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+typename PersistentTree<T, Comparator, Allocator>::Node*
+PersistentTree<T, Comparator, Allocator>::eraseMin(Node* node,
+                                                   const Node*& min) {
+  if (!node->left) {
+    min = node;
+    return acquire(node->right);
+  }
+  Node* left = eraseMin(node->left, min);
+  return balance(node, left, acquire(node->right));
+}
+
+/*
+balance
+Copy of source with the given children, rotated if their heights differ
+by two. Like every function that takes children, it owns them from the
+call on and releases them if it throws.
+*/
+
+template <typename T, typename Comparator, typename Allocator>
+typename PersistentTree<T, Comparator, Allocator>::Node*
+PersistentTree<T, Comparator, Allocator>::balance(const Node* source,
+                                                  Node* left, Node* right) {
+  if (heightOf(left) > heightOf(right) + 1) {
+    return rotateRight(source, left, right);
+  }
+  if (heightOf(right) > heightOf(left) + 1) {
+    return rotateLeft(source, left, right);
+  }
+  return copyNode(source, left, right);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+typename PersistentTree<T, Comparator, Allocator>::Node*
+PersistentTree<T, Comparator, Allocator>::rotateRight(const Node* source,
+                                                      Node* left,
+                                                      Node* right) {
+  Node* pivot = left->right;
+  Node* root = nullptr;
+  try {
+    if (heightOf(left->left) >= heightOf(pivot)) {
+      Node* lower =
+          copyNode(source, acquire(pivot), std::exchange(right, nullptr));
+      root = copyNode(left, acquire(left->left), lower);
+    } else {
+      Node* lower = copyNode(source, acquire(pivot->right),
+                             std::exchange(right, nullptr));
+      Node* upper = nullptr;
+      try {
+        upper = copyNode(left, acquire(left->left), acquire(pivot->left));
+      } catch (...) {
+        release(lower);
+        throw;
+      }
+      root = copyNode(pivot, upper, lower);
+    }
+  } catch (...) {
+    release(right);
+    release(left);
+    throw;
+  }
+  release(left);
+  return root;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+typename PersistentTree<T, Comparator, Allocator>::Node*
+PersistentTree<T, Comparator, Allocator>::rotateLeft(const Node* source,
+                                                     Node* left,
+                                                     Node* right) {
+  Node* pivot = right->left;
+  Node* root = nullptr;
+  try {
+    if (heightOf(right->right) >= heightOf(pivot)) {
+      Node* lower =
+          copyNode(source, std::exchange(left, nullptr), acquire(pivot));
+      root = copyNode(right, lower, acquire(right->right));
+    } else {
+      Node* lower = copyNode(source, std::exchange(left, nullptr),
+                             acquire(pivot->left));
+      Node* upper = nullptr;
+      try {
+        upper = copyNode(right, acquire(pivot->right), acquire(right->right));
+      } catch (...) {
+        release(lower);
+        throw;
+      }
+      root = copyNode(pivot, lower, upper);
+    }
+  } catch (...) {
+    release(left);
+    release(right);
+    throw;
+  }
+  release(right);
+  return root;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+typename PersistentTree<T, Comparator, Allocator>::Node*
+PersistentTree<T, Comparator, Allocator>::acquire(Node* node) {
+  if (node) node->refs.fetch_add(1U, std::memory_order_relaxed);
+  return node;
+}
+
+// Frees node once nothing refers to it, and releases its children then
+template <typename T, typename Comparator, typename Allocator>
+void PersistentTree<T, Comparator, Allocator>::release(Node* node) {
+  if (!node || node->refs.fetch_sub(1U, std::memory_order_acq_rel) != 1U) {
+    return;
+  }
+  release(node->left);
+  release(node->right);
+  node_allocator nodeAlloc(alloc_);
+  value_traits::destroy(alloc_, reinterpret_cast<T*>(node->storage));
+  node->~Node();
+  node_traits::deallocate(nodeAlloc, node, 1U);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename... Args>
+typename PersistentTree<T, Comparator, Allocator>::Node*
+PersistentTree<T, Comparator, Allocator>::createNode(Node* left, Node* right,
+                                                     Args&&... args) {
+  node_allocator nodeAlloc(alloc_);
+  Node* node = nullptr;
+  try {
+    node = node_traits::allocate(nodeAlloc, 1U);
+    ::new (static_cast<void*>(node)) Node();
+    value_traits::construct(alloc_, reinterpret_cast<T*>(node->storage),
+                            std::forward<Args>(args)...);
+  } catch (...) {
+    if (node) {
+      node->~Node();
+      node_traits::deallocate(nodeAlloc, node, 1U);
+    }
+    release(left);
+    release(right);
+    throw;
+  }
+  node->left = left;
+  node->right = right;
+  node->height = 1 + std::max(heightOf(left), heightOf(right));
+  return node;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+typename PersistentTree<T, Comparator, Allocator>::Node*
+PersistentTree<T, Comparator, Allocator>::copyNode(const Node* source,
+                                                   Node* left, Node* right) {
+  return createNode(left, right, source->value());
+}
+
+}  // namespace s21
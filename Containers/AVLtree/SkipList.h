@@ -0,0 +1,187 @@
+#ifndef S21_SKIP_LIST
+#define S21_SKIP_LIST
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "Epoch.h"
+
+namespace s21 {
+
+/*
+SkipList
+Lock-free ordered set of unique values (Herlihy and Shavit). Every level
+is a sorted linked list and a node takes part in the lowest levels only,
+one more with probability 1/4. Links are CAS-updated words whose low bit
+marks the node that owns them as erased: erase marks a node top-down and
+owns the erase once it marks level 0; any later search snips marked nodes
+out of the level it walks. Unlinked nodes go to an EpochDomain, so a
+thread never touches freed memory while it is pinned. Comparator compares
+two values or a value and a key, as in Tree.
+*/
+
+template <typename T, typename Comparator = std::less<T>,
+          typename Allocator = std::allocator<T>>
+class SkipList;
+
+/*
+SkipListIterator
+Forward iterator over the values that are not erased, in order. It keeps
+its epoch pinned, so the node it points to stays readable even if another
+thread erases it meanwhile; it only stops pinning once it reaches end().
+*/
+
+template <typename List>
+class SkipListIterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = typename List::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+
+  SkipListIterator() = default;
+
+  reference operator*() const { return node_->value(); }
+  pointer operator->() const { return &node_->value(); }
+  SkipListIterator& operator++() {
+    node_ = List::nextLive(node_);
+    if (!node_) guard_ = EpochDomain::Guard();
+    return *this;
+  }
+  SkipListIterator operator++(int) {
+    SkipListIterator result = *this;
+    ++*this;
+    return result;
+  }
+  bool operator==(const SkipListIterator& other) const {
+    return node_ == other.node_;
+  }
+  bool operator!=(const SkipListIterator& other) const {
+    return node_ != other.node_;
+  }
+
+ private:
+  using Node = typename List::Node;
+
+  friend List;
+
+  SkipListIterator(Node* node, EpochDomain::Guard&& guard)
+      : node_(node), guard_(node ? std::move(guard) : EpochDomain::Guard()) {}
+
+  Node* node_ = nullptr;  // nullptr is end()
+  EpochDomain::Guard guard_;
+};
+
+template <typename T, typename Comparator, typename Allocator>
+class SkipList {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+  using iterator = SkipListIterator<SkipList>;
+  using const_iterator = iterator;
+
+  SkipList() : SkipList(Allocator()) {}
+  explicit SkipList(const Allocator& alloc);
+  SkipList(const SkipList&) = delete;
+  SkipList& operator=(const SkipList&) = delete;
+  // Not thread-safe: no other thread may use the list any more
+  ~SkipList();
+
+  iterator begin() const;
+  iterator end() const { return iterator(); }
+
+  // Exact while no thread is changing the list
+  size_type size() const { return size_.load(); }
+  bool empty() const { return size() == 0U; }
+  allocator_type get_allocator() const { return alloc_; }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return emplace(value);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return emplace(std::move(value));
+  }
+  template <typename K>
+  size_type erase(const K& key);
+  void clear();
+
+  template <typename K>
+  iterator find(const K& key) const;
+  template <typename K>
+  iterator lower_bound(const K& key) const;
+  template <typename K>
+  iterator upper_bound(const K& key) const;
+  template <typename K>
+  bool contains(const K& key) const;
+
+  static constexpr int kMaxHeight = 16;
+
+ private:
+  template <typename>
+  friend class SkipListIterator;
+
+  using Link = std::atomic<std::uintptr_t>;
+
+  struct Node : EpochNode {
+    // The inserting and the erasing thread both release the node; the
+    // last one retires it, so no thread can still be linking it then
+    std::atomic<int> owners{2};
+    int height = 0;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T& value() { return *std::launder(reinterpret_cast<T*>(storage)); }
+    // height links follow the node in the same allocation
+    Link* next() { return reinterpret_cast<Link*>(this + 1); }
+  };
+
+  using node_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+  using value_traits = std::allocator_traits<Allocator>;
+
+  static Node* pointerOf(std::uintptr_t link) {
+    return reinterpret_cast<Node*>(link & ~std::uintptr_t(1U));
+  }
+  static bool marked(std::uintptr_t link) { return link & 1U; }
+  static std::uintptr_t linkOf(Node* node) {
+    return reinterpret_cast<std::uintptr_t>(node);
+  }
+  static Node* nextLive(Node* node);
+
+  template <typename K>
+  bool search(const K& key, Node** preds, Node** succs) const;
+  template <bool Upper, typename K>
+  Node* bound(const K& key) const;
+  void linkUpper(Node* node, Node** preds, Node** succs);
+  void release(Node* node);
+
+  static int randomHeight();
+  static size_type blocksFor(int height);
+  Node* allocateNode(int height);
+  template <typename... Args>
+  Node* createNode(Args&&... args);
+  void destroyNode(Node* node);
+  static void reclaimNode(EpochNode* node, void* context);
+
+  Comparator comp_;
+  Allocator alloc_;
+  Node* head_ = nullptr;
+  std::atomic<size_type> size_{0U};
+  // Declared last: reclaims the retired nodes before alloc_ is destroyed
+  mutable EpochDomain domain_;
+};
+
+}  // namespace s21
+
+#include "SkipList.tpp"
+
+#endif
@@ -0,0 +1,303 @@
+#include "SkipList.h"
+
+namespace s21 {
+
+template <typename T, typename Comparator, typename Allocator>
+SkipList<T, Comparator, Allocator>::SkipList(const Allocator& alloc)
+    : alloc_(alloc), domain_(&SkipList::reclaimNode, this) {
+  head_ = allocateNode(kMaxHeight);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+SkipList<T, Comparator, Allocator>::~SkipList() {
+  Node* node = pointerOf(head_->next()[0].load());
+  while (node) {
+    Node* next = pointerOf(node->next()[0].load());
+    destroyNode(node);
+    node = next;
+  }
+  node_allocator nodeAlloc(alloc_);
+  head_->~Node();
+  node_traits::deallocate(nodeAlloc, head_, blocksFor(kMaxHeight));
+}
+
+template <typename T, typename Comparator, typename Allocator>
+typename SkipList<T, Comparator, Allocator>::iterator
+SkipList<T, Comparator, Allocator>::begin() const {
+  EpochDomain::Guard guard = domain_.pin();
+  return iterator(nextLive(head_), std::move(guard));
+}
+
+/*
+emplace
+Links the new node at level 0 first, which is the moment it becomes part
+of the set, and then at the levels above one by one. A node erased while
+it is being linked stops climbing.
+*/
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename... Args>
+std::pair<typename SkipList<T, Comparator, Allocator>::iterator, bool>
+SkipList<T, Comparator, Allocator>::emplace(Args&&... args) {
+  EpochDomain::Guard guard = domain_.pin();
+  Node* node = createNode(std::forward<Args>(args)...);
+  Node* preds[kMaxHeight];
+  Node* succs[kMaxHeight];
+  for (;;) {
+    if (search(node->value(), preds, succs)) {
+      destroyNode(node);
+      return {iterator(succs[0], std::move(guard)), false};
+    }
+    for (int level = 0; level < node->height; ++level) {
+      node->next()[level].store(linkOf(succs[level]));
+    }
+    std::uintptr_t expected = linkOf(succs[0]);
+    if (preds[0]->next()[0].compare_exchange_strong(expected, linkOf(node))) {
+      break;
+    }
+  }
+  ++size_;
+  linkUpper(node, preds, succs);
+  return {iterator(node, std::move(guard)), true};
+}
+
+template <typename T, typename Comparator, typename Allocator>
+void SkipList<T, Comparator, Allocator>::linkUpper(Node* node, Node** preds,
+                                                   Node** succs) {
+  for (int level = 1; level < node->height; ++level) {
+    for (;;) {
+      std::uintptr_t expected = linkOf(succs[level]);
+      if (preds[level]->next()[level].compare_exchange_strong(
+              expected, linkOf(node))) {
+        break;
+      }
+      search(node->value(), preds, succs);
+      std::uintptr_t current = node->next()[level].load();
+      if (marked(current) || marked(node->next()[0].load()) ||
+          !node->next()[level].compare_exchange_strong(
+              current, linkOf(succs[level]))) {
+        // Erased meanwhile: unlink whatever got linked and stop
+        search(node->value(), preds, succs);
+        release(node);
+        return;
+      }
+    }
+  }
+  // An erase may have marked the node while the last level was linked
+  if (marked(node->next()[0].load())) search(node->value(), preds, succs);
+  release(node);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+typename SkipList<T, Comparator, Allocator>::size_type
+SkipList<T, Comparator, Allocator>::erase(const K& key) {
+  EpochDomain::Guard guard = domain_.pin();
+  Node* preds[kMaxHeight];
+  Node* succs[kMaxHeight];
+  if (!search(key, preds, succs)) return 0U;
+  Node* victim = succs[0];
+  for (int level = victim->height - 1; level > 0; --level) {
+    std::uintptr_t succ = victim->next()[level].load();
+    while (!marked(succ) &&
+           !victim->next()[level].compare_exchange_weak(succ, succ | 1U)) {
+    }
+  }
+  std::uintptr_t succ = victim->next()[0].load();
+  do {
+    if (marked(succ)) return 0U;  // another thread erased it first
+  } while (!victim->next()[0].compare_exchange_weak(succ, succ | 1U));
+  --size_;
+  search(key, preds, succs);
+  release(victim);
+  return 1U;
+}
+
+// Not atomic as a whole: values inserted meanwhile may stay
+template <typename T, typename Comparator, typename Allocator>
+void SkipList<T, Comparator, Allocator>::clear() {
+  for (iterator it = begin(); it != end(); ++it) erase(*it);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+typename SkipList<T, Comparator, Allocator>::iterator
+SkipList<T, Comparator, Allocator>::find(const K& key) const {
+  EpochDomain::Guard guard = domain_.pin();
+  Node* node = bound<false>(key);
+  if (node && comp_(key, node->value())) node = nullptr;
+  return iterator(node, std::move(guard));
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+typename SkipList<T, Comparator, Allocator>::iterator
+SkipList<T, Comparator, Allocator>::lower_bound(const K& key) const {
+  EpochDomain::Guard guard = domain_.pin();
+  return iterator(bound<false>(key), std::move(guard));
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+typename SkipList<T, Comparator, Allocator>::iterator
+SkipList<T, Comparator, Allocator>::upper_bound(const K& key) const {
+  EpochDomain::Guard guard = domain_.pin();
+  return iterator(bound<true>(key), std::move(guard));
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+bool SkipList<T, Comparator, Allocator>::contains(const K& key) const {
+  EpochDomain::Guard guard = domain_.pin();
+  Node* node = bound<false>(key);
+  return node && !comp_(key, node->value());
+}
+
+/*
+search
+Fills preds and succs with the neighbours of key on every level: the last
+node before key and the first one not before it. Marked nodes met on the
+way are snipped out; a failed snip means pred itself changed, and the walk
+starts over from the head. Returns whether succs[0] holds key.
+*/
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename K>
+bool SkipList<T, Comparator, Allocator>::search(const K& key, Node** preds,
+                                                Node** succs) const {
+  bool restart = true;
+  while (restart) {
+    restart = false;
+    Node* pred = head_;
+    for (int level = kMaxHeight - 1; level >= 0 && !restart; --level) {
+      Node* curr = pointerOf(pred->next()[level].load());
+      while (curr) {
+        std::uintptr_t succ = curr->next()[level].load();
+        if (marked(succ)) {
+          std::uintptr_t expected = linkOf(curr);
+          if (!pred->next()[level].compare_exchange_strong(
+                  expected, linkOf(pointerOf(succ)))) {
+            restart = true;
+            break;
+          }
+          curr = pointerOf(succ);
+        } else if (comp_(curr->value(), key)) {
+          pred = curr;
+          curr = pointerOf(succ);
+        } else {
+          break;
+        }
+      }
+      preds[level] = pred;
+      succs[level] = curr;
+    }
+  }
+  return succs[0] && !comp_(key, succs[0]->value());
+}
+
+// First live node not before (Upper == false) or after key; read only
+template <typename T, typename Comparator, typename Allocator>
+template <bool Upper, typename K>
+typename SkipList<T, Comparator, Allocator>::Node*
+SkipList<T, Comparator, Allocator>::bound(const K& key) const {
+  Node* pred = head_;
+  for (int level = kMaxHeight - 1; level >= 0; --level) {
+    Node* curr = pointerOf(pred->next()[level].load());
+    while (curr && (Upper ? !comp_(key, curr->value())
+                          : comp_(curr->value(), key))) {
+      pred = curr;
+      curr = pointerOf(curr->next()[level].load());
+    }
+  }
+  return nextLive(pred);
+}
+
+// First node after node that is not erased, nullptr at the end
+template <typename T, typename Comparator, typename Allocator>
+typename SkipList<T, Comparator, Allocator>::Node*
+SkipList<T, Comparator, Allocator>::nextLive(Node* node) {
+  Node* next = pointerOf(node->next()[0].load());
+  while (next && marked(next->next()[0].load())) {
+    next = pointerOf(next->next()[0].load());
+  }
+  return next;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+void SkipList<T, Comparator, Allocator>::release(Node* node) {
+  if (node->owners.fetch_sub(1) == 1) domain_.retire(node);
+}
+
+// 1 + the number of levels climbed with probability 1/4 each
+template <typename T, typename Comparator, typename Allocator>
+int SkipList<T, Comparator, Allocator>::randomHeight() {
+  thread_local std::uint64_t state =
+      std::hash<std::thread::id>()(std::this_thread::get_id()) |
+      0x9E3779B97F4A7C15ULL;
+  state ^= state << 13U;
+  state ^= state >> 7U;
+  state ^= state << 17U;
+  std::uint64_t bits = state;
+  int height = 1;
+  while (height < kMaxHeight && !(bits & 3U)) {
+    ++height;
+    bits >>= 2U;
+  }
+  return height;
+}
+
+// Nodes worth of storage for a node and its height links
+template <typename T, typename Comparator, typename Allocator>
+typename SkipList<T, Comparator, Allocator>::size_type
+SkipList<T, Comparator, Allocator>::blocksFor(int height) {
+  size_type links = sizeof(Link) * static_cast<size_type>(height);
+  return 1U + (links + sizeof(Node) - 1U) / sizeof(Node);
+}
+
+template <typename T, typename Comparator, typename Allocator>
+typename SkipList<T, Comparator, Allocator>::Node*
+SkipList<T, Comparator, Allocator>::allocateNode(int height) {
+  node_allocator nodeAlloc(alloc_);
+  Node* node = node_traits::allocate(nodeAlloc, blocksFor(height));
+  ::new (static_cast<void*>(node)) Node();
+  node->height = height;
+  for (int level = 0; level < height; ++level) {
+    ::new (static_cast<void*>(node->next() + level)) Link(0U);
+  }
+  return node;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+template <typename... Args>
+typename SkipList<T, Comparator, Allocator>::Node*
+SkipList<T, Comparator, Allocator>::createNode(Args&&... args) {
+  Node* node = allocateNode(randomHeight());
+  try {
+    value_traits::construct(alloc_, reinterpret_cast<T*>(node->storage),
+                            std::forward<Args>(args)...);
+  } catch (...) {
+    node_allocator nodeAlloc(alloc_);
+    int height = node->height;
+    node->~Node();
+    node_traits::deallocate(nodeAlloc, node, blocksFor(height));
+    throw;
+  }
+  return node;
+}
+
+template <typename T, typename Comparator, typename Allocator>
+void SkipList<T, Comparator, Allocator>::destroyNode(Node* node) {
+  node_allocator nodeAlloc(alloc_);
+  int height = node->height;
+  value_traits::destroy(alloc_, &node->value());
+  node->~Node();
+  node_traits::deallocate(nodeAlloc, node, blocksFor(height));
+}
+
+template <typename T, typename Comparator, typename Allocator>
+void SkipList<T, Comparator, Allocator>::reclaimNode(EpochNode* node,
+                                                     void* context) {
+  static_cast<SkipList*>(context)->destroyNode(static_cast<Node*>(node));
+}
+
+}  // namespace s21
@@ -0,0 +1,95 @@
+// Throughput of concurrent_ordered_map against an s21::map behind one mutex,
+// for a mix of 80% lookups, 10% inserts and 10% erases over a shared key
+// range. Build and run with `make bench`.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+
+namespace {
+
+const int kKeyRange = 1 << 16;
+const int kOpsPerThread = 200000;
+
+class LockedMap {
+ public:
+  bool contains(int key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return map_.contains(key);
+  }
+  void insert(int key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    map_.insert(key, key);
+  }
+  void erase(int key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = map_.find(key);
+    if (it != map_.end()) map_.erase(it);
+  }
+
+ private:
+  std::mutex mutex_;
+  s21::map<int, int> map_;
+};
+
+class LockFreeMap {
+ public:
+  bool contains(int key) { return map_.contains(key); }
+  void insert(int key) { map_.insert(key, key); }
+  void erase(int key) { map_.erase(key); }
+
+ private:
+  s21::concurrent_ordered_map<int, int> map_;
+};
+
+// Millions of operations per second over all threads
+template <typename Map>
+double Run(int threadCount) {
+  Map map;
+  for (int key = 0; key < kKeyRange; key += 2) map.insert(key);
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (int t = 0; t < threadCount; ++t) {
+    threads.emplace_back([&map, t] {
+      std::uint32_t state = 2463534242U + static_cast<std::uint32_t>(t);
+      int hits = 0;
+      for (int i = 0; i < kOpsPerThread; ++i) {
+        state ^= state << 13U;
+        state ^= state >> 17U;
+        state ^= state << 5U;
+        int key = static_cast<int>(state % kKeyRange);
+        int op = static_cast<int>(state >> 24U) % 10;
+        if (op == 0) {
+          map.insert(key);
+        } else if (op == 1) {
+          map.erase(key);
+        } else {
+          hits += map.contains(key);
+        }
+      }
+      if (hits < 0) std::puts("");  // keeps the lookups alive
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return threadCount * static_cast<double>(kOpsPerThread) / 1e6 /
+         elapsed.count();
+}
+
+}  // namespace
+
+int main() {
+  std::printf("%8s %16s %16s\n", "threads", "mutex Mops/s", "lock-free Mops/s");
+  for (int threads = 1; threads <= 64; threads *= 2) {
+    std::printf("%8d %16.2f %16.2f\n", threads, Run<LockedMap>(threads),
+                Run<LockFreeMap>(threads));
+  }
+  return 0;
+}
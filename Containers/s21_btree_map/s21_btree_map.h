@@ -0,0 +1,332 @@
+#ifndef S21_BTREE_MAP_H
+#define S21_BTREE_MAP_H
+
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../AVLtree/BTree.h"
+#include "../s21_map/s21_map.h"
+
+namespace s21 {
+
+/*
+btree_map
+map stored in a B+-tree: the same lookup, bound and iteration interface as
+map, with far fewer cache misses on large maps. Insert and erase invalidate
+iterators. No order statistics.
+*/
+
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class btree_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using tree_type =
+      BTree<Key, value_type, BTreeSelectFirst, Compare, Allocator>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+
+  // Constructors
+  btree_map() = default;
+  explicit btree_map(const Allocator &alloc) : tree_(alloc) {}
+  btree_map(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  btree_map(InputIt first, InputIt last);
+
+  mapped_type &operator[](const key_type &key);
+  mapped_type &at(const key_type &key);
+  const mapped_type &at(const key_type &key) const;
+
+  allocator_type get_allocator() const;
+
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+  size_type max_size() const;
+  int height() const;
+
+  // Modifiers
+  void clear();
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  std::pair<iterator, bool> insert(const key_type &key, const mapped_type &obj);
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             const mapped_type &obj);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const key_type &key);
+  void swap(btree_map &other);
+  void merge(btree_map &other);
+
+  // Lookup
+  iterator find(const key_type &key);
+  const_iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+  iterator lower_bound(const key_type &key);
+  const_iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key);
+  const_iterator upper_bound(const key_type &key) const;
+
+  // Iterators
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+ private:
+  tree_type tree_;
+};
+
+// Implementation of methods
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+btree_map<Key, T, Compare, Allocator>::btree_map(
+    std::initializer_list<value_type> const &items) {
+  tree_.assign(items.begin(), items.end(), true);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename InputIt>
+btree_map<Key, T, Compare, Allocator>::btree_map(InputIt first,
+                                                 InputIt last) {
+  tree_.assign(first, last, true);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::mapped_type &
+btree_map<Key, T, Compare, Allocator>::operator[](const key_type &key) {
+  return try_emplace(key).first->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::mapped_type &
+btree_map<Key, T, Compare, Allocator>::at(const key_type &key) {
+  iterator it = find(key);
+  if (it == end()) throw std::out_of_range("btree_map key is not found");
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+const typename btree_map<Key, T, Compare, Allocator>::mapped_type &
+btree_map<Key, T, Compare, Allocator>::at(const key_type &key) const {
+  const_iterator it = find(key);
+  if (it == end()) throw std::out_of_range("btree_map key is not found");
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::allocator_type
+btree_map<Key, T, Compare, Allocator>::get_allocator() const {
+  return tree_.get_allocator();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool btree_map<Key, T, Compare, Allocator>::empty() const {
+  return tree_.empty();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::size_type
+btree_map<Key, T, Compare, Allocator>::size() const {
+  return tree_.size();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::size_type
+btree_map<Key, T, Compare, Allocator>::max_size() const {
+  return tree_.max_size();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+int btree_map<Key, T, Compare, Allocator>::height() const {
+  return tree_.height();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void btree_map<Key, T, Compare, Allocator>::clear() {
+  tree_.clear();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::insert(const value_type &value) {
+  return tree_.insert(value, true);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::insert(value_type &&value) {
+  return tree_.insert(std::move(value), true);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::insert(const key_type &key,
+                                              const mapped_type &obj) {
+  return try_emplace(key, obj);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::insert_or_assign(
+    const key_type &key, const mapped_type &obj) {
+  auto result = try_emplace(key, obj);
+  if (!result.second) result.first->second = obj;
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::emplace(Args &&...args) {
+  return tree_.emplace(true, std::forward<Args>(args)...);
+}
+
+// Builds the pair only when key is missing
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::try_emplace(const key_type &key,
+                                                   Args &&...args) {
+  iterator it = find(key);
+  if (it != end()) return {it, false};
+  return tree_.emplace(true, std::piecewise_construct,
+                       std::forward_as_tuple(key),
+                       std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::iterator
+btree_map<Key, T, Compare, Allocator>::erase(const_iterator pos) {
+  return tree_.erase(pos);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::iterator
+btree_map<Key, T, Compare, Allocator>::erase(const_iterator first,
+                                             const_iterator last) {
+  return tree_.erase(first, last);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::size_type
+btree_map<Key, T, Compare, Allocator>::erase(const key_type &key) {
+  iterator it = find(key);
+  if (it == end()) return 0U;
+  tree_.erase(it);
+  return 1U;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void btree_map<Key, T, Compare, Allocator>::swap(btree_map &other) {
+  tree_.swap(other.tree_);
+}
+
+// Keys already present here stay in other
+template <typename Key, typename T, typename Compare, typename Allocator>
+void btree_map<Key, T, Compare, Allocator>::merge(btree_map &other) {
+  if (this == &other) return;
+  for (const_iterator it = other.begin(); it != other.end();) {
+    if (insert(*it).second) {
+      it = other.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::iterator
+btree_map<Key, T, Compare, Allocator>::find(const key_type &key) {
+  return tree_.find(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::const_iterator
+btree_map<Key, T, Compare, Allocator>::find(const key_type &key) const {
+  return tree_.find(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool btree_map<Key, T, Compare, Allocator>::contains(
+    const key_type &key) const {
+  return tree_.contains(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::iterator
+btree_map<Key, T, Compare, Allocator>::lower_bound(const key_type &key) {
+  return tree_.lower_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::const_iterator
+btree_map<Key, T, Compare, Allocator>::lower_bound(
+    const key_type &key) const {
+  return tree_.lower_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::iterator
+btree_map<Key, T, Compare, Allocator>::upper_bound(const key_type &key) {
+  return tree_.upper_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::const_iterator
+btree_map<Key, T, Compare, Allocator>::upper_bound(
+    const key_type &key) const {
+  return tree_.upper_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::iterator
+btree_map<Key, T, Compare, Allocator>::begin() {
+  return tree_.begin();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::iterator
+btree_map<Key, T, Compare, Allocator>::end() {
+  return tree_.end();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::const_iterator
+btree_map<Key, T, Compare, Allocator>::begin() const {
+  return tree_.begin();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::const_iterator
+btree_map<Key, T, Compare, Allocator>::end() const {
+  return tree_.end();
+}
+
+// map or btree_map, chosen by avl_tree_tag or btree_tag
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>,
+          typename Storage = avl_tree_tag>
+using ordered_map =
+    std::conditional_t<std::is_same_v<Storage, btree_tag>,
+                       btree_map<Key, T, Compare, Allocator>,
+                       map<Key, T, Compare, Allocator>>;
+
+}  // namespace s21
+
+#endif  // S21_BTREE_MAP_H
@@ -0,0 +1,90 @@
+#ifndef S21_BTREE_MULTISET_H
+#define S21_BTREE_MULTISET_H
+
+#include <utility>
+
+#include "../s21_btree_set/s21_btree_set.h"
+#include "../s21_multiset/s21_multiset.h"
+
+namespace s21 {
+
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class btree_multiset : public btree_set<Key, Compare, Allocator> {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using tree_type = typename btree_set<Key, Compare, Allocator>::tree_type;
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+
+  btree_multiset() = default;
+  explicit btree_multiset(const Allocator& alloc)
+      : btree_set<Key, Compare, Allocator>(alloc) {}
+  btree_multiset(std::initializer_list<value_type> const& items);
+  template <typename InputIt>
+  btree_multiset(InputIt first, InputIt last);
+
+  iterator insert(const value_type& value);
+  iterator insert(value_type&& value);
+  template <typename... Args>
+  iterator emplace(Args&&... args);
+  void merge(btree_multiset& other);
+};
+
+template <typename Key, typename Compare, typename Allocator>
+btree_multiset<Key, Compare, Allocator>::btree_multiset(
+    std::initializer_list<value_type> const& items) {
+  this->tree_.assign(items.begin(), items.end(), false);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+btree_multiset<Key, Compare, Allocator>::btree_multiset(InputIt first,
+                                                        InputIt last) {
+  this->tree_.assign(first, last, false);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename btree_multiset<Key, Compare, Allocator>::iterator
+btree_multiset<Key, Compare, Allocator>::insert(const value_type& value) {
+  return this->tree_.insert(value, false).first;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename btree_multiset<Key, Compare, Allocator>::iterator
+btree_multiset<Key, Compare, Allocator>::insert(value_type&& value) {
+  return this->tree_.insert(std::move(value), false).first;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename btree_multiset<Key, Compare, Allocator>::iterator
+btree_multiset<Key, Compare, Allocator>::emplace(Args&&... args) {
+  return this->tree_.emplace(false, std::forward<Args>(args)...).first;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void btree_multiset<Key, Compare, Allocator>::merge(btree_multiset& other) {
+  if (this == &other) return;
+  for (const value_type& value : other) insert(value);
+  other.clear();
+}
+
+// multiset or btree_multiset, chosen by avl_tree_tag or btree_tag
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>,
+          typename Storage = avl_tree_tag>
+using ordered_multiset =
+    std::conditional_t<std::is_same_v<Storage, btree_tag>,
+                       btree_multiset<Key, Compare, Allocator>,
+                       multiset<Key, Compare, Allocator>>;
+
+}  // namespace s21
+
+#endif  // S21_BTREE_MULTISET_H
@@ -0,0 +1,245 @@
+#ifndef S21_BTREE_SET_H
+#define S21_BTREE_SET_H
+
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+#include "../AVLtree/BTree.h"
+#include "../s21_set/s21_set.h"
+
+namespace s21 {
+
+/*
+btree_set
+set stored in a B+-tree: the same lookup, bound and iteration interface as
+set, with far fewer cache misses on large sets. Insert and erase invalidate
+iterators. No order statistics or join-based set algebra.
+*/
+
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class btree_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using tree_type = BTree<Key, Key, BTreeIdentity, Compare, Allocator>;
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+
+  // Constructors
+  btree_set() = default;
+  explicit btree_set(const Allocator& alloc) : tree_(alloc) {}
+  btree_set(std::initializer_list<value_type> const& items);
+  template <typename InputIt>
+  btree_set(InputIt first, InputIt last);
+
+  allocator_type get_allocator() const;
+
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+  size_type max_size() const;
+  int height() const;
+
+  // Modifiers
+  void clear();
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const value_type& key);
+  void swap(btree_set& other);
+  void merge(btree_set& other);
+
+  // Lookup
+  iterator find(const value_type& key) const;
+  bool contains(const value_type& key) const;
+  size_type count(const value_type& key) const;
+  iterator lower_bound(const value_type& key) const;
+  iterator upper_bound(const value_type& key) const;
+  std::pair<iterator, iterator> equal_range(const value_type& key) const;
+
+  // Iterators
+  iterator begin() const;
+  iterator end() const;
+
+ protected:
+  tree_type tree_;
+};
+
+// Implementation of methods
+
+template <typename Key, typename Compare, typename Allocator>
+btree_set<Key, Compare, Allocator>::btree_set(
+    std::initializer_list<value_type> const& items) {
+  tree_.assign(items.begin(), items.end(), true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+btree_set<Key, Compare, Allocator>::btree_set(InputIt first, InputIt last) {
+  tree_.assign(first, last, true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename btree_set<Key, Compare, Allocator>::allocator_type
+btree_set<Key, Compare, Allocator>::get_allocator() const {
+  return tree_.get_allocator();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+bool btree_set<Key, Compare, Allocator>::empty() const {
+  return tree_.empty();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename btree_set<Key, Compare, Allocator>::size_type
+btree_set<Key, Compare, Allocator>::size() const {
+  return tree_.size();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename btree_set<Key, Compare, Allocator>::size_type
+btree_set<Key, Compare, Allocator>::max_size() const {
+  return tree_.max_size();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+int btree_set<Key, Compare, Allocator>::height() const {
+  return tree_.height();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void btree_set<Key, Compare, Allocator>::clear() {
+  tree_.clear();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename btree_set<Key, Compare, Allocator>::iterator, bool>
+btree_set<Key, Compare, Allocator>::insert(const value_type& value) {
+  return tree_.insert(value, true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename btree_set<Key, Compare, Allocator>::iterator, bool>
+btree_set<Key, Compare, Allocator>::insert(value_type&& value) {
+  return tree_.insert(std::move(value), true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename btree_set<Key, Compare, Allocator>::iterator, bool>
+btree_set<Key, Compare, Allocator>::emplace(Args&&... args) {
+  return tree_.emplace(true, std::forward<Args>(args)...);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename btree_set<Key, Compare, Allocator>::iterator
+btree_set<Key, Compare, Allocator>::erase(const_iterator pos) {
+  return tree_.erase(pos);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename btree_set<Key, Compare, Allocator>::iterator
+btree_set<Key, Compare, Allocator>::erase(const_iterator first,
+                                          const_iterator last) {
+  return tree_.erase(first, last);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename btree_set<Key, Compare, Allocator>::size_type
+btree_set<Key, Compare, Allocator>::erase(const value_type& key) {
+  auto range = equal_range(key);
+  size_type count = tree_.count(key);
+  tree_.erase(range.first, range.second);
+  return count;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void btree_set<Key, Compare, Allocator>::swap(btree_set& other) {
+  tree_.swap(other.tree_);
+}
+
+// Keys already present here stay in other
+template <typename Key, typename Compare, typename Allocator>
+void btree_set<Key, Compare, Allocator>::merge(btree_set& other) {
+  if (this == &other) return;
+  for (const_iterator it = other.begin(); it != other.end();) {
+    if (insert(*it).second) {
+      it = other.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename btree_set<Key, Compare, Allocator>::iterator
+btree_set<Key, Compare, Allocator>::find(const value_type& key) const {
+  return tree_.find(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+bool btree_set<Key, Compare, Allocator>::contains(
+    const value_type& key) const {
+  return tree_.contains(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename btree_set<Key, Compare, Allocator>::size_type
+btree_set<Key, Compare, Allocator>::count(const value_type& key) const {
+  return tree_.count(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename btree_set<Key, Compare, Allocator>::iterator
+btree_set<Key, Compare, Allocator>::lower_bound(const value_type& key) const {
+  return tree_.lower_bound(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename btree_set<Key, Compare, Allocator>::iterator
+btree_set<Key, Compare, Allocator>::upper_bound(const value_type& key) const {
+  return tree_.upper_bound(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename btree_set<Key, Compare, Allocator>::iterator,
+          typename btree_set<Key, Compare, Allocator>::iterator>
+btree_set<Key, Compare, Allocator>::equal_range(const value_type& key) const {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename btree_set<Key, Compare, Allocator>::iterator
+btree_set<Key, Compare, Allocator>::begin() const {
+  return tree_.begin();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename btree_set<Key, Compare, Allocator>::iterator
+btree_set<Key, Compare, Allocator>::end() const {
+  return tree_.end();
+}
+
+// set or btree_set, chosen by avl_tree_tag or btree_tag
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>,
+          typename Storage = avl_tree_tag>
+using ordered_set =
+    std::conditional_t<std::is_same_v<Storage, btree_tag>,
+                       btree_set<Key, Compare, Allocator>,
+                       set<Key, Compare, Allocator>>;
+
+}  // namespace s21
+
+#endif  // S21_BTREE_SET_H
@@ -0,0 +1,288 @@
+#ifndef S21_COMPACT_MAP_H
+#define S21_COMPACT_MAP_H
+
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "../AVLtree/CompactTree.h"
+#include "../s21_map/s21_map.h"
+
+namespace s21 {
+
+/*
+compact_map
+map on top of CompactTree: half the memory per node, no order statistics.
+An insert into a full array moves every element (see CompactTree):
+references and pointers to elements, mapped values included, are
+invalidated then, iterators stay valid. reserve() avoids the move.
+*/
+
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class compact_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using tree_type =
+      CompactTree<value_type, Comparatormap<value_type, Compare>, Allocator>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+
+  // Constructors
+  compact_map() = default;
+  explicit compact_map(const Allocator &alloc) : tree_(alloc) {}
+  compact_map(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  compact_map(InputIt first, InputIt last);
+
+  mapped_type &operator[](const key_type &key);
+  mapped_type &at(const key_type &key);
+  const mapped_type &at(const key_type &key) const;
+
+  allocator_type get_allocator() const;
+
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+  size_type max_size() const;
+  size_type capacity() const;
+  void reserve(size_type count);
+  int height() const;
+
+  // Modifiers
+  void clear();
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  iterator erase(const_iterator pos);
+  size_type erase(const key_type &key);
+  void swap(compact_map &other);
+
+  // Lookup
+  iterator find(const key_type &key);
+  const_iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+  iterator lower_bound(const key_type &key);
+  iterator upper_bound(const key_type &key);
+
+  // Iterators
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+ private:
+  // mutable so that const lookups can reuse the tree's search functions
+  mutable tree_type tree_;
+};
+
+// Implementation of methods
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+compact_map<Key, T, Compare, Allocator>::compact_map(
+    std::initializer_list<value_type> const &items)
+    : compact_map(items.begin(), items.end()) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename InputIt>
+compact_map<Key, T, Compare, Allocator>::compact_map(InputIt first,
+                                                     InputIt last) {
+  for (; first != last; ++first) tree_.insert(*first, true);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::mapped_type &
+compact_map<Key, T, Compare, Allocator>::operator[](const key_type &key) {
+  return try_emplace(key).first->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::mapped_type &
+compact_map<Key, T, Compare, Allocator>::at(const key_type &key) {
+  iterator it = tree_.find(key);
+  if (it == end()) throw std::out_of_range("compact_map key is not found");
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+const typename compact_map<Key, T, Compare, Allocator>::mapped_type &
+compact_map<Key, T, Compare, Allocator>::at(const key_type &key) const {
+  return const_cast<compact_map &>(*this).at(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::allocator_type
+compact_map<Key, T, Compare, Allocator>::get_allocator() const {
+  return tree_.get_allocator();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool compact_map<Key, T, Compare, Allocator>::empty() const {
+  return tree_.empty();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::size_type
+compact_map<Key, T, Compare, Allocator>::size() const {
+  return tree_.size();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::size_type
+compact_map<Key, T, Compare, Allocator>::max_size() const {
+  return tree_.max_size();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::size_type
+compact_map<Key, T, Compare, Allocator>::capacity() const {
+  return tree_.capacity();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void compact_map<Key, T, Compare, Allocator>::reserve(size_type count) {
+  tree_.reserve(count);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+int compact_map<Key, T, Compare, Allocator>::height() const {
+  return tree_.height();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void compact_map<Key, T, Compare, Allocator>::clear() {
+  tree_.clear();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename compact_map<Key, T, Compare, Allocator>::iterator, bool>
+compact_map<Key, T, Compare, Allocator>::insert(const value_type &value) {
+  return tree_.insert(value, true);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename compact_map<Key, T, Compare, Allocator>::iterator, bool>
+compact_map<Key, T, Compare, Allocator>::insert(value_type &&value) {
+  return tree_.insert(std::move(value), true);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename M>
+std::pair<typename compact_map<Key, T, Compare, Allocator>::iterator, bool>
+compact_map<Key, T, Compare, Allocator>::insert_or_assign(const key_type &key,
+                                                          M &&obj) {
+  auto result = try_emplace(key, std::forward<M>(obj));
+  if (!result.second) result.first->second = std::forward<M>(obj);
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename compact_map<Key, T, Compare, Allocator>::iterator, bool>
+compact_map<Key, T, Compare, Allocator>::emplace(Args &&...args) {
+  return tree_.emplace(true, std::forward<Args>(args)...);
+}
+
+// Builds the pair only when key is missing
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename compact_map<Key, T, Compare, Allocator>::iterator, bool>
+compact_map<Key, T, Compare, Allocator>::try_emplace(const key_type &key,
+                                                     Args &&...args) {
+  iterator it = tree_.find(key);
+  if (it != end()) return {it, false};
+  return tree_.emplace(true, std::piecewise_construct,
+                       std::forward_as_tuple(key),
+                       std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::iterator
+compact_map<Key, T, Compare, Allocator>::erase(const_iterator pos) {
+  return tree_.erase(pos);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::size_type
+compact_map<Key, T, Compare, Allocator>::erase(const key_type &key) {
+  iterator it = tree_.find(key);
+  if (it == end()) return 0U;
+  tree_.erase(it);
+  return 1U;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void compact_map<Key, T, Compare, Allocator>::swap(compact_map &other) {
+  tree_.swap(other.tree_);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::iterator
+compact_map<Key, T, Compare, Allocator>::find(const key_type &key) {
+  return tree_.find(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::const_iterator
+compact_map<Key, T, Compare, Allocator>::find(const key_type &key) const {
+  return tree_.find(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool compact_map<Key, T, Compare, Allocator>::contains(
+    const key_type &key) const {
+  return tree_.contains(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::iterator
+compact_map<Key, T, Compare, Allocator>::lower_bound(const key_type &key) {
+  return tree_.lower_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::iterator
+compact_map<Key, T, Compare, Allocator>::upper_bound(const key_type &key) {
+  return tree_.upper_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::iterator
+compact_map<Key, T, Compare, Allocator>::begin() {
+  return tree_.begin();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::iterator
+compact_map<Key, T, Compare, Allocator>::end() {
+  return tree_.end();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::const_iterator
+compact_map<Key, T, Compare, Allocator>::begin() const {
+  return static_cast<const tree_type &>(tree_).begin();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::const_iterator
+compact_map<Key, T, Compare, Allocator>::end() const {
+  return static_cast<const tree_type &>(tree_).end();
+}
+
+}  // namespace s21
+
+#endif  // S21_COMPACT_MAP_H
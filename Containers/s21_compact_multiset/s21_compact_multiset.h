@@ -0,0 +1,90 @@
+#ifndef S21_COMPACT_MULTISET_H
+#define S21_COMPACT_MULTISET_H
+
+#include <utility>
+
+#include "../s21_compact_set/s21_compact_set.h"
+
+namespace s21 {
+
+/*
+compact_multiset
+multiset on top of CompactTree: equal keys are kept in insertion order.
+References follow the same rules as in compact_set.
+*/
+
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class compact_multiset : public compact_set<Key, Compare, Allocator> {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename compact_set<Key, Compare, Allocator>::iterator;
+  using const_iterator =
+      typename compact_set<Key, Compare, Allocator>::const_iterator;
+  using size_type = size_t;
+
+  compact_multiset() = default;
+  explicit compact_multiset(const Allocator& alloc)
+      : compact_set<Key, Compare, Allocator>(alloc) {}
+  compact_multiset(std::initializer_list<value_type> const& items);
+  template <typename InputIt>
+  compact_multiset(InputIt first, InputIt last);
+
+  iterator insert(const value_type& value);
+  iterator insert(value_type&& value);
+  template <typename... Args>
+  iterator emplace(Args&&... args);
+  size_type count(const value_type& key) const;
+};
+
+template <typename Key, typename Compare, typename Allocator>
+compact_multiset<Key, Compare, Allocator>::compact_multiset(
+    std::initializer_list<value_type> const& items)
+    : compact_multiset(items.begin(), items.end()) {}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+compact_multiset<Key, Compare, Allocator>::compact_multiset(InputIt first,
+                                                            InputIt last) {
+  for (; first != last; ++first) this->tree_.insert(*first, false);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename compact_multiset<Key, Compare, Allocator>::iterator
+compact_multiset<Key, Compare, Allocator>::insert(const value_type& value) {
+  return this->tree_.insert(value, false).first;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename compact_multiset<Key, Compare, Allocator>::iterator
+compact_multiset<Key, Compare, Allocator>::insert(value_type&& value) {
+  return this->tree_.insert(std::move(value), false).first;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename compact_multiset<Key, Compare, Allocator>::iterator
+compact_multiset<Key, Compare, Allocator>::emplace(Args&&... args) {
+  return this->tree_.emplace(false, std::forward<Args>(args)...).first;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename compact_multiset<Key, Compare, Allocator>::size_type
+compact_multiset<Key, Compare, Allocator>::count(
+    const value_type& key) const {
+  size_type result = 0U;
+  for (iterator it = this->lower_bound(key), last = this->upper_bound(key);
+       it != last; ++it) {
+    ++result;
+  }
+  return result;
+}
+
+}  // namespace s21
+
+#endif  // S21_COMPACT_MULTISET_H
@@ -0,0 +1,206 @@
+#ifndef S21_COMPACT_SET_H
+#define S21_COMPACT_SET_H
+
+#include <initializer_list>
+#include <utility>
+
+#include "../AVLtree/CompactTree.h"
+
+namespace s21 {
+
+/*
+compact_set
+set on top of CompactTree: the same ordered unique keys with half the
+memory per node, at the price of no order statistics and no set algebra.
+An insert into a full array moves every key (see CompactTree): references
+and pointers to keys are invalidated then, iterators stay valid. reserve()
+keeps references valid until the reserved capacity is used up.
+compact_multiset keeps duplicates.
+*/
+
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class compact_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using tree_type = CompactTree<value_type, Compare, Allocator>;
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+
+  // Constructors
+  compact_set() = default;
+  explicit compact_set(const Allocator& alloc) : tree_(alloc) {}
+  compact_set(std::initializer_list<value_type> const& items);
+  template <typename InputIt>
+  compact_set(InputIt first, InputIt last);
+
+  allocator_type get_allocator() const;
+
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+  size_type max_size() const;
+  size_type capacity() const;
+  void reserve(size_type count);
+  int height() const;
+
+  // Modifiers
+  void clear();
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  iterator erase(const_iterator pos);
+  void swap(compact_set& other);
+
+  // Lookup
+  iterator find(const value_type& key) const;
+  bool contains(const value_type& key) const;
+  iterator lower_bound(const value_type& key) const;
+  iterator upper_bound(const value_type& key) const;
+
+  // Iterators
+  iterator begin() const;
+  iterator end() const;
+
+ protected:
+  // mutable: keys are handed out as const anyway, so lookups on a const set
+  // may use the same tree functions
+  mutable tree_type tree_;
+};
+
+// Implementation of methods
+
+template <typename Key, typename Compare, typename Allocator>
+compact_set<Key, Compare, Allocator>::compact_set(
+    std::initializer_list<value_type> const& items)
+    : compact_set(items.begin(), items.end()) {}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+compact_set<Key, Compare, Allocator>::compact_set(InputIt first,
+                                                  InputIt last) {
+  for (; first != last; ++first) tree_.insert(*first, true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename compact_set<Key, Compare, Allocator>::allocator_type
+compact_set<Key, Compare, Allocator>::get_allocator() const {
+  return tree_.get_allocator();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+bool compact_set<Key, Compare, Allocator>::empty() const {
+  return tree_.empty();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename compact_set<Key, Compare, Allocator>::size_type
+compact_set<Key, Compare, Allocator>::size() const {
+  return tree_.size();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename compact_set<Key, Compare, Allocator>::size_type
+compact_set<Key, Compare, Allocator>::max_size() const {
+  return tree_.max_size();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename compact_set<Key, Compare, Allocator>::size_type
+compact_set<Key, Compare, Allocator>::capacity() const {
+  return tree_.capacity();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void compact_set<Key, Compare, Allocator>::reserve(size_type count) {
+  tree_.reserve(count);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+int compact_set<Key, Compare, Allocator>::height() const {
+  return tree_.height();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void compact_set<Key, Compare, Allocator>::clear() {
+  tree_.clear();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename compact_set<Key, Compare, Allocator>::iterator, bool>
+compact_set<Key, Compare, Allocator>::insert(const value_type& value) {
+  return tree_.insert(value, true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename compact_set<Key, Compare, Allocator>::iterator, bool>
+compact_set<Key, Compare, Allocator>::insert(value_type&& value) {
+  return tree_.insert(std::move(value), true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename compact_set<Key, Compare, Allocator>::iterator, bool>
+compact_set<Key, Compare, Allocator>::emplace(Args&&... args) {
+  return tree_.emplace(true, std::forward<Args>(args)...);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename compact_set<Key, Compare, Allocator>::iterator
+compact_set<Key, Compare, Allocator>::erase(const_iterator pos) {
+  return tree_.erase(pos);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void compact_set<Key, Compare, Allocator>::swap(compact_set& other) {
+  tree_.swap(other.tree_);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename compact_set<Key, Compare, Allocator>::iterator
+compact_set<Key, Compare, Allocator>::find(const value_type& key) const {
+  return tree_.find(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+bool compact_set<Key, Compare, Allocator>::contains(
+    const value_type& key) const {
+  return tree_.contains(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename compact_set<Key, Compare, Allocator>::iterator
+compact_set<Key, Compare, Allocator>::lower_bound(
+    const value_type& key) const {
+  return tree_.lower_bound(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename compact_set<Key, Compare, Allocator>::iterator
+compact_set<Key, Compare, Allocator>::upper_bound(
+    const value_type& key) const {
+  return tree_.upper_bound(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename compact_set<Key, Compare, Allocator>::iterator
+compact_set<Key, Compare, Allocator>::begin() const {
+  return static_cast<const tree_type&>(tree_).begin();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename compact_set<Key, Compare, Allocator>::iterator
+compact_set<Key, Compare, Allocator>::end() const {
+  return static_cast<const tree_type&>(tree_).end();
+}
+
+}  // namespace s21
+
+#endif  // S21_COMPACT_SET_H
@@ -0,0 +1,235 @@
+#ifndef S21_CONCURRENT_MAP_H
+#define S21_CONCURRENT_MAP_H
+
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+#include "../s21_map/s21_map.h"
+
+namespace s21 {
+
+/*
+concurrent_map
+Thread-safe map split into shards: each key belongs to one of a fixed
+number of independent maps, picked by its hash, and every shard has its
+own reader-writer lock. Readers of one shard never wait for each other,
+and writers only block the shard they touch, so throughput grows with the
+number of threads instead of queueing on one global mutex.
+Nothing hands out references into the shards: lookups return copies and
+for_each works on a copy of one shard at a time.
+*/
+
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Hash = std::hash<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class concurrent_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
+  using hasher = Hash;
+  using allocator_type = Allocator;
+  using shard_type = map<Key, T, Compare, Allocator>;
+  using size_type = size_t;
+
+  static constexpr size_type kDefaultShards = 16U;
+
+  // Constructors; shardCount is rounded up to a power of two
+  explicit concurrent_map(size_type shardCount = kDefaultShards);
+  concurrent_map(std::initializer_list<value_type> const &items);
+  concurrent_map(const concurrent_map &) = delete;
+  concurrent_map &operator=(const concurrent_map &) = delete;
+
+  // Capacity; a snapshot that may be stale once it is returned
+  bool empty() const;
+  size_type size() const;
+  size_type shard_count() const;
+
+  // Modifiers
+  void clear();
+  bool insert(const key_type &key, const mapped_type &obj);
+  bool insert_or_assign(const key_type &key, const mapped_type &obj);
+  size_type erase(const key_type &key);
+
+  // Lookup
+  std::optional<mapped_type> find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+
+  // Calls func(key, value) for every element, shard by shard. Each shard is
+  // copied under its read lock and visited after the lock is released, so
+  // func may use this map freely.
+  template <typename Func>
+  void for_each(Func func) const;
+
+ private:
+  // One cache line or more per shard, so that the locks of neighbouring
+  // shards do not bounce the same line between cores
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    shard_type items;
+  };
+
+  Shard &shardFor(const key_type &key) const;
+
+  std::unique_ptr<Shard[]> shards_;
+  size_type shardCount_;
+  unsigned shift_;  // 64 - log2(shardCount_)
+  Hash hash_;
+};
+
+// Implementation of methods
+
+template <typename Key, typename T, typename Compare, typename Hash,
+          typename Allocator>
+concurrent_map<Key, T, Compare, Hash, Allocator>::concurrent_map(
+    size_type shardCount)
+    : shardCount_(1U), shift_(64U) {
+  while (shardCount_ < shardCount) {
+    shardCount_ *= 2U;
+    --shift_;
+  }
+  shards_.reset(new Shard[shardCount_]);
+}
+
+template <typename Key, typename T, typename Compare, typename Hash,
+          typename Allocator>
+concurrent_map<Key, T, Compare, Hash, Allocator>::concurrent_map(
+    std::initializer_list<value_type> const &items)
+    : concurrent_map() {
+  for (const value_type &item : items) insert(item.first, item.second);
+}
+
+template <typename Key, typename T, typename Compare, typename Hash,
+          typename Allocator>
+bool concurrent_map<Key, T, Compare, Hash, Allocator>::empty() const {
+  return size() == 0U;
+}
+
+template <typename Key, typename T, typename Compare, typename Hash,
+          typename Allocator>
+typename concurrent_map<Key, T, Compare, Hash, Allocator>::size_type
+concurrent_map<Key, T, Compare, Hash, Allocator>::size() const {
+  size_type result = 0U;
+  for (size_type i = 0U; i < shardCount_; ++i) {
+    std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+    result += shards_[i].items.size();
+  }
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Hash,
+          typename Allocator>
+typename concurrent_map<Key, T, Compare, Hash, Allocator>::size_type
+concurrent_map<Key, T, Compare, Hash, Allocator>::shard_count() const {
+  return shardCount_;
+}
+
+template <typename Key, typename T, typename Compare, typename Hash,
+          typename Allocator>
+void concurrent_map<Key, T, Compare, Hash, Allocator>::clear() {
+  for (size_type i = 0U; i < shardCount_; ++i) {
+    std::unique_lock<std::shared_mutex> lock(shards_[i].mutex);
+    shards_[i].items.clear();
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Hash,
+          typename Allocator>
+bool concurrent_map<Key, T, Compare, Hash, Allocator>::insert(
+    const key_type &key, const mapped_type &obj) {
+  Shard &shard = shardFor(key);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  return shard.items.insert(key, obj).second;
+}
+
+template <typename Key, typename T, typename Compare, typename Hash,
+          typename Allocator>
+bool concurrent_map<Key, T, Compare, Hash, Allocator>::insert_or_assign(
+    const key_type &key, const mapped_type &obj) {
+  Shard &shard = shardFor(key);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  return shard.items.insert_or_assign(key, obj).second;
+}
+
+template <typename Key, typename T, typename Compare, typename Hash,
+          typename Allocator>
+typename concurrent_map<Key, T, Compare, Hash, Allocator>::size_type
+concurrent_map<Key, T, Compare, Hash, Allocator>::erase(const key_type &key) {
+  Shard &shard = shardFor(key);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  auto it = shard.items.find(key);
+  if (it == shard.items.end()) return 0U;
+  shard.items.erase(it);
+  return 1U;
+}
+
+// map::find only reads the tree, so readers may share it
+template <typename Key, typename T, typename Compare, typename Hash,
+          typename Allocator>
+std::optional<typename concurrent_map<Key, T, Compare, Hash,
+                                      Allocator>::mapped_type>
+concurrent_map<Key, T, Compare, Hash, Allocator>::find(
+    const key_type &key) const {
+  Shard &shard = shardFor(key);
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  auto it = shard.items.find(key);
+  if (it == shard.items.end()) return std::nullopt;
+  return (*it).second;
+}
+
+template <typename Key, typename T, typename Compare, typename Hash,
+          typename Allocator>
+bool concurrent_map<Key, T, Compare, Hash, Allocator>::contains(
+    const key_type &key) const {
+  Shard &shard = shardFor(key);
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  return shard.items.contains(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Hash,
+          typename Allocator>
+template <typename Func>
+void concurrent_map<Key, T, Compare, Hash, Allocator>::for_each(
+    Func func) const {
+  std::vector<std::pair<Key, T>> snapshot;
+  for (size_type i = 0U; i < shardCount_; ++i) {
+    snapshot.clear();
+    {
+      std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+      const shard_type &items = shards_[i].items;
+      snapshot.reserve(items.size());
+      for (auto it = items.begin(); it != items.end(); ++it) {
+        snapshot.emplace_back((*it).first, (*it).second);
+      }
+    }
+    for (const auto &item : snapshot) func(item.first, item.second);
+  }
+}
+
+/*
+shardFor
+Fibonacci hashing: the top bits of hash * 2^64 / phi pick the shard, so
+keys with similar or identity hashes still spread over all shards
+*/
+
+template <typename Key, typename T, typename Compare, typename Hash,
+          typename Allocator>
+typename concurrent_map<Key, T, Compare, Hash, Allocator>::Shard &
+concurrent_map<Key, T, Compare, Hash, Allocator>::shardFor(
+    const key_type &key) const {
+  if (shardCount_ == 1U) return shards_[0];
+  std::uint64_t hash = hash_(key) * 0x9E3779B97F4A7C15ULL;
+  return shards_[static_cast<size_type>(hash >> shift_)];
+}
+
+}  // namespace s21
+
+#endif  // S21_CONCURRENT_MAP_H
@@ -0,0 +1,218 @@
+#ifndef S21_CONCURRENT_ORDERED_MAP_H
+#define S21_CONCURRENT_ORDERED_MAP_H
+
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "../AVLtree/SkipList.h"
+#include "../s21_map/s21_map.h"
+
+namespace s21 {
+
+/*
+concurrent_ordered_map
+Lock-free ordered map on SkipList for write-heavy workloads that also scan
+ranges, where even concurrent_map would lock shard after shard. Entries
+are immutable once inserted, since another thread may be reading them:
+to change a value, erase the key and insert it again. at() returns a copy
+for the same reason.
+*/
+
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class concurrent_ordered_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using list_type =
+      SkipList<value_type, Comparatormap<value_type, Compare>, Allocator>;
+  using iterator = typename list_type::iterator;
+  using const_iterator = typename list_type::const_iterator;
+  using size_type = size_t;
+
+  // Constructors
+  concurrent_ordered_map() = default;
+  explicit concurrent_ordered_map(const Allocator &alloc) : list_(alloc) {}
+  concurrent_ordered_map(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  concurrent_ordered_map(InputIt first, InputIt last);
+
+  mapped_type at(const key_type &key) const;
+
+  allocator_type get_allocator() const;
+
+  // Capacity; exact only while no other thread changes the map
+  bool empty() const;
+  size_type size() const;
+
+  // Modifiers
+  void clear();
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  std::pair<iterator, bool> insert(const key_type &key, const mapped_type &obj);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  size_type erase(const key_type &key);
+
+  // Lookup
+  iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+  iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key) const;
+
+  // Iterators
+  iterator begin() const;
+  iterator end() const;
+
+ private:
+  list_type list_;
+};
+
+// Implementation of methods
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+concurrent_ordered_map<Key, T, Compare, Allocator>::concurrent_ordered_map(
+    std::initializer_list<value_type> const &items) {
+  for (const value_type &item : items) list_.insert(item);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename InputIt>
+concurrent_ordered_map<Key, T, Compare, Allocator>::concurrent_ordered_map(
+    InputIt first, InputIt last) {
+  for (; first != last; ++first) list_.emplace(*first);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename concurrent_ordered_map<Key, T, Compare, Allocator>::mapped_type
+concurrent_ordered_map<Key, T, Compare, Allocator>::at(
+    const key_type &key) const {
+  iterator it = list_.find(key);
+  if (it == list_.end()) throw std::out_of_range("Key not found");
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename concurrent_ordered_map<Key, T, Compare, Allocator>::allocator_type
+concurrent_ordered_map<Key, T, Compare, Allocator>::get_allocator() const {
+  return list_.get_allocator();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool concurrent_ordered_map<Key, T, Compare, Allocator>::empty() const {
+  return list_.empty();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename concurrent_ordered_map<Key, T, Compare, Allocator>::size_type
+concurrent_ordered_map<Key, T, Compare, Allocator>::size() const {
+  return list_.size();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void concurrent_ordered_map<Key, T, Compare, Allocator>::clear() {
+  list_.clear();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename concurrent_ordered_map<Key, T, Compare, Allocator>::iterator,
+          bool>
+concurrent_ordered_map<Key, T, Compare, Allocator>::insert(
+    const value_type &value) {
+  return list_.insert(value);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename concurrent_ordered_map<Key, T, Compare, Allocator>::iterator,
+          bool>
+concurrent_ordered_map<Key, T, Compare, Allocator>::insert(
+    value_type &&value) {
+  return list_.insert(std::move(value));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename concurrent_ordered_map<Key, T, Compare, Allocator>::iterator,
+          bool>
+concurrent_ordered_map<Key, T, Compare, Allocator>::insert(
+    const key_type &key, const mapped_type &obj) {
+  return list_.emplace(key, obj);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename concurrent_ordered_map<Key, T, Compare, Allocator>::iterator,
+          bool>
+concurrent_ordered_map<Key, T, Compare, Allocator>::emplace(Args &&...args) {
+  return list_.emplace(std::forward<Args>(args)...);
+}
+
+// Unlike map::try_emplace the value is built even when key is present
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename concurrent_ordered_map<Key, T, Compare, Allocator>::iterator,
+          bool>
+concurrent_ordered_map<Key, T, Compare, Allocator>::try_emplace(
+    const key_type &key, Args &&...args) {
+  return list_.emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                       std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename concurrent_ordered_map<Key, T, Compare, Allocator>::size_type
+concurrent_ordered_map<Key, T, Compare, Allocator>::erase(
+    const key_type &key) {
+  return list_.erase(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename concurrent_ordered_map<Key, T, Compare, Allocator>::iterator
+concurrent_ordered_map<Key, T, Compare, Allocator>::find(
+    const key_type &key) const {
+  return list_.find(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool concurrent_ordered_map<Key, T, Compare, Allocator>::contains(
+    const key_type &key) const {
+  return list_.contains(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename concurrent_ordered_map<Key, T, Compare, Allocator>::iterator
+concurrent_ordered_map<Key, T, Compare, Allocator>::lower_bound(
+    const key_type &key) const {
+  return list_.lower_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename concurrent_ordered_map<Key, T, Compare, Allocator>::iterator
+concurrent_ordered_map<Key, T, Compare, Allocator>::upper_bound(
+    const key_type &key) const {
+  return list_.upper_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename concurrent_ordered_map<Key, T, Compare, Allocator>::iterator
+concurrent_ordered_map<Key, T, Compare, Allocator>::begin() const {
+  return list_.begin();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename concurrent_ordered_map<Key, T, Compare, Allocator>::iterator
+concurrent_ordered_map<Key, T, Compare, Allocator>::end() const {
+  return list_.end();
+}
+
+}  // namespace s21
+
+#endif  // S21_CONCURRENT_ORDERED_MAP_H
@@ -0,0 +1,204 @@
+#ifndef S21_CONCURRENT_SET_H
+#define S21_CONCURRENT_SET_H
+
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+#include "../AVLtree/SkipList.h"
+
+namespace s21 {
+
+/*
+concurrent_set
+Ordered set that any number of threads may insert into, erase from, search
+and iterate at the same time, built on the lock-free SkipList. Iterators
+are forward only; each one pins the epoch while it is not end(), so keep
+them short-lived, as memory of erased keys is only reclaimed after every
+iterator that could see it is gone.
+*/
+
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class concurrent_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using list_type = SkipList<Key, Compare, Allocator>;
+  using iterator = typename list_type::iterator;
+  using const_iterator = typename list_type::const_iterator;
+  using size_type = size_t;
+
+  // Constructors
+  concurrent_set() = default;
+  explicit concurrent_set(const Allocator& alloc) : list_(alloc) {}
+  concurrent_set(std::initializer_list<value_type> const& items);
+  template <typename InputIt>
+  concurrent_set(InputIt first, InputIt last);
+
+  allocator_type get_allocator() const;
+
+  // Capacity; exact only while no other thread changes the set
+  bool empty() const;
+  size_type size() const;
+
+  // Modifiers
+  void clear();
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  size_type erase(const value_type& key);
+
+  // Lookup
+  iterator find(const value_type& key) const;
+  bool contains(const value_type& key) const;
+  iterator lower_bound(const value_type& key) const;
+  iterator upper_bound(const value_type& key) const;
+
+  // Lookup by any key-like type when Compare is transparent
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K& key) const;
+
+  // Iterators
+  iterator begin() const;
+  iterator end() const;
+
+ private:
+  list_type list_;
+};
+
+// Implementation of methods
+
+template <typename Key, typename Compare, typename Allocator>
+concurrent_set<Key, Compare, Allocator>::concurrent_set(
+    std::initializer_list<value_type> const& items) {
+  for (const value_type& item : items) list_.insert(item);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+concurrent_set<Key, Compare, Allocator>::concurrent_set(InputIt first,
+                                                        InputIt last) {
+  for (; first != last; ++first) list_.emplace(*first);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename concurrent_set<Key, Compare, Allocator>::allocator_type
+concurrent_set<Key, Compare, Allocator>::get_allocator() const {
+  return list_.get_allocator();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+bool concurrent_set<Key, Compare, Allocator>::empty() const {
+  return list_.empty();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename concurrent_set<Key, Compare, Allocator>::size_type
+concurrent_set<Key, Compare, Allocator>::size() const {
+  return list_.size();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void concurrent_set<Key, Compare, Allocator>::clear() {
+  list_.clear();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename concurrent_set<Key, Compare, Allocator>::iterator, bool>
+concurrent_set<Key, Compare, Allocator>::insert(const value_type& value) {
+  return list_.insert(value);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename concurrent_set<Key, Compare, Allocator>::iterator, bool>
+concurrent_set<Key, Compare, Allocator>::insert(value_type&& value) {
+  return list_.insert(std::move(value));
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename concurrent_set<Key, Compare, Allocator>::iterator, bool>
+concurrent_set<Key, Compare, Allocator>::emplace(Args&&... args) {
+  return list_.emplace(std::forward<Args>(args)...);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename concurrent_set<Key, Compare, Allocator>::size_type
+concurrent_set<Key, Compare, Allocator>::erase(const value_type& key) {
+  return list_.erase(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename concurrent_set<Key, Compare, Allocator>::iterator
+concurrent_set<Key, Compare, Allocator>::find(const value_type& key) const {
+  return list_.find(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+bool concurrent_set<Key, Compare, Allocator>::contains(
+    const value_type& key) const {
+  return list_.contains(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename concurrent_set<Key, Compare, Allocator>::iterator
+concurrent_set<Key, Compare, Allocator>::lower_bound(
+    const value_type& key) const {
+  return list_.lower_bound(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename concurrent_set<Key, Compare, Allocator>::iterator
+concurrent_set<Key, Compare, Allocator>::upper_bound(
+    const value_type& key) const {
+  return list_.upper_bound(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename concurrent_set<Key, Compare, Allocator>::iterator
+concurrent_set<Key, Compare, Allocator>::find(const K& key) const {
+  return list_.find(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+bool concurrent_set<Key, Compare, Allocator>::contains(const K& key) const {
+  return list_.contains(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename concurrent_set<Key, Compare, Allocator>::iterator
+concurrent_set<Key, Compare, Allocator>::lower_bound(const K& key) const {
+  return list_.lower_bound(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename concurrent_set<Key, Compare, Allocator>::iterator
+concurrent_set<Key, Compare, Allocator>::begin() const {
+  return list_.begin();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename concurrent_set<Key, Compare, Allocator>::iterator
+concurrent_set<Key, Compare, Allocator>::end() const {
+  return list_.end();
+}
+
+}  // namespace s21
+
+#endif  // S21_CONCURRENT_SET_H
@@ -5,6 +5,24 @@
 #include <vector>
 
 #include "./s21_array/s21_array.h"
+#include "./s21_btree_map/s21_btree_map.h"
+#include "./s21_btree_multiset/s21_btree_multiset.h"
+#include "./s21_btree_set/s21_btree_set.h"
+#include "./s21_compact_map/s21_compact_map.h"
+#include "./s21_compact_multiset/s21_compact_multiset.h"
+#include "./s21_compact_set/s21_compact_set.h"
+#include "./s21_concurrent_map/s21_concurrent_map.h"
+#include "./s21_concurrent_ordered_map/s21_concurrent_ordered_map.h"
+#include "./s21_concurrent_set/s21_concurrent_set.h"
+#include "./s21_counted_multiset/s21_counted_multiset.h"
+#include "./s21_flat_map/s21_flat_map.h"
+#include "./s21_flat_multiset/s21_flat_multiset.h"
+#include "./s21_flat_set/s21_flat_set.h"
+#include "./s21_frozen_map/s21_frozen_map.h"
+#include "./s21_frozen_set/s21_frozen_set.h"
 #include "./s21_multiset/s21_multiset.h"
+#include "./s21_persistent_map/s21_persistent_map.h"
+#include "./s21_unordered_map/s21_unordered_map.h"
+#include "./s21_unordered_set/s21_unordered_set.h"
 
 #endif
\ No newline at end of file
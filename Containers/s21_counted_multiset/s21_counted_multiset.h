@@ -0,0 +1,317 @@
+#ifndef S21_COUNTED_MULTISET_H
+#define S21_COUNTED_MULTISET_H
+
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include "../s21_map/s21_map.h"
+
+namespace s21 {
+
+/*
+CountedIterator
+Walks a counted_multiset one copy at a time: the run it is in and which
+copy of the run it stands for.
+*/
+
+template <typename Key, typename RunIterator>
+class CountedIterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = Key;
+  using difference_type = std::ptrdiff_t;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+  using size_type = size_t;
+
+  CountedIterator() = default;
+  CountedIterator(RunIterator run, size_type index)
+      : run_(run), index_(index) {}
+
+  reference operator*() const { return run_->first; }
+  pointer operator->() const { return &run_->first; }
+  CountedIterator& operator++() {
+    if (++index_ == run_->second) {
+      ++run_;
+      index_ = 0U;
+    }
+    return *this;
+  }
+  CountedIterator& operator--() {
+    if (index_ == 0U) {
+      --run_;
+      index_ = run_->second;
+    }
+    --index_;
+    return *this;
+  }
+  CountedIterator operator++(int) {
+    CountedIterator result = *this;
+    ++*this;
+    return result;
+  }
+  CountedIterator operator--(int) {
+    CountedIterator result = *this;
+    --*this;
+    return result;
+  }
+  bool operator==(const CountedIterator& other) const {
+    return run_ == other.run_ && index_ == other.index_;
+  }
+  bool operator!=(const CountedIterator& other) const {
+    return !(*this == other);
+  }
+
+  RunIterator run() const { return run_; }
+  size_type index() const { return index_; }
+
+ private:
+  RunIterator run_;
+  size_type index_ = 0U;
+};
+
+/*
+counted_multiset
+multiset that keeps one node per distinct key together with the number of
+copies, so memory and the cost of insert, erase, count and equal_range
+depend on the number of distinct keys only. Iterators still visit every
+copy. Equivalent keys share one stored key, the first one inserted.
+*/
+
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class counted_multiset {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+  using size_type = size_t;
+  using run_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<std::pair<const Key, size_type>>;
+  using map_type = map<Key, size_type, Compare, run_allocator>;
+  // Copies are never modified in place, so both walk the runs read-only
+  using iterator = CountedIterator<Key, typename map_type::const_iterator>;
+  using const_iterator = iterator;
+
+  // Constructors
+  counted_multiset() = default;
+  explicit counted_multiset(const Allocator& alloc)
+      : runs_(run_allocator(alloc)) {}
+  counted_multiset(std::initializer_list<value_type> const& items);
+  template <typename InputIt>
+  counted_multiset(InputIt first, InputIt last);
+
+  allocator_type get_allocator() const;
+
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+  // Number of runs, that is of distinct keys
+  size_type distinct_count() const;
+
+  // Modifiers
+  void clear();
+  iterator insert(const value_type& value);
+  iterator insert(value_type&& value);
+  // Adds count copies at once; returns the first of them, end() if none
+  iterator insert(const value_type& value, size_type count);
+  template <typename... Args>
+  iterator emplace(Args&&... args);
+  iterator erase(const_iterator pos);
+  size_type erase(const key_type& key);
+  void swap(counted_multiset& other);
+
+  // Lookup
+  size_type count(const key_type& key) const;
+  iterator find(const key_type& key) const;
+  bool contains(const key_type& key) const;
+  iterator lower_bound(const key_type& key) const;
+  iterator upper_bound(const key_type& key) const;
+  std::pair<iterator, iterator> equal_range(const key_type& key) const;
+
+  // Iterators
+  iterator begin() const;
+  iterator end() const;
+
+ private:
+  map_type runs_;
+  size_type size_ = 0U;
+};
+
+// Implementation of methods
+
+template <typename Key, typename Compare, typename Allocator>
+counted_multiset<Key, Compare, Allocator>::counted_multiset(
+    std::initializer_list<value_type> const& items)
+    : counted_multiset(items.begin(), items.end()) {}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+counted_multiset<Key, Compare, Allocator>::counted_multiset(InputIt first,
+                                                            InputIt last) {
+  for (; first != last; ++first) insert(*first);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename counted_multiset<Key, Compare, Allocator>::allocator_type
+counted_multiset<Key, Compare, Allocator>::get_allocator() const {
+  return allocator_type(runs_.get_allocator());
+}
+
+template <typename Key, typename Compare, typename Allocator>
+bool counted_multiset<Key, Compare, Allocator>::empty() const {
+  return size_ == 0U;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename counted_multiset<Key, Compare, Allocator>::size_type
+counted_multiset<Key, Compare, Allocator>::size() const {
+  return size_;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename counted_multiset<Key, Compare, Allocator>::size_type
+counted_multiset<Key, Compare, Allocator>::distinct_count() const {
+  return runs_.size();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void counted_multiset<Key, Compare, Allocator>::clear() {
+  runs_.clear();
+  size_ = 0U;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename counted_multiset<Key, Compare, Allocator>::iterator
+counted_multiset<Key, Compare, Allocator>::insert(const value_type& value) {
+  return insert(value, 1U);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename counted_multiset<Key, Compare, Allocator>::iterator
+counted_multiset<Key, Compare, Allocator>::insert(value_type&& value) {
+  auto run = runs_.try_emplace(std::move(value), 0U).first;
+  ++size_;
+  return iterator(run, run->second++);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename counted_multiset<Key, Compare, Allocator>::iterator
+counted_multiset<Key, Compare, Allocator>::insert(const value_type& value,
+                                                  size_type count) {
+  if (count == 0U) return end();
+  auto run = runs_.try_emplace(value, 0U).first;
+  size_type first = run->second;
+  run->second += count;
+  size_ += count;
+  return iterator(run, first);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename counted_multiset<Key, Compare, Allocator>::iterator
+counted_multiset<Key, Compare, Allocator>::emplace(Args&&... args) {
+  return insert(value_type(std::forward<Args>(args)...));
+}
+
+// Removes one copy; the run goes away with its last copy
+template <typename Key, typename Compare, typename Allocator>
+typename counted_multiset<Key, Compare, Allocator>::iterator
+counted_multiset<Key, Compare, Allocator>::erase(const_iterator pos) {
+  // A tree const_iterator is an iterator as well: this is the only place
+  // that needs write access to the run pos stands in
+  typename map_type::iterator run = pos.run();
+  --size_;
+  if (pos.index() + 1U < run->second--) return iterator(run, pos.index());
+  auto next = run;
+  ++next;
+  if (run->second == 0U) runs_.erase(run);
+  return iterator(next, 0U);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename counted_multiset<Key, Compare, Allocator>::size_type
+counted_multiset<Key, Compare, Allocator>::erase(const key_type& key) {
+  auto run = runs_.find(key);
+  if (run == runs_.end()) return 0U;
+  size_type count = run->second;
+  runs_.erase(run);
+  size_ -= count;
+  return count;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void counted_multiset<Key, Compare, Allocator>::swap(
+    counted_multiset& other) {
+  runs_.swap(other.runs_);
+  std::swap(size_, other.size_);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename counted_multiset<Key, Compare, Allocator>::size_type
+counted_multiset<Key, Compare, Allocator>::count(const key_type& key) const {
+  auto run = runs_.find(key);
+  return run == runs_.end() ? 0U : run->second;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename counted_multiset<Key, Compare, Allocator>::iterator
+counted_multiset<Key, Compare, Allocator>::find(const key_type& key) const {
+  return iterator(runs_.find(key), 0U);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+bool counted_multiset<Key, Compare, Allocator>::contains(
+    const key_type& key) const {
+  return runs_.contains(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename counted_multiset<Key, Compare, Allocator>::iterator
+counted_multiset<Key, Compare, Allocator>::lower_bound(
+    const key_type& key) const {
+  return iterator(runs_.lower_bound(key), 0U);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename counted_multiset<Key, Compare, Allocator>::iterator
+counted_multiset<Key, Compare, Allocator>::upper_bound(
+    const key_type& key) const {
+  return iterator(runs_.upper_bound(key), 0U);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename counted_multiset<Key, Compare, Allocator>::iterator,
+          typename counted_multiset<Key, Compare, Allocator>::iterator>
+counted_multiset<Key, Compare, Allocator>::equal_range(
+    const key_type& key) const {
+  auto run = runs_.find(key);
+  if (run == runs_.end()) {
+    iterator bound = lower_bound(key);
+    return {bound, bound};
+  }
+  auto next = run;
+  ++next;
+  return {iterator(run, 0U), iterator(next, 0U)};
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename counted_multiset<Key, Compare, Allocator>::iterator
+counted_multiset<Key, Compare, Allocator>::begin() const {
+  return iterator(runs_.begin(), 0U);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename counted_multiset<Key, Compare, Allocator>::iterator
+counted_multiset<Key, Compare, Allocator>::end() const {
+  return iterator(runs_.end(), 0U);
+}
+
+}  // namespace s21
+
+#endif  // S21_COUNTED_MULTISET_H
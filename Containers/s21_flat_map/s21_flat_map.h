@@ -0,0 +1,647 @@
+#ifndef S21_FLAT_MAP_H
+#define S21_FLAT_MAP_H
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../AVLtree/AVLtree.h"
+
+namespace s21 {
+
+/*
+FlatMapIterator
+Random access iterator over the parallel key and value arrays of flat_map.
+It yields pair<const Key&, T&> proxies since no pair is stored anywhere.
+Values are reached through the iterators of their container, so T = bool
+gets the proxy references of std::vector<bool> instead of bool&.
+*/
+
+template <typename Key, typename Mapped, bool Const>
+class FlatMapIterator {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::pair<Key, typename Mapped::value_type>;
+  using difference_type = std::ptrdiff_t;
+  using mapped_iterator =
+      std::conditional_t<Const, typename Mapped::const_iterator,
+                         typename Mapped::iterator>;
+  using reference = std::pair<
+      const Key&, std::conditional_t<Const, typename Mapped::const_reference,
+                                     typename Mapped::reference>>;
+  struct pointer {
+    reference ref;
+    const reference* operator->() const { return &ref; }
+  };
+
+  FlatMapIterator() = default;
+  FlatMapIterator(const Key* key, mapped_iterator value)
+      : key_(key), value_(value) {}
+  // iterator converts to const_iterator
+  template <bool C = Const, typename = std::enable_if_t<C>>
+  FlatMapIterator(const FlatMapIterator<Key, Mapped, false>& other)
+      : key_(other.key_), value_(other.value_) {}
+
+  reference operator*() const { return {*key_, *value_}; }
+  pointer operator->() const { return pointer{**this}; }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  FlatMapIterator& operator++() {
+    ++key_;
+    ++value_;
+    return *this;
+  }
+  FlatMapIterator& operator--() {
+    --key_;
+    --value_;
+    return *this;
+  }
+  FlatMapIterator operator++(int) {
+    FlatMapIterator result = *this;
+    ++*this;
+    return result;
+  }
+  FlatMapIterator operator--(int) {
+    FlatMapIterator result = *this;
+    --*this;
+    return result;
+  }
+  FlatMapIterator& operator+=(difference_type n) {
+    key_ += n;
+    value_ += n;
+    return *this;
+  }
+  FlatMapIterator& operator-=(difference_type n) { return *this += -n; }
+  FlatMapIterator operator+(difference_type n) const {
+    FlatMapIterator result = *this;
+    return result += n;
+  }
+  FlatMapIterator operator-(difference_type n) const {
+    FlatMapIterator result = *this;
+    return result -= n;
+  }
+  difference_type operator-(const FlatMapIterator& other) const {
+    return key_ - other.key_;
+  }
+
+  bool operator==(const FlatMapIterator& other) const {
+    return key_ == other.key_;
+  }
+  bool operator!=(const FlatMapIterator& other) const {
+    return key_ != other.key_;
+  }
+  bool operator<(const FlatMapIterator& other) const {
+    return key_ < other.key_;
+  }
+  bool operator>(const FlatMapIterator& other) const {
+    return key_ > other.key_;
+  }
+  bool operator<=(const FlatMapIterator& other) const {
+    return key_ <= other.key_;
+  }
+  bool operator>=(const FlatMapIterator& other) const {
+    return key_ >= other.key_;
+  }
+
+  const Key* getKey() const { return key_; }
+
+ private:
+  friend class FlatMapIterator<Key, Mapped, true>;
+
+  const Key* key_ = nullptr;
+  mapped_iterator value_{};
+};
+
+/*
+flat_map
+Keys and mapped values in two sorted parallel arrays, so a lookup binary
+searches a dense array of keys only and never touches the values. Built for
+tables that are filled once and read many times: a single insert or erase
+costs O(n), while insert(first, last) appends the batch, sorts it alone and
+merges it with the old entries in one pass. Any change invalidates
+iterators.
+*/
+
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class flat_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using key_container = std::vector<
+      Key, typename std::allocator_traits<Allocator>::template rebind_alloc<
+               Key>>;
+  using mapped_container = std::vector<
+      T,
+      typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+  using iterator = FlatMapIterator<Key, mapped_container, false>;
+  using const_iterator = FlatMapIterator<Key, mapped_container, true>;
+  using mapped_reference = typename mapped_container::reference;
+  using const_mapped_reference = typename mapped_container::const_reference;
+  using reference = typename iterator::reference;
+  using const_reference = typename const_iterator::reference;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+
+  // Constructors
+  flat_map() = default;
+  explicit flat_map(const Allocator &alloc)
+      : keys_(alloc), values_(alloc) {}
+  flat_map(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  flat_map(InputIt first, InputIt last);
+  template <typename InputIt>
+  flat_map(sorted_unique_t, InputIt first, InputIt last);
+  // Takes over parallel arrays; equal keys keep the first value
+  flat_map(key_container keys, mapped_container values);
+  flat_map(sorted_unique_t, key_container keys, mapped_container values);
+
+  mapped_reference operator[](const key_type &key);
+  mapped_reference at(const key_type &key);
+  const_mapped_reference at(const key_type &key) const;
+
+  allocator_type get_allocator() const;
+
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+  size_type max_size() const;
+  void reserve(size_type count);
+  void shrink_to_fit();
+
+  // Modifiers
+  void clear();
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  std::pair<iterator, bool> insert(const key_type &key, const mapped_type &obj);
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last);
+  void insert(std::initializer_list<value_type> const &items);
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             const mapped_type &obj);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const key_type &key);
+  void swap(flat_map &other);
+  void merge(flat_map &other);
+
+  // Lookup
+  iterator find(const key_type &key);
+  const_iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+  iterator lower_bound(const key_type &key);
+  const_iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key);
+  const_iterator upper_bound(const key_type &key) const;
+
+  // Iterators
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  // The underlying sorted arrays
+  const key_container &keys() const;
+  const mapped_container &values() const;
+
+ private:
+  iterator at_index(size_type index);
+  const_iterator at_index(size_type index) const;
+  size_type lowerIndex(const key_type &key) const;
+  template <typename... Args>
+  std::pair<iterator, bool> insertAt(size_type index, const key_type &key,
+                                     Args &&...args);
+  void mergeTail(size_type old);
+
+  key_container keys_;
+  mapped_container values_;
+  Compare comp_;
+};
+
+// Implementation of methods
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+flat_map<Key, T, Compare, Allocator>::flat_map(
+    std::initializer_list<value_type> const &items) {
+  insert(items.begin(), items.end());
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename InputIt>
+flat_map<Key, T, Compare, Allocator>::flat_map(InputIt first, InputIt last) {
+  insert(first, last);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename InputIt>
+flat_map<Key, T, Compare, Allocator>::flat_map(sorted_unique_t, InputIt first,
+                                               InputIt last) {
+  for (; first != last; ++first) {
+    keys_.push_back(first->first);
+    values_.push_back(first->second);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+flat_map<Key, T, Compare, Allocator>::flat_map(key_container keys,
+                                               mapped_container values)
+    : keys_(std::move(keys)), values_(std::move(values)) {
+  if (keys_.size() != values_.size()) {
+    throw std::invalid_argument("flat_map: keys and values differ in size");
+  }
+  mergeTail(0U);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+flat_map<Key, T, Compare, Allocator>::flat_map(sorted_unique_t,
+                                               key_container keys,
+                                               mapped_container values)
+    : keys_(std::move(keys)), values_(std::move(values)) {
+  if (keys_.size() != values_.size()) {
+    throw std::invalid_argument("flat_map: keys and values differ in size");
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::mapped_reference
+flat_map<Key, T, Compare, Allocator>::operator[](const key_type &key) {
+  return (*try_emplace(key).first).second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::mapped_reference
+flat_map<Key, T, Compare, Allocator>::at(const key_type &key) {
+  size_type index = lowerIndex(key);
+  if (index == size() || comp_(key, keys_[index])) {
+    throw std::out_of_range("flat_map key is not found");
+  }
+  return values_[index];
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::const_mapped_reference
+flat_map<Key, T, Compare, Allocator>::at(const key_type &key) const {
+  size_type index = lowerIndex(key);
+  if (index == size() || comp_(key, keys_[index])) {
+    throw std::out_of_range("flat_map key is not found");
+  }
+  return values_[index];
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::allocator_type
+flat_map<Key, T, Compare, Allocator>::get_allocator() const {
+  return allocator_type(keys_.get_allocator());
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool flat_map<Key, T, Compare, Allocator>::empty() const {
+  return keys_.empty();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::size_type
+flat_map<Key, T, Compare, Allocator>::size() const {
+  return keys_.size();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::size_type
+flat_map<Key, T, Compare, Allocator>::max_size() const {
+  return std::min(keys_.max_size(), values_.max_size());
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void flat_map<Key, T, Compare, Allocator>::reserve(size_type count) {
+  keys_.reserve(count);
+  values_.reserve(count);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void flat_map<Key, T, Compare, Allocator>::shrink_to_fit() {
+  keys_.shrink_to_fit();
+  values_.shrink_to_fit();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void flat_map<Key, T, Compare, Allocator>::clear() {
+  keys_.clear();
+  values_.clear();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename flat_map<Key, T, Compare, Allocator>::iterator, bool>
+flat_map<Key, T, Compare, Allocator>::insert(const value_type &value) {
+  return try_emplace(value.first, value.second);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename flat_map<Key, T, Compare, Allocator>::iterator, bool>
+flat_map<Key, T, Compare, Allocator>::insert(value_type &&value) {
+  return try_emplace(value.first, std::move(value.second));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename flat_map<Key, T, Compare, Allocator>::iterator, bool>
+flat_map<Key, T, Compare, Allocator>::insert(const key_type &key,
+                                             const mapped_type &obj) {
+  return try_emplace(key, obj);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename InputIt>
+void flat_map<Key, T, Compare, Allocator>::insert(InputIt first,
+                                                  InputIt last) {
+  size_type old = size();
+  try {
+    for (; first != last; ++first) {
+      keys_.push_back((*first).first);
+      values_.push_back((*first).second);
+    }
+  } catch (...) {
+    keys_.resize(old);
+    values_.resize(old);
+    throw;
+  }
+  mergeTail(old);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void flat_map<Key, T, Compare, Allocator>::insert(
+    std::initializer_list<value_type> const &items) {
+  insert(items.begin(), items.end());
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename flat_map<Key, T, Compare, Allocator>::iterator, bool>
+flat_map<Key, T, Compare, Allocator>::insert_or_assign(
+    const key_type &key, const mapped_type &obj) {
+  auto result = try_emplace(key, obj);
+  if (!result.second) (*result.first).second = obj;
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename flat_map<Key, T, Compare, Allocator>::iterator, bool>
+flat_map<Key, T, Compare, Allocator>::emplace(Args &&...args) {
+  return insert(value_type(std::forward<Args>(args)...));
+}
+
+// Builds the value only when key is missing
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename flat_map<Key, T, Compare, Allocator>::iterator, bool>
+flat_map<Key, T, Compare, Allocator>::try_emplace(const key_type &key,
+                                                  Args &&...args) {
+  size_type index = lowerIndex(key);
+  if (index != size() && !comp_(key, keys_[index])) {
+    return {at_index(index), false};
+  }
+  return insertAt(index, key, std::forward<Args>(args)...);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::iterator
+flat_map<Key, T, Compare, Allocator>::erase(const_iterator pos) {
+  return erase(pos, std::next(pos));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::iterator
+flat_map<Key, T, Compare, Allocator>::erase(const_iterator first,
+                                            const_iterator last) {
+  auto from = first.getKey() - keys_.data();
+  auto to = last.getKey() - keys_.data();
+  keys_.erase(keys_.begin() + from, keys_.begin() + to);
+  values_.erase(values_.begin() + from, values_.begin() + to);
+  return at_index(static_cast<size_type>(from));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::size_type
+flat_map<Key, T, Compare, Allocator>::erase(const key_type &key) {
+  iterator it = find(key);
+  if (it == end()) return 0U;
+  erase(it);
+  return 1U;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void flat_map<Key, T, Compare, Allocator>::swap(flat_map &other) {
+  keys_.swap(other.keys_);
+  values_.swap(other.values_);
+  std::swap(comp_, other.comp_);
+}
+
+// Keys already present here stay in other
+template <typename Key, typename T, typename Compare, typename Allocator>
+void flat_map<Key, T, Compare, Allocator>::merge(flat_map &other) {
+  if (this == &other) return;
+  flat_map rest(other.get_allocator());
+  size_type old = size();
+  for (size_type i = 0U; i < other.size(); ++i) {
+    if (contains(other.keys_[i])) {
+      rest.keys_.push_back(std::move(other.keys_[i]));
+      rest.values_.push_back(std::move(other.values_[i]));
+    } else {
+      keys_.push_back(std::move(other.keys_[i]));
+      values_.push_back(std::move(other.values_[i]));
+    }
+  }
+  mergeTail(old);
+  other.keys_.swap(rest.keys_);
+  other.values_.swap(rest.values_);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::iterator
+flat_map<Key, T, Compare, Allocator>::find(const key_type &key) {
+  size_type index = lowerIndex(key);
+  if (index != size() && comp_(key, keys_[index])) index = size();
+  return at_index(index);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::const_iterator
+flat_map<Key, T, Compare, Allocator>::find(const key_type &key) const {
+  return const_cast<flat_map &>(*this).find(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool flat_map<Key, T, Compare, Allocator>::contains(
+    const key_type &key) const {
+  return find(key) != end();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::size_type
+flat_map<Key, T, Compare, Allocator>::count(const key_type &key) const {
+  return contains(key) ? 1U : 0U;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::iterator
+flat_map<Key, T, Compare, Allocator>::lower_bound(const key_type &key) {
+  return at_index(lowerIndex(key));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::const_iterator
+flat_map<Key, T, Compare, Allocator>::lower_bound(
+    const key_type &key) const {
+  return at_index(lowerIndex(key));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::iterator
+flat_map<Key, T, Compare, Allocator>::upper_bound(const key_type &key) {
+  auto it = std::upper_bound(keys_.begin(), keys_.end(), key, comp_);
+  return at_index(static_cast<size_type>(it - keys_.begin()));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::const_iterator
+flat_map<Key, T, Compare, Allocator>::upper_bound(
+    const key_type &key) const {
+  return const_cast<flat_map &>(*this).upper_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::iterator
+flat_map<Key, T, Compare, Allocator>::begin() {
+  return at_index(0U);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::iterator
+flat_map<Key, T, Compare, Allocator>::end() {
+  return at_index(size());
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::const_iterator
+flat_map<Key, T, Compare, Allocator>::begin() const {
+  return at_index(0U);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::const_iterator
+flat_map<Key, T, Compare, Allocator>::end() const {
+  return at_index(size());
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+const typename flat_map<Key, T, Compare, Allocator>::key_container &
+flat_map<Key, T, Compare, Allocator>::keys() const {
+  return keys_;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+const typename flat_map<Key, T, Compare, Allocator>::mapped_container &
+flat_map<Key, T, Compare, Allocator>::values() const {
+  return values_;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::iterator
+flat_map<Key, T, Compare, Allocator>::at_index(size_type index) {
+  auto offset = static_cast<difference_type>(index);
+  return iterator(keys_.data() + index, values_.begin() + offset);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::const_iterator
+flat_map<Key, T, Compare, Allocator>::at_index(size_type index) const {
+  auto offset = static_cast<difference_type>(index);
+  return const_iterator(keys_.data() + index, values_.begin() + offset);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename flat_map<Key, T, Compare, Allocator>::size_type
+flat_map<Key, T, Compare, Allocator>::lowerIndex(const key_type &key) const {
+  auto it = std::lower_bound(keys_.begin(), keys_.end(), key, comp_);
+  return static_cast<size_type>(it - keys_.begin());
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename flat_map<Key, T, Compare, Allocator>::iterator, bool>
+flat_map<Key, T, Compare, Allocator>::insertAt(size_type index,
+                                               const key_type &key,
+                                               Args &&...args) {
+  auto offset = static_cast<difference_type>(index);
+  values_.emplace(values_.begin() + offset, std::forward<Args>(args)...);
+  try {
+    keys_.insert(keys_.begin() + offset, key);
+  } catch (...) {
+    values_.erase(values_.begin() + offset);
+    throw;
+  }
+  return {at_index(index), true};
+}
+
+/*
+mergeTail
+Restores order after entries were appended from index old on. The tail is
+sorted through an index permutation, so keys and values move together, and
+then merged with the sorted head into fresh arrays in one pass. Old entries
+win over new ones with an equal key, earlier new ones over later ones. A
+tail that already continues the order costs one scan. If anything throws,
+the map is left empty.
+*/
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void flat_map<Key, T, Compare, Allocator>::mergeTail(size_type old) {
+  size_type total = size();
+  size_type i = old ? old : 1U;
+  while (i < total && comp_(keys_[i - 1U], keys_[i])) ++i;
+  if (i >= total) return;
+  try {
+    std::vector<size_type> order(total - old);
+    std::iota(order.begin(), order.end(), old);
+    std::stable_sort(order.begin(), order.end(),
+                     [this](size_type lhs, size_type rhs) {
+                       return comp_(keys_[lhs], keys_[rhs]);
+                     });
+    key_container keys(keys_.get_allocator());
+    mapped_container values(values_.get_allocator());
+    keys.reserve(total);
+    values.reserve(total);
+    auto take = [&](size_type index) {
+      if (!keys.empty() && !comp_(keys.back(), keys_[index])) return;
+      keys.push_back(std::move(keys_[index]));
+      values.push_back(std::move(values_[index]));
+    };
+    size_type head = 0U;
+    auto tail = order.begin();
+    while (head < old && tail != order.end()) {
+      take(comp_(keys_[*tail], keys_[head]) ? *tail++ : head++);
+    }
+    while (head < old) take(head++);
+    while (tail != order.end()) take(*tail++);
+    keys_.swap(keys);
+    values_.swap(values);
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+
+}  // namespace s21
+
+#endif  // S21_FLAT_MAP_H
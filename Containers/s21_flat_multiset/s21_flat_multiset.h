@@ -0,0 +1,106 @@
+#ifndef S21_FLAT_MULTISET_H
+#define S21_FLAT_MULTISET_H
+
+#include <utility>
+
+#include "../s21_flat_set/s21_flat_set.h"
+
+namespace s21 {
+
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class flat_multiset : public flat_set<Key, Compare, Allocator> {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using container_type =
+      typename flat_set<Key, Compare, Allocator>::container_type;
+  using iterator = typename container_type::const_iterator;
+  using const_iterator = typename container_type::const_iterator;
+  using size_type = size_t;
+
+  flat_multiset() = default;
+  explicit flat_multiset(const Allocator& alloc)
+      : flat_set<Key, Compare, Allocator>(alloc) {}
+  flat_multiset(std::initializer_list<value_type> const& items);
+  template <typename InputIt>
+  flat_multiset(InputIt first, InputIt last);
+  // Takes over keys that are already sorted
+  flat_multiset(sorted_equivalent_t, container_type keys);
+
+  iterator insert(const value_type& value);
+  iterator insert(value_type&& value);
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last);
+  void insert(std::initializer_list<value_type> const& items);
+  template <typename... Args>
+  iterator emplace(Args&&... args);
+  void merge(flat_multiset& other);
+};
+
+template <typename Key, typename Compare, typename Allocator>
+flat_multiset<Key, Compare, Allocator>::flat_multiset(
+    std::initializer_list<value_type> const& items) {
+  this->insertBatch(items.begin(), items.end(), false);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+flat_multiset<Key, Compare, Allocator>::flat_multiset(InputIt first,
+                                                      InputIt last) {
+  this->insertBatch(first, last, false);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+flat_multiset<Key, Compare, Allocator>::flat_multiset(sorted_equivalent_t,
+                                                      container_type keys)
+    : flat_set<Key, Compare, Allocator>(sorted_unique, std::move(keys)) {}
+
+template <typename Key, typename Compare, typename Allocator>
+typename flat_multiset<Key, Compare, Allocator>::iterator
+flat_multiset<Key, Compare, Allocator>::insert(const value_type& value) {
+  return this->insertOne(value, false).first;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename flat_multiset<Key, Compare, Allocator>::iterator
+flat_multiset<Key, Compare, Allocator>::insert(value_type&& value) {
+  return this->insertOne(std::move(value), false).first;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+void flat_multiset<Key, Compare, Allocator>::insert(InputIt first,
+                                                    InputIt last) {
+  this->insertBatch(first, last, false);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void flat_multiset<Key, Compare, Allocator>::insert(
+    std::initializer_list<value_type> const& items) {
+  this->insertBatch(items.begin(), items.end(), false);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename flat_multiset<Key, Compare, Allocator>::iterator
+flat_multiset<Key, Compare, Allocator>::emplace(Args&&... args) {
+  return this->insertOne(value_type(std::forward<Args>(args)...), false)
+      .first;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void flat_multiset<Key, Compare, Allocator>::merge(flat_multiset& other) {
+  if (this == &other) return;
+  this->insertBatch(std::make_move_iterator(other.keys_.begin()),
+                    std::make_move_iterator(other.keys_.end()), false);
+  other.clear();
+}
+
+}  // namespace s21
+
+#endif  // S21_FLAT_MULTISET_H
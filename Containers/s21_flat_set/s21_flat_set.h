@@ -0,0 +1,339 @@
+#ifndef S21_FLAT_SET_H
+#define S21_FLAT_SET_H
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include "../AVLtree/AVLtree.h"
+
+namespace s21 {
+
+/*
+flat_set
+Sorted keys in one contiguous array. Lookups are binary searches over dense
+memory, which beats chasing tree nodes for tables that are built once and
+read many times. A single insert or erase shifts the tail and costs O(n);
+batches go through insert(first, last), which appends, sorts only the new
+keys and merges the two runs in one pass. Any change invalidates iterators.
+*/
+
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class flat_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using container_type = std::vector<Key, Allocator>;
+  using iterator = typename container_type::const_iterator;
+  using const_iterator = typename container_type::const_iterator;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+
+  // Constructors
+  flat_set() = default;
+  explicit flat_set(const Allocator& alloc) : keys_(alloc) {}
+  flat_set(std::initializer_list<value_type> const& items);
+  template <typename InputIt>
+  flat_set(InputIt first, InputIt last);
+  // Takes over keys that are already sorted and unique
+  flat_set(sorted_unique_t, container_type keys);
+  template <typename InputIt>
+  flat_set(sorted_unique_t, InputIt first, InputIt last);
+
+  allocator_type get_allocator() const;
+
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+  size_type max_size() const;
+  void reserve(size_type count);
+  void shrink_to_fit();
+
+  // Modifiers
+  void clear();
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last);
+  void insert(std::initializer_list<value_type> const& items);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const value_type& key);
+  void swap(flat_set& other);
+  void merge(flat_set& other);
+  // Hands the sorted array over; the set is left empty
+  container_type extract();
+
+  // Lookup
+  iterator find(const value_type& key) const;
+  bool contains(const value_type& key) const;
+  size_type count(const value_type& key) const;
+  iterator lower_bound(const value_type& key) const;
+  iterator upper_bound(const value_type& key) const;
+  std::pair<iterator, iterator> equal_range(const value_type& key) const;
+
+  // Iterators
+  iterator begin() const;
+  iterator end() const;
+
+ protected:
+  template <typename V>
+  std::pair<iterator, bool> insertOne(V&& value, bool unique);
+  template <typename InputIt>
+  void insertBatch(InputIt first, InputIt last, bool unique);
+
+  container_type keys_;
+  Compare comp_;
+};
+
+// Implementation of methods
+
+template <typename Key, typename Compare, typename Allocator>
+flat_set<Key, Compare, Allocator>::flat_set(
+    std::initializer_list<value_type> const& items) {
+  insertBatch(items.begin(), items.end(), true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+flat_set<Key, Compare, Allocator>::flat_set(InputIt first, InputIt last) {
+  insertBatch(first, last, true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+flat_set<Key, Compare, Allocator>::flat_set(sorted_unique_t,
+                                            container_type keys)
+    : keys_(std::move(keys)) {}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+flat_set<Key, Compare, Allocator>::flat_set(sorted_unique_t, InputIt first,
+                                            InputIt last)
+    : keys_(first, last) {}
+
+template <typename Key, typename Compare, typename Allocator>
+typename flat_set<Key, Compare, Allocator>::allocator_type
+flat_set<Key, Compare, Allocator>::get_allocator() const {
+  return keys_.get_allocator();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+bool flat_set<Key, Compare, Allocator>::empty() const {
+  return keys_.empty();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename flat_set<Key, Compare, Allocator>::size_type
+flat_set<Key, Compare, Allocator>::size() const {
+  return keys_.size();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename flat_set<Key, Compare, Allocator>::size_type
+flat_set<Key, Compare, Allocator>::max_size() const {
+  return keys_.max_size();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void flat_set<Key, Compare, Allocator>::reserve(size_type count) {
+  keys_.reserve(count);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void flat_set<Key, Compare, Allocator>::shrink_to_fit() {
+  keys_.shrink_to_fit();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void flat_set<Key, Compare, Allocator>::clear() {
+  keys_.clear();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename flat_set<Key, Compare, Allocator>::iterator, bool>
+flat_set<Key, Compare, Allocator>::insert(const value_type& value) {
+  return insertOne(value, true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename flat_set<Key, Compare, Allocator>::iterator, bool>
+flat_set<Key, Compare, Allocator>::insert(value_type&& value) {
+  return insertOne(std::move(value), true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+void flat_set<Key, Compare, Allocator>::insert(InputIt first, InputIt last) {
+  insertBatch(first, last, true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void flat_set<Key, Compare, Allocator>::insert(
+    std::initializer_list<value_type> const& items) {
+  insertBatch(items.begin(), items.end(), true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename flat_set<Key, Compare, Allocator>::iterator, bool>
+flat_set<Key, Compare, Allocator>::emplace(Args&&... args) {
+  return insertOne(value_type(std::forward<Args>(args)...), true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename flat_set<Key, Compare, Allocator>::iterator
+flat_set<Key, Compare, Allocator>::erase(const_iterator pos) {
+  return keys_.erase(pos);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename flat_set<Key, Compare, Allocator>::iterator
+flat_set<Key, Compare, Allocator>::erase(const_iterator first,
+                                         const_iterator last) {
+  return keys_.erase(first, last);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename flat_set<Key, Compare, Allocator>::size_type
+flat_set<Key, Compare, Allocator>::erase(const value_type& key) {
+  auto range = equal_range(key);
+  size_type count = static_cast<size_type>(range.second - range.first);
+  keys_.erase(range.first, range.second);
+  return count;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void flat_set<Key, Compare, Allocator>::swap(flat_set& other) {
+  keys_.swap(other.keys_);
+  std::swap(comp_, other.comp_);
+}
+
+// Keys already present here stay in other
+template <typename Key, typename Compare, typename Allocator>
+void flat_set<Key, Compare, Allocator>::merge(flat_set& other) {
+  if (this == &other) return;
+  container_type rest(other.get_allocator());
+  for (const value_type& key : other.keys_) {
+    if (contains(key)) rest.push_back(key);
+  }
+  insertBatch(std::make_move_iterator(other.keys_.begin()),
+              std::make_move_iterator(other.keys_.end()), true);
+  other.keys_.swap(rest);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename flat_set<Key, Compare, Allocator>::container_type
+flat_set<Key, Compare, Allocator>::extract() {
+  container_type keys(std::move(keys_));
+  keys_.clear();
+  return keys;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename flat_set<Key, Compare, Allocator>::iterator
+flat_set<Key, Compare, Allocator>::find(const value_type& key) const {
+  iterator it = lower_bound(key);
+  return it != end() && !comp_(key, *it) ? it : end();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+bool flat_set<Key, Compare, Allocator>::contains(
+    const value_type& key) const {
+  return find(key) != end();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename flat_set<Key, Compare, Allocator>::size_type
+flat_set<Key, Compare, Allocator>::count(const value_type& key) const {
+  auto range = equal_range(key);
+  return static_cast<size_type>(range.second - range.first);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename flat_set<Key, Compare, Allocator>::iterator
+flat_set<Key, Compare, Allocator>::lower_bound(const value_type& key) const {
+  return std::lower_bound(keys_.begin(), keys_.end(), key, comp_);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename flat_set<Key, Compare, Allocator>::iterator
+flat_set<Key, Compare, Allocator>::upper_bound(const value_type& key) const {
+  return std::upper_bound(keys_.begin(), keys_.end(), key, comp_);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename flat_set<Key, Compare, Allocator>::iterator,
+          typename flat_set<Key, Compare, Allocator>::iterator>
+flat_set<Key, Compare, Allocator>::equal_range(const value_type& key) const {
+  return std::equal_range(keys_.begin(), keys_.end(), key, comp_);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename flat_set<Key, Compare, Allocator>::iterator
+flat_set<Key, Compare, Allocator>::begin() const {
+  return keys_.begin();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename flat_set<Key, Compare, Allocator>::iterator
+flat_set<Key, Compare, Allocator>::end() const {
+  return keys_.end();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename V>
+std::pair<typename flat_set<Key, Compare, Allocator>::iterator, bool>
+flat_set<Key, Compare, Allocator>::insertOne(V&& value, bool unique) {
+  iterator pos = unique ? lower_bound(value) : upper_bound(value);
+  if (unique && pos != end() && !comp_(value, *pos)) return {pos, false};
+  return {keys_.insert(pos, std::forward<V>(value)), true};
+}
+
+/*
+insertBatch
+Appends the batch, sorts just the appended part and merges it with the old
+keys in place, so k new keys cost O(k log k + n) instead of k shifts. Both
+steps are stable: equal keys keep their insertion order and, when unique,
+the key that was there first wins. If a comparison throws the set is left
+empty.
+*/
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+void flat_set<Key, Compare, Allocator>::insertBatch(InputIt first,
+                                                    InputIt last,
+                                                    bool unique) {
+  size_type old = keys_.size();
+  keys_.insert(keys_.end(), first, last);
+  auto middle = keys_.begin() + static_cast<difference_type>(old);
+  try {
+    std::stable_sort(middle, keys_.end(), comp_);
+    if (middle != keys_.begin() && middle != keys_.end() &&
+        comp_(*middle, *std::prev(middle))) {
+      std::inplace_merge(keys_.begin(), middle, keys_.end(), comp_);
+    }
+    if (unique) {
+      auto equal = [this](const Key& lhs, const Key& rhs) {
+        return !comp_(lhs, rhs);
+      };
+      keys_.erase(std::unique(keys_.begin(), keys_.end(), equal),
+                  keys_.end());
+    }
+  } catch (...) {
+    keys_.clear();
+    throw;
+  }
+}
+
+}  // namespace s21
+
+#endif  // S21_FLAT_SET_H
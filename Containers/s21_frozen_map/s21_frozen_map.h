@@ -0,0 +1,267 @@
+#ifndef S21_FROZEN_MAP_H
+#define S21_FROZEN_MAP_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../AVLtree/Eytzinger.h"
+#include "../s21_map/s21_map.h"
+
+namespace s21 {
+
+/*
+FrozenMapIterator
+In-order iterator over the parallel Eytzinger arrays of frozen_map. It
+yields pair<const Key&, const T&> proxies since no pair is stored anywhere.
+*/
+
+template <typename Key, typename T>
+class FrozenMapIterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = std::pair<Key, T>;
+  using difference_type = std::ptrdiff_t;
+  using reference = std::pair<const Key &, const T &>;
+  struct pointer {
+    reference ref;
+    const reference *operator->() const { return &ref; }
+  };
+  using size_type = std::size_t;
+
+  FrozenMapIterator() = default;
+  FrozenMapIterator(const Key *keys, const T *values, size_type size,
+                    size_type position)
+      : keys_(keys), values_(values), size_(size), position_(position) {}
+
+  reference operator*() const { return {keys_[position_], values_[position_]}; }
+  pointer operator->() const { return pointer{**this}; }
+  FrozenMapIterator &operator++() {
+    position_ = Eytzinger::next(position_, size_);
+    return *this;
+  }
+  FrozenMapIterator &operator--() {
+    position_ = Eytzinger::prev(position_, size_);
+    return *this;
+  }
+  FrozenMapIterator operator++(int) {
+    FrozenMapIterator result = *this;
+    ++*this;
+    return result;
+  }
+  FrozenMapIterator operator--(int) {
+    FrozenMapIterator result = *this;
+    --*this;
+    return result;
+  }
+  bool operator==(const FrozenMapIterator &other) const {
+    return position_ == other.position_;
+  }
+  bool operator!=(const FrozenMapIterator &other) const {
+    return position_ != other.position_;
+  }
+
+  // Place in the Eytzinger arrays, 0 for end()
+  size_type position() const { return position_; }
+
+ private:
+  const Key *keys_ = nullptr;
+  const T *values_ = nullptr;
+  size_type size_ = 0U;
+  size_type position_ = 0U;
+};
+
+/*
+frozen_map
+Read-only snapshot of a map with keys and mapped values in two parallel
+arrays in Eytzinger order. A lookup runs the same branchless, prefetching
+descent as frozen_set over the keys alone and reads one value at the end.
+*/
+
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class frozen_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using key_container = std::vector<
+      Key, typename std::allocator_traits<Allocator>::template rebind_alloc<
+               Key>>;
+  using mapped_container = std::vector<
+      T,
+      typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+  using iterator = FrozenMapIterator<Key, T>;
+  using const_iterator = FrozenMapIterator<Key, T>;
+  using size_type = size_t;
+
+  // Constructors
+  frozen_map() = default;
+  template <typename MapAllocator>
+  explicit frozen_map(const map<Key, T, Compare, MapAllocator> &source);
+  template <typename InputIt>
+  frozen_map(InputIt first, InputIt last);
+  template <typename ForwardIt>
+  frozen_map(sorted_unique_t, ForwardIt first, ForwardIt last);
+
+  // Element access
+  const T &at(const Key &key) const;
+
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+
+  // Lookup
+  iterator find(const Key &key) const;
+  bool contains(const Key &key) const;
+  size_type count(const Key &key) const;
+  iterator lower_bound(const Key &key) const;
+  iterator upper_bound(const Key &key) const;
+
+  // Iterators
+  iterator begin() const;
+  iterator end() const;
+
+ private:
+  template <typename ForwardIt>
+  void build(ForwardIt first, ForwardIt last);
+  iterator makeIterator(size_type position) const;
+
+  // Position 0 of both arrays is padding so that the root sits at 1
+  key_container keys_;
+  mapped_container values_;
+  Compare comp_;
+};
+
+// Implementation of methods
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename MapAllocator>
+frozen_map<Key, T, Compare, Allocator>::frozen_map(
+    const map<Key, T, Compare, MapAllocator> &source) {
+  build(source.begin(), source.end());
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename InputIt>
+frozen_map<Key, T, Compare, Allocator>::frozen_map(InputIt first,
+                                                   InputIt last) {
+  std::vector<std::pair<Key, T>> sorted(first, last);
+  auto less = [this](const std::pair<Key, T> &lhs,
+                     const std::pair<Key, T> &rhs) {
+    return comp_(lhs.first, rhs.first);
+  };
+  // The first of equal keys wins, as in map::insert
+  std::stable_sort(sorted.begin(), sorted.end(), less);
+  auto equal = [&less](const std::pair<Key, T> &lhs,
+                       const std::pair<Key, T> &rhs) {
+    return !less(lhs, rhs);
+  };
+  sorted.erase(std::unique(sorted.begin(), sorted.end(), equal),
+               sorted.end());
+  build(sorted.begin(), sorted.end());
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename ForwardIt>
+frozen_map<Key, T, Compare, Allocator>::frozen_map(sorted_unique_t,
+                                                   ForwardIt first,
+                                                   ForwardIt last) {
+  build(first, last);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename ForwardIt>
+void frozen_map<Key, T, Compare, Allocator>::build(ForwardIt first,
+                                                   ForwardIt last) {
+  std::vector<ForwardIt> sorted;
+  for (; first != last; ++first) sorted.push_back(first);
+  if (sorted.empty()) return;
+  std::vector<size_type> ranks = Eytzinger::ranks(sorted.size());
+  keys_.reserve(sorted.size() + 1U);
+  values_.reserve(sorted.size() + 1U);
+  keys_.push_back(sorted.front()->first);
+  values_.push_back(sorted.front()->second);
+  for (size_type k = 1U; k <= sorted.size(); ++k) {
+    keys_.push_back(sorted[ranks[k]]->first);
+    values_.push_back(sorted[ranks[k]]->second);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename frozen_map<Key, T, Compare, Allocator>::iterator
+frozen_map<Key, T, Compare, Allocator>::makeIterator(
+    size_type position) const {
+  return iterator(keys_.data(), values_.data(), size(), position);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+const T &frozen_map<Key, T, Compare, Allocator>::at(const Key &key) const {
+  iterator it = find(key);
+  if (it == end()) throw std::out_of_range("Key not found");
+  return values_[it.position()];
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool frozen_map<Key, T, Compare, Allocator>::empty() const {
+  return keys_.empty();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename frozen_map<Key, T, Compare, Allocator>::size_type
+frozen_map<Key, T, Compare, Allocator>::size() const {
+  return keys_.empty() ? 0U : keys_.size() - 1U;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename frozen_map<Key, T, Compare, Allocator>::iterator
+frozen_map<Key, T, Compare, Allocator>::find(const Key &key) const {
+  size_type k = Eytzinger::search<false>(keys_.data(), size(), key, comp_);
+  return makeIterator(k && !comp_(key, keys_[k]) ? k : 0U);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool frozen_map<Key, T, Compare, Allocator>::contains(const Key &key) const {
+  return find(key) != end();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename frozen_map<Key, T, Compare, Allocator>::size_type
+frozen_map<Key, T, Compare, Allocator>::count(const Key &key) const {
+  return contains(key) ? 1U : 0U;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename frozen_map<Key, T, Compare, Allocator>::iterator
+frozen_map<Key, T, Compare, Allocator>::lower_bound(const Key &key) const {
+  return makeIterator(
+      Eytzinger::search<false>(keys_.data(), size(), key, comp_));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename frozen_map<Key, T, Compare, Allocator>::iterator
+frozen_map<Key, T, Compare, Allocator>::upper_bound(const Key &key) const {
+  return makeIterator(
+      Eytzinger::search<true>(keys_.data(), size(), key, comp_));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename frozen_map<Key, T, Compare, Allocator>::iterator
+frozen_map<Key, T, Compare, Allocator>::begin() const {
+  return makeIterator(Eytzinger::first(size()));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename frozen_map<Key, T, Compare, Allocator>::iterator
+frozen_map<Key, T, Compare, Allocator>::end() const {
+  return makeIterator(0U);
+}
+
+}  // namespace s21
+
+#endif  // S21_FROZEN_MAP_H
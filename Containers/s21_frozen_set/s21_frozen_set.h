@@ -0,0 +1,236 @@
+#ifndef S21_FROZEN_SET_H
+#define S21_FROZEN_SET_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "../AVLtree/Eytzinger.h"
+#include "../s21_set/s21_set.h"
+
+namespace s21 {
+
+// In-order iterator over the keys of an Eytzinger array
+template <typename Key>
+class FrozenIterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = Key;
+  using difference_type = std::ptrdiff_t;
+  using reference = const Key&;
+  using pointer = const Key*;
+  using size_type = std::size_t;
+
+  FrozenIterator() = default;
+  FrozenIterator(const Key* keys, size_type size, size_type position)
+      : keys_(keys), size_(size), position_(position) {}
+
+  reference operator*() const { return keys_[position_]; }
+  pointer operator->() const { return keys_ + position_; }
+  FrozenIterator& operator++() {
+    position_ = Eytzinger::next(position_, size_);
+    return *this;
+  }
+  FrozenIterator& operator--() {
+    position_ = Eytzinger::prev(position_, size_);
+    return *this;
+  }
+  FrozenIterator operator++(int) {
+    FrozenIterator result = *this;
+    ++*this;
+    return result;
+  }
+  FrozenIterator operator--(int) {
+    FrozenIterator result = *this;
+    --*this;
+    return result;
+  }
+  bool operator==(const FrozenIterator& other) const {
+    return position_ == other.position_;
+  }
+  bool operator!=(const FrozenIterator& other) const {
+    return position_ != other.position_;
+  }
+
+  // Place in the Eytzinger array, 0 for end()
+  size_type position() const { return position_; }
+
+ private:
+  const Key* keys_ = nullptr;
+  size_type size_ = 0U;
+  size_type position_ = 0U;
+};
+
+/*
+frozen_set
+Read-only snapshot of a set in Eytzinger order. Lookups walk one contiguous
+array without branches and prefetch the levels below, so large sets are
+searched several times faster than through the nodes of set. Iteration
+still visits the keys in order. Build it once from a set or a range; it
+cannot be changed afterwards.
+*/
+
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class frozen_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+  using iterator = FrozenIterator<Key>;
+  using const_iterator = FrozenIterator<Key>;
+  using size_type = size_t;
+
+  // Constructors
+  frozen_set() = default;
+  template <typename SetAllocator>
+  explicit frozen_set(const set<Key, Compare, SetAllocator>& source);
+  template <typename InputIt>
+  frozen_set(InputIt first, InputIt last);
+  template <typename ForwardIt>
+  frozen_set(sorted_unique_t, ForwardIt first, ForwardIt last);
+
+  allocator_type get_allocator() const;
+
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+
+  // Lookup
+  iterator find(const value_type& key) const;
+  bool contains(const value_type& key) const;
+  size_type count(const value_type& key) const;
+  iterator lower_bound(const value_type& key) const;
+  iterator upper_bound(const value_type& key) const;
+
+  // Iterators
+  iterator begin() const;
+  iterator end() const;
+
+ private:
+  template <typename ForwardIt>
+  void build(ForwardIt first, ForwardIt last);
+
+  // keys_[0] is padding so that the root sits at position 1
+  std::vector<Key, Allocator> keys_;
+  Compare comp_;
+};
+
+// Implementation of methods
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename SetAllocator>
+frozen_set<Key, Compare, Allocator>::frozen_set(
+    const set<Key, Compare, SetAllocator>& source) {
+  build(source.begin(), source.end());
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+frozen_set<Key, Compare, Allocator>::frozen_set(InputIt first,
+                                                InputIt last) {
+  std::vector<Key> sorted(first, last);
+  std::sort(sorted.begin(), sorted.end(), comp_);
+  auto equal = [this](const Key& lhs, const Key& rhs) {
+    return !comp_(lhs, rhs);
+  };
+  sorted.erase(std::unique(sorted.begin(), sorted.end(), equal),
+               sorted.end());
+  build(sorted.begin(), sorted.end());
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename ForwardIt>
+frozen_set<Key, Compare, Allocator>::frozen_set(sorted_unique_t,
+                                                ForwardIt first,
+                                                ForwardIt last) {
+  build(first, last);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename ForwardIt>
+void frozen_set<Key, Compare, Allocator>::build(ForwardIt first,
+                                                ForwardIt last) {
+  std::vector<ForwardIt> sorted;
+  for (; first != last; ++first) sorted.push_back(first);
+  if (sorted.empty()) return;
+  std::vector<size_type> ranks = Eytzinger::ranks(sorted.size());
+  keys_.reserve(sorted.size() + 1U);
+  keys_.push_back(*sorted.front());
+  for (size_type k = 1U; k <= sorted.size(); ++k) {
+    keys_.push_back(*sorted[ranks[k]]);
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename frozen_set<Key, Compare, Allocator>::allocator_type
+frozen_set<Key, Compare, Allocator>::get_allocator() const {
+  return keys_.get_allocator();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+bool frozen_set<Key, Compare, Allocator>::empty() const {
+  return keys_.empty();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename frozen_set<Key, Compare, Allocator>::size_type
+frozen_set<Key, Compare, Allocator>::size() const {
+  return keys_.empty() ? 0U : keys_.size() - 1U;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename frozen_set<Key, Compare, Allocator>::iterator
+frozen_set<Key, Compare, Allocator>::find(const value_type& key) const {
+  iterator it = lower_bound(key);
+  return it != end() && !comp_(key, *it) ? it : end();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+bool frozen_set<Key, Compare, Allocator>::contains(
+    const value_type& key) const {
+  return find(key) != end();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename frozen_set<Key, Compare, Allocator>::size_type
+frozen_set<Key, Compare, Allocator>::count(const value_type& key) const {
+  return contains(key) ? 1U : 0U;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename frozen_set<Key, Compare, Allocator>::iterator
+frozen_set<Key, Compare, Allocator>::lower_bound(
+    const value_type& key) const {
+  return iterator(keys_.data(), size(),
+                  Eytzinger::search<false>(keys_.data(), size(), key, comp_));
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename frozen_set<Key, Compare, Allocator>::iterator
+frozen_set<Key, Compare, Allocator>::upper_bound(
+    const value_type& key) const {
+  return iterator(keys_.data(), size(),
+                  Eytzinger::search<true>(keys_.data(), size(), key, comp_));
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename frozen_set<Key, Compare, Allocator>::iterator
+frozen_set<Key, Compare, Allocator>::begin() const {
+  return iterator(keys_.data(), size(), Eytzinger::first(size()));
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename frozen_set<Key, Compare, Allocator>::iterator
+frozen_set<Key, Compare, Allocator>::end() const {
+  return iterator(keys_.data(), size(), 0U);
+}
+
+}  // namespace s21
+
+#endif  // S21_FROZEN_SET_H
@@ -1,6 +1,7 @@
 #ifndef S21_map_H
 #define S21_map_H
 
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -8,23 +9,51 @@
 
 namespace s21 {
 
-template <typename T>
+template <typename T, typename Compare = std::less<typename T::first_type>>
 struct Comparatormap {
-  bool operator()(T val1, T val2) { return val1.first < val2.first; }
+  // The tree may always look up by key alone; other key-like types are
+  // accepted only when Compare itself is transparent.
+  using is_transparent = void;
+
+  Compare comp;
+  bool operator()(const T &val1, const T &val2) const {
+    return comp(val1.first, val2.first);
+  }
+  bool operator()(const typename T::first_type &key, const T &val) const {
+    return comp(key, val.first);
+  }
+  bool operator()(const T &val, const typename T::first_type &key) const {
+    return comp(val.first, key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool operator()(const K &key, const T &val) const {
+    return comp(key, val.first);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool operator()(const T &val, const K &key) const {
+    return comp(val.first, key);
+  }
 };
 
-template <typename Key, typename T>
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
 class map {
  public:
   using key_type = Key;
   using mapped_type = T;
   using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using avltree = Tree<value_type, Comparatormap<value_type>>;
+  using avltree =
+      Tree<value_type, Comparatormap<value_type, Compare>, Allocator>;
   using iterator = typename avltree::iterator;
   using const_iterator = typename avltree::const_iterator;
   using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
 
  private:
   avltree *tree_;
@@ -32,7 +61,12 @@ class map {
  public:
   // Constructors
   map() : tree_(new avltree) {}
+  explicit map(const Allocator &alloc) : tree_(new avltree(alloc)) {}
   map(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  map(InputIt first, InputIt last);
+  template <typename InputIt>
+  map(sorted_unique_t, InputIt first, InputIt last);
   map(const map &m);
   map(map &&m);
   ~map();
@@ -44,6 +78,8 @@ class map {
   mapped_type &operator[](const key_type &key);
   mapped_type &at(const key_type &key);
 
+  allocator_type get_allocator() const;
+
   // Capacity
   bool empty() const;
   size_type size() const;
@@ -53,17 +89,67 @@ class map {
   void clear();
 
   std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  iterator insert(const_iterator hint, const value_type &value);
+  iterator insert(const_iterator hint, value_type &&value);
   std::pair<iterator, bool> insert(const key_type &key, const mapped_type &obj);
 
   std::pair<iterator, bool> insert_or_assign(const key_type &key,
                                              const mapped_type &obj);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args);
+  template <typename... Args>
+  iterator try_emplace(const_iterator hint, const key_type &key,
+                       Args &&...args);
   void erase(iterator pos);
+  iterator erase(iterator first, iterator last);
+  map extract(const key_type &low, const key_type &high);
   void swap(map &other);
   void merge(map &other);
 
   // Lookup
+  iterator find(const key_type &key);
+  const_iterator find(const key_type &key) const;
+  iterator lower_bound(const key_type &key);
+  const_iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key);
+  const_iterator upper_bound(const key_type &key) const;
   bool contains(const key_type &key) const;
 
+  // Lookup by any key-like type when Compare is transparent
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K &key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K &key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator lower_bound(const K &key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K &key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator upper_bound(const K &key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) const;
+
+  // Order statistics, O(log n)
+  iterator select(size_type index);
+  size_type rank(const key_type &key) const;
+  difference_type distance(iterator first, iterator last);
+
   // Iterators
   iterator begin();
   iterator end();
@@ -77,144 +163,365 @@ class map {
 
 // Implementation of methods
 
-template <typename Key, typename T>
-map<Key, T>::map(std::initializer_list<value_type> const &items) : map() {
-  for (auto &item : items) {
-    insert(item);
-  }
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator>::map(
+    std::initializer_list<value_type> const &items)
+    : map() {
+  tree_->assign(items.begin(), items.end(), true);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename InputIt>
+map<Key, T, Compare, Allocator>::map(InputIt first, InputIt last) : map() {
+  tree_->assign(first, last, true);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename InputIt>
+map<Key, T, Compare, Allocator>::map(sorted_unique_t, InputIt first,
+                                     InputIt last)
+    : map() {
+  tree_->buildFromSorted(first, last);
 }
 
-template <typename Key, typename T>
-map<Key, T>::map(const map &m) : tree_(new avltree(*m.tree_)) {}
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator>::map(const map &m)
+    : tree_(new avltree(*m.tree_)) {}
 
-template <typename Key, typename T>
-map<Key, T>::map(map &&m) : tree_(new avltree(std::move(*m.tree_))) {}
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator>::map(map &&m)
+    : tree_(new avltree(std::move(*m.tree_))) {}
 
-template <typename Key, typename T>
-map<Key, T>::~map() {
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator>::~map() {
   delete tree_;
 }
 
-template <typename Key, typename T>
-map<Key, T> &map<Key, T>::operator=(map &&m) {
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator> &map<Key, T, Compare, Allocator>::operator=(
+    map &&m) {
   if (this != &m) {
     *tree_ = std::move(*m.tree_);
   }
   return *this;
 }
 
-template <typename Key, typename T>
-map<Key, T> &map<Key, T>::operator=(const map &m) {
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator> &map<Key, T, Compare, Allocator>::operator=(
+    const map &m) {
   if (this != &m) {
-    clear();
-    for (auto it = m.begin(); it != m.end(); ++it) {
-      insert(*it);
-    }
+    *tree_ = *m.tree_;
   }
   return *this;
 }
 
-template <typename Key, typename T>
-bool map<Key, T>::empty() const {
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::allocator_type
+map<Key, T, Compare, Allocator>::get_allocator() const {
+  return tree_->get_allocator();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool map<Key, T, Compare, Allocator>::empty() const {
   return tree_->empty();
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::size_type map<Key, T>::size() const {
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::size_type
+map<Key, T, Compare, Allocator>::size() const {
   return tree_->size();
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::size_type map<Key, T>::max_size() const {
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::size_type
+map<Key, T, Compare, Allocator>::max_size() const {
   return tree_->max_size();
 }
 
-template <typename Key, typename T>
-void map<Key, T>::clear() {
+template <typename Key, typename T, typename Compare, typename Allocator>
+void map<Key, T, Compare, Allocator>::clear() {
   tree_->clear();
 }
 
-template <typename Key, typename T>
-std::pair<typename map<Key, T>::iterator, bool> map<Key, T>::insert(
-    const value_type &value) {
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::insert(const value_type &value) {
   return tree_->insert(value);
 }
 
-template <typename Key, typename T>
-std::pair<typename map<Key, T>::iterator, bool> map<Key, T>::insert(
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::insert(value_type &&value) {
+  return tree_->insert(std::move(value));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::insert(
     const key_type &key, const mapped_type &obj) {
-  return tree_->insert(std::make_pair(key, obj));
+  return try_emplace(key, obj);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::emplace(Args &&...args) {
+  return tree_->emplace(std::forward<Args>(args)...);
 }
 
-template <typename Key, typename T>
-void map<Key, T>::erase(iterator pos) {
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                              Args &&...args) {
+  return tree_->emplaceHint(hint, true, std::forward<Args>(args)...).first;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::insert(const_iterator hint,
+                                        const value_type &value) {
+  return tree_->insertHint(hint, value, true).first;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::insert(const_iterator hint,
+                                        value_type &&value) {
+  return tree_->insertHint(hint, std::move(value), true).first;
+}
+
+/*
+try_emplace
+Builds the mapped value from args only if key is absent; args are left
+untouched otherwise
+*/
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::try_emplace(const key_type &key,
+                                             Args &&...args) {
+  return tree_->emplaceIfAbsent(
+      key, std::piecewise_construct, std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::try_emplace(key_type &&key, Args &&...args) {
+  return tree_->emplaceIfAbsent(
+      key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::try_emplace(const_iterator hint,
+                                             const key_type &key,
+                                             Args &&...args) {
+  return tree_
+      ->tryEmplaceHint(hint, key, std::piecewise_construct,
+                       std::forward_as_tuple(key),
+                       std::forward_as_tuple(std::forward<Args>(args)...))
+      .first;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void map<Key, T, Compare, Allocator>::erase(iterator pos) {
   tree_->erase(pos);
 }
 
-template <typename Key, typename T>
-void map<Key, T>::swap(map &other) {
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::erase(iterator first, iterator last) {
+  return tree_->erase(first, last);
+}
+
+// Moves the keys in [low, high) into a new map
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator> map<Key, T, Compare, Allocator>::extract(
+    const key_type &low, const key_type &high) {
+  map result(get_allocator());
+  *result.tree_ = tree_->extract(low, high);
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void map<Key, T, Compare, Allocator>::swap(map &other) {
   tree_->swap(*other.tree_);
 }
 
-template <typename Key, typename T>
-void map<Key, T>::merge(map &other) {
+template <typename Key, typename T, typename Compare, typename Allocator>
+void map<Key, T, Compare, Allocator>::merge(map &other) {
   tree_->merge(*other.tree_);
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::iterator map<Key, T>::begin() {
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::begin() {
   return tree_->begin();
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::iterator map<Key, T>::end() {
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::end() {
   return tree_->end();
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::const_iterator map<Key, T>::begin() const {
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::const_iterator
+map<Key, T, Compare, Allocator>::begin() const {
   return static_cast<const avltree &>(*tree_).begin();
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::const_iterator map<Key, T>::end() const {
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::const_iterator
+map<Key, T, Compare, Allocator>::end() const {
   return static_cast<const avltree &>(*tree_).end();
 }
 
-template <typename Key, typename T>
-bool map<Key, T>::contains(const key_type &key) const {
-  return tree_->contains(std::make_pair(key, mapped_type()));
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::find(const key_type &key) {
+  return tree_->find(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::const_iterator
+map<Key, T, Compare, Allocator>::find(const key_type &key) const {
+  return static_cast<const avltree &>(*tree_).find(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::lower_bound(const key_type &key) {
+  return tree_->lower_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::const_iterator
+map<Key, T, Compare, Allocator>::lower_bound(const key_type &key) const {
+  return static_cast<const avltree &>(*tree_).lower_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::upper_bound(const key_type &key) {
+  return tree_->upper_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::const_iterator
+map<Key, T, Compare, Allocator>::upper_bound(const key_type &key) const {
+  return static_cast<const avltree &>(*tree_).upper_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool map<Key, T, Compare, Allocator>::contains(const key_type &key) const {
+  return tree_->contains(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::find(const K &key) {
+  return tree_->find(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename map<Key, T, Compare, Allocator>::const_iterator
+map<Key, T, Compare, Allocator>::find(const K &key) const {
+  return static_cast<const avltree &>(*tree_).find(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::lower_bound(const K &key) {
+  return tree_->lower_bound(key);
 }
 
-template <typename Key, typename T>
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename map<Key, T, Compare, Allocator>::const_iterator
+map<Key, T, Compare, Allocator>::lower_bound(const K &key) const {
+  return static_cast<const avltree &>(*tree_).lower_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::upper_bound(const K &key) {
+  return tree_->upper_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename map<Key, T, Compare, Allocator>::const_iterator
+map<Key, T, Compare, Allocator>::upper_bound(const K &key) const {
+  return static_cast<const avltree &>(*tree_).upper_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+bool map<Key, T, Compare, Allocator>::contains(const K &key) const {
+  return tree_->contains(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::select(size_type index) {
+  return tree_->select(index);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::size_type
+map<Key, T, Compare, Allocator>::rank(const key_type &key) const {
+  return tree_->rank(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::difference_type
+map<Key, T, Compare, Allocator>::distance(iterator first, iterator last) {
+  return tree_->distance(first, last);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
 template <typename... Args>
-std::vector<std::pair<typename map<Key, T>::iterator, bool>>
-map<Key, T>::insert_many(Args &&...args) {
+std::vector<
+    std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>>
+map<Key, T, Compare, Allocator>::insert_many(Args &&...args) {
   std::vector<std::pair<iterator, bool>> results;
-  (results.push_back(this->insert(std::forward<Args>(args))), ...);
+  results.reserve(sizeof...(Args));
+  // Each element is hinted at the successor of the previous one, so sorted
+  // batches are appended without descending from the root
+  const_iterator hint = end();
+  [[maybe_unused]] auto insertNext = [this, &hint](value_type &&value) {
+    auto result = tree_->insertHint(hint, std::move(value), true);
+    hint = result.first;
+    ++hint;
+    return result;
+  };
+  (results.push_back(insertNext(value_type(std::forward<Args>(args)))), ...);
   return results;
 }
 
 // =---==-=-=-=-=-=-=-=-=-==-=-=-=
 
-template <typename Key, typename T>
-typename map<Key, T>::mapped_type &map<Key, T>::operator[](
-    const key_type &key) {
-  value_type temp_pair = std::make_pair(key, T{});
-  auto it = tree_->find(temp_pair);
-
-  if (it != tree_->end()) {
-    return (*it).second;
-  } else {
-    auto new_it = insert(key, T{});
-    return (*new_it.first).second;
-  }
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::mapped_type &
+map<Key, T, Compare, Allocator>::operator[](const key_type &key) {
+  return (*try_emplace(key).first).second;
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::mapped_type &map<Key, T>::at(const key_type &key) {
-  value_type temp_pair = std::make_pair(key, T{});
-  auto it = tree_->find(temp_pair);
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::mapped_type &
+map<Key, T, Compare, Allocator>::at(const key_type &key) {
+  auto it = tree_->find(key);
   if (it != tree_->end()) {
     return (*it).second;
   } else {
@@ -222,11 +529,11 @@ typename map<Key, T>::mapped_type &map<Key, T>::at(const key_type &key) {
   }
 }
 
-template <typename Key, typename T>
-std::pair<typename map<Key, T>::iterator, bool> map<Key, T>::insert_or_assign(
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::insert_or_assign(
     const key_type &key, const mapped_type &obj) {
-  value_type val = std::make_pair(key, obj);
-  std::pair<iterator, bool> res = tree_->insert(val);
+  std::pair<iterator, bool> res = try_emplace(key, obj);
   if (!res.second) {
     (*res.first).second = obj;
   }
@@ -7,19 +7,29 @@
 
 namespace s21 {
 
-template <typename Key>
-class multiset : public set<Key> {
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class multiset : public set<Key, Compare, Allocator> {
  public:
+  using key_type = Key;
   using value_type = Key;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using avltree = typename set<Key>::avltree;
+  using avltree = typename set<Key, Compare, Allocator>::avltree;
   using iterator = typename avltree::iterator;
   using const_iterator = typename avltree::const_iterator;
   using size_type = size_t;
 
-  multiset() : set<Key>() {}
+  multiset() : set<Key, Compare, Allocator>() {}
+  explicit multiset(const Allocator& alloc)
+      : set<Key, Compare, Allocator>(alloc) {}
   multiset(std::initializer_list<value_type> const& items);
+  template <typename InputIt>
+  multiset(InputIt first, InputIt last);
+  template <typename InputIt>
+  multiset(sorted_equivalent_t, InputIt first, InputIt last);
   multiset(const multiset& m);
   multiset(multiset&& m);
 
@@ -27,11 +37,28 @@ class multiset : public set<Key> {
   multiset& operator=(const multiset& m);
 
   std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+  iterator insert(const_iterator hint, const value_type& value);
+  iterator insert(const_iterator hint, value_type&& value);
+  template <typename... Args>
+  iterator emplace(Args&&... args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args);
   void merge(multiset& other);
+  multiset extract(const value_type& low, const value_type& high);
+  void unite(multiset& other);
+  void intersect(multiset& other);
+  void subtract(multiset& other);
   size_type count(const value_type& key);
-  iterator lower_bound(const value_type& key);
-  iterator upper_bound(const value_type& key);
+  using set<Key, Compare, Allocator>::lower_bound;
+  using set<Key, Compare, Allocator>::upper_bound;
   std::pair<iterator, iterator> equal_range(const value_type& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const K& key);
 
   template <class... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args&&... args);
@@ -39,88 +66,173 @@ class multiset : public set<Key> {
 
 // Implementation of methods
 
-template <typename Key>
-multiset<Key>::multiset(std::initializer_list<value_type> const& items)
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator>::multiset(
+    std::initializer_list<value_type> const& items)
     : multiset() {
-  for (auto& item : items) {
-    insert(item);
-  }
+  this->tree_->assign(items.begin(), items.end(), false);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+multiset<Key, Compare, Allocator>::multiset(InputIt first, InputIt last)
+    : multiset() {
+  this->tree_->assign(first, last, false);
 }
 
-template <typename Key>
-multiset<Key>::multiset(multiset&& m) : set<Key>(std::move(m)) {}
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+multiset<Key, Compare, Allocator>::multiset(sorted_equivalent_t, InputIt first,
+                                            InputIt last)
+    : multiset() {
+  this->tree_->buildFromSorted(first, last);
+}
 
-template <typename Key>
-multiset<Key>::multiset(const multiset& m) : set<Key>(m) {}
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator>::multiset(multiset&& m)
+    : set<Key, Compare, Allocator>(std::move(m)) {}
 
-template <typename Key>
-multiset<Key>& multiset<Key>::operator=(multiset&& m) {
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator>::multiset(const multiset& m)
+    : set<Key, Compare, Allocator>(m) {}
+
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator>&
+multiset<Key, Compare, Allocator>::operator=(multiset&& m) {
   if (this != &m) {
-    set<Key>::operator=(std::move(m));
+    set<Key, Compare, Allocator>::operator=(std::move(m));
   }
   return *this;
 }
 
-template <typename Key>
-multiset<Key>& multiset<Key>::operator=(const multiset& m) {
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator>&
+multiset<Key, Compare, Allocator>::operator=(const multiset& m) {
   if (this != &m) {
-    this->clear();
-    set<Key>::operator=(m);
+    set<Key, Compare, Allocator>::operator=(m);
   }
   return *this;
 }
 
-template <typename Key>
-std::pair<typename multiset<Key>::iterator, bool> multiset<Key>::insert(
-    const value_type& value) {
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename multiset<Key, Compare, Allocator>::iterator, bool>
+multiset<Key, Compare, Allocator>::insert(const value_type& value) {
   return this->tree_->insertNonUniq(value);
 }
 
-template <typename Key>
-typename multiset<Key>::iterator multiset<Key>::lower_bound(
-    const value_type& value) {
-  return this->tree_->lower_bound(value);
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename multiset<Key, Compare, Allocator>::iterator, bool>
+multiset<Key, Compare, Allocator>::insert(value_type&& value) {
+  return this->tree_->insertNonUniq(std::move(value));
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename multiset<Key, Compare, Allocator>::iterator
+multiset<Key, Compare, Allocator>::emplace(Args&&... args) {
+  return this->tree_->emplaceNonUniq(std::forward<Args>(args)...);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename multiset<Key, Compare, Allocator>::iterator
+multiset<Key, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                                Args&&... args) {
+  return this->tree_->emplaceHint(hint, false, std::forward<Args>(args)...)
+      .first;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename multiset<Key, Compare, Allocator>::iterator
+multiset<Key, Compare, Allocator>::insert(const_iterator hint,
+                                          const value_type& value) {
+  return this->tree_->insertHint(hint, value, false).first;
 }
 
-template <typename Key>
-typename multiset<Key>::iterator multiset<Key>::upper_bound(
-    const value_type& value) {
-  return this->tree_->upper_bound(value);
+template <typename Key, typename Compare, typename Allocator>
+typename multiset<Key, Compare, Allocator>::iterator
+multiset<Key, Compare, Allocator>::insert(const_iterator hint,
+                                          value_type&& value) {
+  return this->tree_->insertHint(hint, std::move(value), false).first;
 }
 
-template <typename Key>
-std::pair<typename multiset<Key>::iterator, typename multiset<Key>::iterator>
-multiset<Key>::equal_range(const value_type& value) {
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename multiset<Key, Compare, Allocator>::iterator,
+          typename multiset<Key, Compare, Allocator>::iterator>
+multiset<Key, Compare, Allocator>::equal_range(const value_type& value) {
   return std::make_pair(lower_bound(value), upper_bound(value));
 }
 
-template <typename Key>
-typename multiset<Key>::size_type multiset<Key>::count(
-    const value_type& value) {
-  size_type result = 0;
-  auto begin = lower_bound(value);
-  auto end = upper_bound(value);
-  while (begin != end) {
-    ++result;
-    ++begin;
-  }
-  return result;
+template <typename Key, typename Compare, typename Allocator>
+typename multiset<Key, Compare, Allocator>::size_type
+multiset<Key, Compare, Allocator>::count(const value_type& value) {
+  return this->tree_->count(value);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename multiset<Key, Compare, Allocator>::size_type
+multiset<Key, Compare, Allocator>::count(const K& key) {
+  return this->tree_->count(key);
 }
 
-template <typename Key>
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+std::pair<typename multiset<Key, Compare, Allocator>::iterator,
+          typename multiset<Key, Compare, Allocator>::iterator>
+multiset<Key, Compare, Allocator>::equal_range(const K& key) {
+  return std::make_pair(lower_bound(key), upper_bound(key));
+}
+
+template <typename Key, typename Compare, typename Allocator>
 template <typename... Args>
-std::vector<std::pair<typename multiset<Key>::iterator, bool>>
-multiset<Key>::insert_many(Args&&... args) {
+std::vector<
+    std::pair<typename multiset<Key, Compare, Allocator>::iterator, bool>>
+multiset<Key, Compare, Allocator>::insert_many(Args&&... args) {
   std::vector<std::pair<iterator, bool>> results;
-  (results.push_back(this->insert(std::forward<Args>(args))), ...);
+  results.reserve(sizeof...(Args));
+  // Each element is hinted at the successor of the previous one, so sorted
+  // batches are appended without descending from the root
+  const_iterator hint = this->end();
+  [[maybe_unused]] auto insertNext = [this, &hint](value_type&& value) {
+    auto result = this->tree_->insertHint(hint, std::move(value), false);
+    hint = result.first;
+    ++hint;
+    return result;
+  };
+  (results.push_back(insertNext(value_type(std::forward<Args>(args)))), ...);
   return results;
 }
 
-template <typename T>
-void multiset<T>::merge(multiset& other) {
+template <typename Key, typename Compare, typename Allocator>
+void multiset<Key, Compare, Allocator>::merge(multiset& other) {
   this->tree_->mergeNonUniq(*other.tree_);
 }
 
+template <typename Key, typename Compare, typename Allocator>
+multiset<Key, Compare, Allocator>
+multiset<Key, Compare, Allocator>::extract(const value_type& low,
+                                           const value_type& high) {
+  multiset result(this->get_allocator());
+  *result.tree_ = this->tree_->extract(low, high);
+  return result;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void multiset<Key, Compare, Allocator>::unite(multiset& other) {
+  this->tree_->unite(*other.tree_, false);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void multiset<Key, Compare, Allocator>::intersect(multiset& other) {
+  this->tree_->intersect(*other.tree_, false);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void multiset<Key, Compare, Allocator>::subtract(multiset& other) {
+  this->tree_->subtract(*other.tree_, false);
+}
+
 }  // namespace s21
 
 #endif  // S21_MULTISET_H
\ No newline at end of file
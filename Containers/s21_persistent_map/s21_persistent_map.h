@@ -0,0 +1,232 @@
+#ifndef S21_PERSISTENT_MAP_H
+#define S21_PERSISTENT_MAP_H
+
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "../AVLtree/PersistentTree.h"
+#include "../s21_map/s21_map.h"
+
+namespace s21 {
+
+/*
+persistent_map
+map on top of PersistentTree. Copying a persistent_map takes O(1) and the
+copy is a snapshot: later changes to either one path-copy O(log n) nodes
+and leave the other as it was. Values are read-only through iterators,
+since a node may belong to many versions; insert_or_assign replaces one.
+*/
+
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class persistent_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using tree_type = PersistentTree<value_type,
+                                   Comparatormap<value_type, Compare>,
+                                   Allocator>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+
+  // Constructors
+  persistent_map() = default;
+  explicit persistent_map(const Allocator &alloc) : tree_(alloc) {}
+  persistent_map(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  persistent_map(InputIt first, InputIt last);
+
+  const mapped_type &at(const key_type &key) const;
+
+  allocator_type get_allocator() const;
+
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+  int height() const;
+
+  // Modifiers
+  void clear();
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(const key_type &key, const mapped_type &obj);
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  size_type erase(const key_type &key);
+  void swap(persistent_map &other);
+
+  // Lookup
+  iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+  iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key) const;
+
+  // Iterators
+  iterator begin() const;
+  iterator end() const;
+
+  // Whether other is a copy of this version that neither side has changed
+  bool same_version(const persistent_map &other) const;
+
+ private:
+  tree_type tree_;
+};
+
+// Implementation of methods
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+persistent_map<Key, T, Compare, Allocator>::persistent_map(
+    std::initializer_list<value_type> const &items)
+    : persistent_map(items.begin(), items.end()) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename InputIt>
+persistent_map<Key, T, Compare, Allocator>::persistent_map(InputIt first,
+                                                           InputIt last) {
+  for (; first != last; ++first) insert(*first);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+const typename persistent_map<Key, T, Compare, Allocator>::mapped_type &
+persistent_map<Key, T, Compare, Allocator>::at(const key_type &key) const {
+  iterator it = tree_.find(key);
+  if (it == end()) throw std::out_of_range("persistent_map key is not found");
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename persistent_map<Key, T, Compare, Allocator>::allocator_type
+persistent_map<Key, T, Compare, Allocator>::get_allocator() const {
+  return tree_.get_allocator();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool persistent_map<Key, T, Compare, Allocator>::empty() const {
+  return tree_.empty();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename persistent_map<Key, T, Compare, Allocator>::size_type
+persistent_map<Key, T, Compare, Allocator>::size() const {
+  return tree_.size();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+int persistent_map<Key, T, Compare, Allocator>::height() const {
+  return tree_.height();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void persistent_map<Key, T, Compare, Allocator>::clear() {
+  tree_.clear();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename persistent_map<Key, T, Compare, Allocator>::iterator, bool>
+persistent_map<Key, T, Compare, Allocator>::insert(const value_type &value) {
+  return tree_.emplace(value.first, false, value);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename persistent_map<Key, T, Compare, Allocator>::iterator, bool>
+persistent_map<Key, T, Compare, Allocator>::insert(const key_type &key,
+                                                   const mapped_type &obj) {
+  return tree_.emplace(key, false, key, obj);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename M>
+std::pair<typename persistent_map<Key, T, Compare, Allocator>::iterator, bool>
+persistent_map<Key, T, Compare, Allocator>::insert_or_assign(
+    const key_type &key, M &&obj) {
+  return tree_.emplace(key, true, key, std::forward<M>(obj));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename persistent_map<Key, T, Compare, Allocator>::iterator, bool>
+persistent_map<Key, T, Compare, Allocator>::emplace(Args &&...args) {
+  value_type value(std::forward<Args>(args)...);
+  return tree_.emplace(value.first, false, std::move(value));
+}
+
+// Builds the pair only when key is missing
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename persistent_map<Key, T, Compare, Allocator>::iterator, bool>
+persistent_map<Key, T, Compare, Allocator>::try_emplace(const key_type &key,
+                                                        Args &&...args) {
+  return tree_.emplace(key, false, std::piecewise_construct,
+                       std::forward_as_tuple(key),
+                       std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename persistent_map<Key, T, Compare, Allocator>::size_type
+persistent_map<Key, T, Compare, Allocator>::erase(const key_type &key) {
+  return tree_.erase(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void persistent_map<Key, T, Compare, Allocator>::swap(persistent_map &other) {
+  tree_.swap(other.tree_);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename persistent_map<Key, T, Compare, Allocator>::iterator
+persistent_map<Key, T, Compare, Allocator>::find(const key_type &key) const {
+  return tree_.find(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool persistent_map<Key, T, Compare, Allocator>::contains(
+    const key_type &key) const {
+  return tree_.contains(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename persistent_map<Key, T, Compare, Allocator>::iterator
+persistent_map<Key, T, Compare, Allocator>::lower_bound(
+    const key_type &key) const {
+  return tree_.lower_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename persistent_map<Key, T, Compare, Allocator>::iterator
+persistent_map<Key, T, Compare, Allocator>::upper_bound(
+    const key_type &key) const {
+  return tree_.upper_bound(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename persistent_map<Key, T, Compare, Allocator>::iterator
+persistent_map<Key, T, Compare, Allocator>::begin() const {
+  return tree_.begin();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename persistent_map<Key, T, Compare, Allocator>::iterator
+persistent_map<Key, T, Compare, Allocator>::end() const {
+  return tree_.end();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool persistent_map<Key, T, Compare, Allocator>::same_version(
+    const persistent_map &other) const {
+  return tree_.shares_root_with(other.tree_);
+}
+
+}  // namespace s21
+
+#endif  // S21_PERSISTENT_MAP_H
@@ -5,23 +5,33 @@
 
 namespace s21 {
 
-template <typename Key>
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
 class set {
  public:
+  using key_type = Key;
   using value_type = Key;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using avltree = Tree<value_type>;
+  using avltree = Tree<value_type, Compare, Allocator>;
   using iterator = typename avltree::iterator;
   using const_iterator = typename avltree::const_iterator;
   using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
 
   avltree* tree_;
 
  public:
   // Constructors
   set() : tree_(new avltree) {}
+  explicit set(const Allocator& alloc) : tree_(new avltree(alloc)) {}
   set(std::initializer_list<value_type> const& items);
+  template <typename InputIt>
+  set(InputIt first, InputIt last);
+  template <typename InputIt>
+  set(sorted_unique_t, InputIt first, InputIt last);
   set(const set& s);
   set(set&& s);
   ~set();
@@ -30,6 +40,8 @@ class set {
   set& operator=(set&& s);
   set& operator=(const set& s);
 
+  allocator_type get_allocator() const;
+
   // Capacity
   bool empty() const;
   size_type size() const;
@@ -38,14 +50,59 @@ class set {
   // Modifiers
   void clear();
   std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+  iterator insert(const_iterator hint, const value_type& value);
+  iterator insert(const_iterator hint, value_type&& value);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args);
   void erase(iterator pos);
+  iterator erase(iterator first, iterator last);
+  set extract(const value_type& low, const value_type& high);
   void swap(set& other);
   void merge(set& other);
 
+  // Set algebra in O(m log(n / m + 1)); other is consumed and left empty
+  void unite(set& other);
+  void intersect(set& other);
+  void subtract(set& other);
+
   // Lookup
   iterator find(const value_type& key);
   const_iterator find(const value_type& key) const;
+  iterator lower_bound(const value_type& key);
+  const_iterator lower_bound(const value_type& key) const;
+  iterator upper_bound(const value_type& key);
+  const_iterator upper_bound(const value_type& key) const;
   bool contains(const value_type& key) const;
+  // Lookup by any key-like type when Compare is transparent
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator lower_bound(const K& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator upper_bound(const K& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const;
+
+  // Order statistics, O(log n)
+  iterator select(size_type index);
+  size_type rank(const value_type& key) const;
+  difference_type distance(iterator first, iterator last);
 
   // Iterators
   iterator begin();
@@ -59,125 +116,317 @@ class set {
 
 // Implementation of methods
 
-template <typename Key>
-set<Key>::set(std::initializer_list<value_type> const& items) : set() {
-  for (auto& item : items) {
-    insert(item);
-  }
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator>::set(
+    std::initializer_list<value_type> const& items)
+    : set() {
+  tree_->assign(items.begin(), items.end(), true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+set<Key, Compare, Allocator>::set(InputIt first, InputIt last) : set() {
+  tree_->assign(first, last, true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+set<Key, Compare, Allocator>::set(sorted_unique_t, InputIt first,
+                                  InputIt last)
+    : set() {
+  tree_->buildFromSorted(first, last);
 }
 
-template <typename Key>
-set<Key>::set(set&& s) : tree_(new avltree(std::move(*s.tree_))) {}
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator>::set(set&& s)
+    : tree_(new avltree(std::move(*s.tree_))) {}
 
-template <typename Key>
-set<Key>::set(const set& s) : tree_(new avltree(*s.tree_)) {}
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator>::set(const set& s)
+    : tree_(new avltree(*s.tree_)) {}
 
-template <typename Key>
-set<Key>::~set() {
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator>::~set() {
   delete tree_;
 }
 
-template <typename Key>
-set<Key>& set<Key>::operator=(set&& s) {
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator>& set<Key, Compare, Allocator>::operator=(set&& s) {
   if (this != &s) {
     *tree_ = std::move(*s.tree_);
   }
   return *this;
 }
 
-template <typename Key>
-set<Key>& set<Key>::operator=(const set& s) {
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator>&
+set<Key, Compare, Allocator>::operator=(const set& s) {
   if (this != &s) {
-    clear();
-    for (auto it = s.begin(); it != s.end(); ++it) {
-      insert(*it);
-    }
+    *tree_ = *s.tree_;
   }
   return *this;
 }
 
-template <typename Key>
-bool set<Key>::empty() const {
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::allocator_type
+set<Key, Compare, Allocator>::get_allocator() const {
+  return tree_->get_allocator();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+bool set<Key, Compare, Allocator>::empty() const {
   return tree_->empty();
 }
 
-template <typename Key>
-typename set<Key>::size_type set<Key>::size() const {
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::size_type
+set<Key, Compare, Allocator>::size() const {
   return tree_->size();
 }
 
-template <typename Key>
-typename set<Key>::size_type set<Key>::max_size() const {
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::size_type
+set<Key, Compare, Allocator>::max_size() const {
   return tree_->max_size();
 }
 
-template <typename Key>
-void set<Key>::clear() {
+template <typename Key, typename Compare, typename Allocator>
+void set<Key, Compare, Allocator>::clear() {
   tree_->clear();
 }
 
-template <typename Key>
-std::pair<typename set<Key>::iterator, bool> set<Key>::insert(
-    const value_type& value) {
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename set<Key, Compare, Allocator>::iterator, bool>
+set<Key, Compare, Allocator>::insert(const value_type& value) {
   return tree_->insert(value);
 }
 
-template <typename Key>
-void set<Key>::erase(iterator pos) {
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename set<Key, Compare, Allocator>::iterator, bool>
+set<Key, Compare, Allocator>::insert(value_type&& value) {
+  return tree_->insert(std::move(value));
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename set<Key, Compare, Allocator>::iterator, bool>
+set<Key, Compare, Allocator>::emplace(Args&&... args) {
+  return tree_->emplace(std::forward<Args>(args)...);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                           Args&&... args) {
+  return tree_->emplaceHint(hint, true, std::forward<Args>(args)...).first;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::insert(const_iterator hint,
+                                     const value_type& value) {
+  return tree_->insertHint(hint, value, true).first;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::insert(const_iterator hint, value_type&& value) {
+  return tree_->insertHint(hint, std::move(value), true).first;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void set<Key, Compare, Allocator>::erase(iterator pos) {
   tree_->erase(pos);
 }
 
-template <typename Key>
-typename set<Key>::iterator set<Key>::begin() {
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::erase(iterator first, iterator last) {
+  return tree_->erase(first, last);
+}
+
+// Moves the keys in [low, high) into a new set
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator> set<Key, Compare, Allocator>::extract(
+    const value_type& low, const value_type& high) {
+  set result(get_allocator());
+  *result.tree_ = tree_->extract(low, high);
+  return result;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::begin() {
   return tree_->begin();
 }
 
-template <typename Key>
-typename set<Key>::iterator set<Key>::end() {
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::end() {
   return tree_->end();
 }
 
-template <typename Key>
-typename set<Key>::const_iterator set<Key>::begin() const {
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::const_iterator
+set<Key, Compare, Allocator>::begin() const {
   return static_cast<const avltree&>(*tree_).begin();
 }
 
-template <typename Key>
-typename set<Key>::const_iterator set<Key>::end() const {
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::const_iterator
+set<Key, Compare, Allocator>::end() const {
   return static_cast<const avltree&>(*tree_).end();
 }
 
-template <typename Key>
-typename set<Key>::iterator set<Key>::find(const value_type& key) {
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::find(const value_type& key) {
   return tree_->find(key);
 }
 
-template <typename Key>
-typename set<Key>::const_iterator set<Key>::find(const value_type& key) const {
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::const_iterator
+set<Key, Compare, Allocator>::find(const value_type& key) const {
+  return static_cast<const avltree&>(*tree_).find(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::lower_bound(const value_type& key) {
+  return tree_->lower_bound(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::const_iterator
+set<Key, Compare, Allocator>::lower_bound(const value_type& key) const {
+  return static_cast<const avltree&>(*tree_).lower_bound(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::upper_bound(const value_type& key) {
+  return tree_->upper_bound(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::const_iterator
+set<Key, Compare, Allocator>::upper_bound(const value_type& key) const {
+  return static_cast<const avltree&>(*tree_).upper_bound(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+bool set<Key, Compare, Allocator>::contains(const value_type& key) const {
+  return tree_->contains(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::find(const K& key) {
   return tree_->find(key);
 }
 
-template <typename Key>
-bool set<Key>::contains(const value_type& key) const {
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename set<Key, Compare, Allocator>::const_iterator
+set<Key, Compare, Allocator>::find(const K& key) const {
+  return static_cast<const avltree&>(*tree_).find(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::lower_bound(const K& key) {
+  return tree_->lower_bound(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename set<Key, Compare, Allocator>::const_iterator
+set<Key, Compare, Allocator>::lower_bound(const K& key) const {
+  return static_cast<const avltree&>(*tree_).lower_bound(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::upper_bound(const K& key) {
+  return tree_->upper_bound(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename set<Key, Compare, Allocator>::const_iterator
+set<Key, Compare, Allocator>::upper_bound(const K& key) const {
+  return static_cast<const avltree&>(*tree_).upper_bound(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+bool set<Key, Compare, Allocator>::contains(const K& key) const {
   return tree_->contains(key);
 }
 
-template <typename Key>
-void set<Key>::swap(set& other) {
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::select(size_type index) {
+  return tree_->select(index);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::size_type
+set<Key, Compare, Allocator>::rank(const value_type& key) const {
+  return tree_->rank(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::difference_type
+set<Key, Compare, Allocator>::distance(iterator first, iterator last) {
+  return tree_->distance(first, last);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void set<Key, Compare, Allocator>::swap(set& other) {
   std::swap(tree_, other.tree_);
 }
 
-template <typename Key>
-void set<Key>::merge(set& other) {
+template <typename Key, typename Compare, typename Allocator>
+void set<Key, Compare, Allocator>::merge(set& other) {
   tree_->merge(*other.tree_);
 }
 
-template <typename Key>
+template <typename Key, typename Compare, typename Allocator>
+void set<Key, Compare, Allocator>::unite(set& other) {
+  tree_->unite(*other.tree_, true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void set<Key, Compare, Allocator>::intersect(set& other) {
+  tree_->intersect(*other.tree_, true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+void set<Key, Compare, Allocator>::subtract(set& other) {
+  tree_->subtract(*other.tree_, true);
+}
+
+template <typename Key, typename Compare, typename Allocator>
 template <typename... Args>
-std::vector<std::pair<typename set<Key>::iterator, bool>> set<Key>::insert_many(
-    Args&&... args) {
+std::vector<std::pair<typename set<Key, Compare, Allocator>::iterator, bool>>
+set<Key, Compare, Allocator>::insert_many(Args&&... args) {
   std::vector<std::pair<iterator, bool>> results;
-  (results.push_back(this->insert(std::forward<Args>(args))), ...);
+  results.reserve(sizeof...(Args));
+  // Each element is hinted at the successor of the previous one, so sorted
+  // batches are appended without descending from the root
+  const_iterator hint = end();
+  [[maybe_unused]] auto insertNext = [this, &hint](value_type&& value) {
+    auto result = tree_->insertHint(hint, std::move(value), true);
+    hint = result.first;
+    ++hint;
+    return result;
+  };
+  (results.push_back(insertNext(value_type(std::forward<Args>(args)))), ...);
   return results;
 }
 
@@ -0,0 +1,456 @@
+#ifndef S21_UNORDERED_MAP_H
+#define S21_UNORDERED_MAP_H
+
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../AVLtree/HashTable.h"
+
+namespace s21 {
+
+/*
+unordered_map
+Key-value pairs in an open addressing HashTable, with O(1) average point
+lookups for caches that never need the keys in order. Any insert may
+rehash and invalidate iterators; reserve() up front avoids that.
+*/
+
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class unordered_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using table_type =
+      HashTable<Key, value_type, HashSelectFirst, Hash, KeyEqual, Allocator>;
+  using iterator = typename table_type::iterator;
+  using const_iterator = typename table_type::const_iterator;
+  using size_type = size_t;
+
+  // Constructors
+  unordered_map() = default;
+  explicit unordered_map(size_type bucketCount, const Hash &hash = Hash(),
+                         const KeyEqual &equal = KeyEqual(),
+                         const Allocator &alloc = Allocator())
+      : table_(bucketCount, hash, equal, alloc) {}
+  unordered_map(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  unordered_map(InputIt first, InputIt last);
+
+  mapped_type &operator[](const key_type &key);
+  mapped_type &at(const key_type &key);
+  const mapped_type &at(const key_type &key) const;
+
+  allocator_type get_allocator() const;
+  hasher hash_function() const;
+  key_equal key_eq() const;
+
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+  size_type max_size() const;
+
+  // Hash policy
+  size_type bucket_count() const;
+  float load_factor() const;
+  float max_load_factor() const;
+  void max_load_factor(float ml);
+  void rehash(size_type count);
+  void reserve(size_type count);
+
+  // Modifiers
+  void clear();
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  std::pair<iterator, bool> insert(const key_type &key, const mapped_type &obj);
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last);
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args);
+  iterator erase(const_iterator pos);
+  size_type erase(const key_type &key);
+  void swap(unordered_map &other);
+
+  // Lookup
+  iterator find(const key_type &key);
+  const_iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+
+  // Lookup by any key-like type when Hash and KeyEqual are transparent
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = typename H::is_transparent,
+            typename = typename E::is_transparent>
+  iterator find(const K &key);
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = typename H::is_transparent,
+            typename = typename E::is_transparent>
+  const_iterator find(const K &key) const;
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = typename H::is_transparent,
+            typename = typename E::is_transparent>
+  bool contains(const K &key) const;
+
+  // Iterators
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  template <class... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+
+ private:
+  table_type table_;
+};
+
+// Implementation of methods
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::unordered_map(
+    std::initializer_list<value_type> const &items) {
+  insert(items.begin(), items.end());
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename InputIt>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::unordered_map(
+    InputIt first, InputIt last) {
+  insert(first, last);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::mapped_type &
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::operator[](
+    const key_type &key) {
+  return try_emplace(key).first->second;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::mapped_type &
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::at(const key_type &key) {
+  iterator it = find(key);
+  if (it == end()) throw std::out_of_range("Key not found");
+  return it->second;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+const typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::mapped_type &
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::at(
+    const key_type &key) const {
+  const_iterator it = find(key);
+  if (it == end()) throw std::out_of_range("Key not found");
+  return it->second;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::allocator_type
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::get_allocator() const {
+  return table_.get_allocator();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::hasher
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::hash_function() const {
+  return table_.hash_function();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::key_equal
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::key_eq() const {
+  return table_.key_eq();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+bool unordered_map<Key, T, Hash, KeyEqual, Allocator>::empty() const {
+  return table_.empty();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::size_type
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::size() const {
+  return table_.size();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::size_type
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::max_size() const {
+  return table_.max_size();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::size_type
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::bucket_count() const {
+  return table_.capacity();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+float unordered_map<Key, T, Hash, KeyEqual, Allocator>::load_factor() const {
+  return table_.load_factor();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+float unordered_map<Key, T, Hash, KeyEqual, Allocator>::max_load_factor()
+    const {
+  return table_.max_load_factor();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void unordered_map<Key, T, Hash, KeyEqual, Allocator>::max_load_factor(
+    float ml) {
+  table_.max_load_factor(ml);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void unordered_map<Key, T, Hash, KeyEqual, Allocator>::rehash(
+    size_type count) {
+  table_.rehash(count);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void unordered_map<Key, T, Hash, KeyEqual, Allocator>::reserve(
+    size_type count) {
+  table_.reserve(count);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void unordered_map<Key, T, Hash, KeyEqual, Allocator>::clear() {
+  table_.clear();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+std::pair<typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::insert(
+    const value_type &value) {
+  return table_.tryEmplace(value.first, value);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+std::pair<typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::insert(value_type &&value) {
+  return table_.tryEmplace(value.first, std::move(value));
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+std::pair<typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::insert(
+    const key_type &key, const mapped_type &obj) {
+  return try_emplace(key, obj);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename InputIt>
+void unordered_map<Key, T, Hash, KeyEqual, Allocator>::insert(InputIt first,
+                                                              InputIt last) {
+  for (; first != last; ++first) insert(*first);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename M>
+std::pair<typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::insert_or_assign(
+    const key_type &key, M &&obj) {
+  auto result = try_emplace(key, std::forward<M>(obj));
+  if (!result.second) result.first->second = std::forward<M>(obj);
+  return result;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename... Args>
+std::pair<typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::emplace(Args &&...args) {
+  return table_.emplace(std::forward<Args>(args)...);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename... Args>
+std::pair<typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::try_emplace(
+    const key_type &key, Args &&...args) {
+  return table_.tryEmplace(key, std::piecewise_construct,
+                           std::forward_as_tuple(key),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename... Args>
+std::pair<typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::try_emplace(
+    key_type &&key, Args &&...args) {
+  return table_.tryEmplace(key, std::piecewise_construct,
+                           std::forward_as_tuple(std::move(key)),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::erase(const_iterator pos) {
+  return table_.erase(pos);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::size_type
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::erase(const key_type &key) {
+  return table_.eraseKey(key);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void unordered_map<Key, T, Hash, KeyEqual, Allocator>::swap(
+    unordered_map &other) {
+  table_.swap(other.table_);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::find(const key_type &key) {
+  return table_.find(key);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::const_iterator
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::find(
+    const key_type &key) const {
+  return table_.find(key);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+bool unordered_map<Key, T, Hash, KeyEqual, Allocator>::contains(
+    const key_type &key) const {
+  return table_.contains(key);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::size_type
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::count(
+    const key_type &key) const {
+  return table_.contains(key) ? 1U : 0U;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename K, typename H, typename E, typename, typename>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::find(const K &key) {
+  return table_.find(key);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename K, typename H, typename E, typename, typename>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::const_iterator
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::find(const K &key) const {
+  return table_.find(key);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename K, typename H, typename E, typename, typename>
+bool unordered_map<Key, T, Hash, KeyEqual, Allocator>::contains(
+    const K &key) const {
+  return table_.contains(key);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::begin() {
+  return table_.begin();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::end() {
+  return table_.end();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::const_iterator
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::begin() const {
+  return table_.begin();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::const_iterator
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::end() const {
+  return table_.end();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename... Args>
+std::vector<std::pair<
+    typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator, bool>>
+unordered_map<Key, T, Hash, KeyEqual, Allocator>::insert_many(
+    Args &&...args) {
+  std::vector<std::pair<iterator, bool>> results;
+  results.reserve(sizeof...(Args));
+  // Room for the whole batch up front: no rehash can invalidate the
+  // iterators already returned
+  table_.reserve(table_.size() + sizeof...(Args));
+  (results.push_back(insert(value_type(std::forward<Args>(args)))), ...);
+  return results;
+}
+
+}  // namespace s21
+
+#endif  // S21_UNORDERED_MAP_H
@@ -0,0 +1,303 @@
+#ifndef S21_UNORDERED_SET_H
+#define S21_UNORDERED_SET_H
+
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include "../AVLtree/HashTable.h"
+
+namespace s21 {
+
+/*
+unordered_set
+Unique keys in an open addressing HashTable: O(1) average lookups that
+probe a flat array instead of following tree nodes. Iteration order is
+unspecified and any insert may rehash and invalidate iterators.
+Lookups take any key-like type when both Hash and KeyEqual are
+transparent.
+*/
+
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<Key>>
+class unordered_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using table_type =
+      HashTable<Key, Key, HashIdentity, Hash, KeyEqual, Allocator>;
+  using iterator = typename table_type::const_iterator;
+  using const_iterator = typename table_type::const_iterator;
+  using size_type = size_t;
+
+  // Constructors
+  unordered_set() = default;
+  explicit unordered_set(size_type bucketCount, const Hash& hash = Hash(),
+                         const KeyEqual& equal = KeyEqual(),
+                         const Allocator& alloc = Allocator())
+      : table_(bucketCount, hash, equal, alloc) {}
+  unordered_set(std::initializer_list<value_type> const& items);
+  template <typename InputIt>
+  unordered_set(InputIt first, InputIt last);
+
+  allocator_type get_allocator() const;
+  hasher hash_function() const;
+  key_equal key_eq() const;
+
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+  size_type max_size() const;
+
+  // Hash policy
+  size_type bucket_count() const;
+  float load_factor() const;
+  float max_load_factor() const;
+  void max_load_factor(float ml);
+  void rehash(size_type count);
+  void reserve(size_type count);
+
+  // Modifiers
+  void clear();
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  iterator erase(const_iterator pos);
+  size_type erase(const value_type& key);
+  void swap(unordered_set& other);
+
+  // Lookup
+  iterator find(const value_type& key) const;
+  bool contains(const value_type& key) const;
+  size_type count(const value_type& key) const;
+
+  // Lookup by any key-like type when Hash and KeyEqual are transparent
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = typename H::is_transparent,
+            typename = typename E::is_transparent>
+  iterator find(const K& key) const;
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = typename H::is_transparent,
+            typename = typename E::is_transparent>
+  bool contains(const K& key) const;
+
+  // Iterators
+  iterator begin() const;
+  iterator end() const;
+
+  template <class... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+
+ private:
+  table_type table_;
+};
+
+// Implementation of methods
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+unordered_set<Key, Hash, KeyEqual, Allocator>::unordered_set(
+    std::initializer_list<value_type> const& items) {
+  insert(items.begin(), items.end());
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+template <typename InputIt>
+unordered_set<Key, Hash, KeyEqual, Allocator>::unordered_set(InputIt first,
+                                                             InputIt last) {
+  insert(first, last);
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename unordered_set<Key, Hash, KeyEqual, Allocator>::allocator_type
+unordered_set<Key, Hash, KeyEqual, Allocator>::get_allocator() const {
+  return table_.get_allocator();
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename unordered_set<Key, Hash, KeyEqual, Allocator>::hasher
+unordered_set<Key, Hash, KeyEqual, Allocator>::hash_function() const {
+  return table_.hash_function();
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename unordered_set<Key, Hash, KeyEqual, Allocator>::key_equal
+unordered_set<Key, Hash, KeyEqual, Allocator>::key_eq() const {
+  return table_.key_eq();
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+bool unordered_set<Key, Hash, KeyEqual, Allocator>::empty() const {
+  return table_.empty();
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename unordered_set<Key, Hash, KeyEqual, Allocator>::size_type
+unordered_set<Key, Hash, KeyEqual, Allocator>::size() const {
+  return table_.size();
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename unordered_set<Key, Hash, KeyEqual, Allocator>::size_type
+unordered_set<Key, Hash, KeyEqual, Allocator>::max_size() const {
+  return table_.max_size();
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename unordered_set<Key, Hash, KeyEqual, Allocator>::size_type
+unordered_set<Key, Hash, KeyEqual, Allocator>::bucket_count() const {
+  return table_.capacity();
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+float unordered_set<Key, Hash, KeyEqual, Allocator>::load_factor() const {
+  return table_.load_factor();
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+float unordered_set<Key, Hash, KeyEqual, Allocator>::max_load_factor() const {
+  return table_.max_load_factor();
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+void unordered_set<Key, Hash, KeyEqual, Allocator>::max_load_factor(
+    float ml) {
+  table_.max_load_factor(ml);
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+void unordered_set<Key, Hash, KeyEqual, Allocator>::rehash(size_type count) {
+  table_.rehash(count);
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+void unordered_set<Key, Hash, KeyEqual, Allocator>::reserve(size_type count) {
+  table_.reserve(count);
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+void unordered_set<Key, Hash, KeyEqual, Allocator>::clear() {
+  table_.clear();
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+std::pair<typename unordered_set<Key, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+unordered_set<Key, Hash, KeyEqual, Allocator>::insert(
+    const value_type& value) {
+  return table_.tryEmplace(value, value);
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+std::pair<typename unordered_set<Key, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+unordered_set<Key, Hash, KeyEqual, Allocator>::insert(value_type&& value) {
+  return table_.tryEmplace(value, std::move(value));
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+template <typename InputIt>
+void unordered_set<Key, Hash, KeyEqual, Allocator>::insert(InputIt first,
+                                                           InputIt last) {
+  for (; first != last; ++first) insert(*first);
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+template <typename... Args>
+std::pair<typename unordered_set<Key, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+unordered_set<Key, Hash, KeyEqual, Allocator>::emplace(Args&&... args) {
+  return table_.emplace(std::forward<Args>(args)...);
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename unordered_set<Key, Hash, KeyEqual, Allocator>::iterator
+unordered_set<Key, Hash, KeyEqual, Allocator>::erase(const_iterator pos) {
+  return table_.erase(pos);
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename unordered_set<Key, Hash, KeyEqual, Allocator>::size_type
+unordered_set<Key, Hash, KeyEqual, Allocator>::erase(const value_type& key) {
+  return table_.eraseKey(key);
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+void unordered_set<Key, Hash, KeyEqual, Allocator>::swap(
+    unordered_set& other) {
+  table_.swap(other.table_);
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename unordered_set<Key, Hash, KeyEqual, Allocator>::iterator
+unordered_set<Key, Hash, KeyEqual, Allocator>::find(
+    const value_type& key) const {
+  return table_.find(key);
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+bool unordered_set<Key, Hash, KeyEqual, Allocator>::contains(
+    const value_type& key) const {
+  return table_.contains(key);
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename unordered_set<Key, Hash, KeyEqual, Allocator>::size_type
+unordered_set<Key, Hash, KeyEqual, Allocator>::count(
+    const value_type& key) const {
+  return table_.contains(key) ? 1U : 0U;
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+template <typename K, typename H, typename E, typename, typename>
+typename unordered_set<Key, Hash, KeyEqual, Allocator>::iterator
+unordered_set<Key, Hash, KeyEqual, Allocator>::find(const K& key) const {
+  return table_.find(key);
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+template <typename K, typename H, typename E, typename, typename>
+bool unordered_set<Key, Hash, KeyEqual, Allocator>::contains(
+    const K& key) const {
+  return table_.contains(key);
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename unordered_set<Key, Hash, KeyEqual, Allocator>::iterator
+unordered_set<Key, Hash, KeyEqual, Allocator>::begin() const {
+  return table_.begin();
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename unordered_set<Key, Hash, KeyEqual, Allocator>::iterator
+unordered_set<Key, Hash, KeyEqual, Allocator>::end() const {
+  return table_.end();
+}
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+template <typename... Args>
+std::vector<
+    std::pair<typename unordered_set<Key, Hash, KeyEqual, Allocator>::iterator,
+              bool>>
+unordered_set<Key, Hash, KeyEqual, Allocator>::insert_many(Args&&... args) {
+  std::vector<std::pair<iterator, bool>> results;
+  results.reserve(sizeof...(Args));
+  // Room for the whole batch up front: no rehash can invalidate the
+  // iterators already returned
+  table_.reserve(table_.size() + sizeof...(Args));
+  (results.push_back(insert(value_type(std::forward<Args>(args)))), ...);
+  return results;
+}
+
+}  // namespace s21
+
+#endif  // S21_UNORDERED_SET_H
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+namespace {
+
+// Sends every key to the same probe start and control byte
+struct ConstantHash {
+  std::size_t operator()(int) const { return 42U; }
+};
+
+struct StringHash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view text) const {
+    return std::hash<std::string_view>()(text);
+  }
+};
+
+template <typename Container>
+std::vector<int> Sorted(const Container& container) {
+  std::vector<int> result(container.begin(), container.end());
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+}  // namespace
+
+TEST(HashTest, SetMatchesStdSet) {
+  std::srand(45);
+  s21::unordered_set<int> set;
+  std::set<int> expected;
+  for (int i = 0; i < 20000; ++i) {
+    int key = std::rand() % 3000;
+    if (std::rand() % 3) {
+      ASSERT_EQ(set.insert(key).second, expected.insert(key).second);
+    } else {
+      ASSERT_EQ(set.erase(key), expected.erase(key));
+    }
+    ASSERT_EQ(set.size(), expected.size());
+  }
+  for (int key = -1; key <= 3000; ++key) {
+    ASSERT_EQ(set.contains(key), expected.count(key) == 1U);
+  }
+  ASSERT_EQ(Sorted(set), std::vector<int>(expected.begin(), expected.end()));
+  ASSERT_LE(set.load_factor(), set.max_load_factor());
+
+  s21::unordered_set<int> copy = set;
+  ASSERT_EQ(Sorted(copy), Sorted(set));
+  s21::unordered_set<int> moved = std::move(copy);
+  ASSERT_EQ(moved.size(), expected.size());
+  ASSERT_TRUE(copy.empty());
+}
+
+TEST(HashTest, CollidingKeysAndDeletedSlots) {
+  s21::unordered_set<int, ConstantHash> set;
+  for (int round = 0; round < 20; ++round) {
+    for (int i = 0; i < 100; ++i) set.insert(round * 100 + i);
+    for (int i = 0; i < 100; i += 2) set.erase(round * 100 + i);
+  }
+  ASSERT_EQ(set.size(), 1000U);
+  for (int key = 0; key < 2000; ++key) {
+    ASSERT_EQ(set.contains(key), key % 2 == 1);
+  }
+  // Erasing while iterating visits every remaining key once
+  std::size_t visited = 0U;
+  for (auto it = set.begin(); it != set.end();) {
+    it = *it % 4 == 1 ? set.erase(it) : std::next(it);
+    ++visited;
+  }
+  ASSERT_EQ(visited, 1000U);
+  ASSERT_EQ(set.size(), 500U);
+  s21::unordered_set<int, ConstantHash> copy(set);
+  ASSERT_TRUE(copy.contains(1999));
+  ASSERT_FALSE(copy.contains(1997));
+}
+
+TEST(HashTest, MapModifiers) {
+  s21::unordered_map<std::string, int> map = {{"a", 1}, {"b", 2}, {"a", 3}};
+  ASSERT_EQ(map.size(), 2U);
+  ASSERT_EQ(map.at("a"), 1);
+  map["c"] = 3;
+  ++map["c"];
+  ASSERT_EQ(map.at("c"), 4);
+  ASSERT_THROW(map.at("z"), std::out_of_range);
+  ASSERT_FALSE(map.insert("b", 20).second);
+  ASSERT_FALSE(map.insert_or_assign("b", 20).second);
+  ASSERT_EQ(map.find("b")->second, 20);
+  ASSERT_TRUE(map.try_emplace("d", 5).second);
+  ASSERT_FALSE(map.try_emplace("d", 6).second);
+  ASSERT_TRUE(map.emplace("e", 7).second);
+  ASSERT_EQ(map.erase("a"), 1U);
+  ASSERT_EQ(map.erase("a"), 0U);
+  ASSERT_EQ(map.count("e"), 1U);
+
+  std::map<std::string, int> sorted(map.begin(), map.end());
+  ASSERT_EQ(sorted, (std::map<std::string, int>{
+                        {"b", 20}, {"c", 4}, {"d", 5}, {"e", 7}}));
+  const auto& constMap = map;
+  ASSERT_EQ(constMap.at("d"), 5);
+  ASSERT_EQ(constMap.find("q"), constMap.end());
+
+  auto results = map.insert_many(std::make_pair("f", 8),
+                                 std::make_pair("b", 0),
+                                 std::make_pair("g", 9));
+  ASSERT_EQ(results.size(), 3U);
+  ASSERT_TRUE(results[0].second);
+  ASSERT_FALSE(results[1].second);
+  ASSERT_EQ(results[0].first->second, 8);
+  ASSERT_EQ(results[1].first->second, 20);
+  ASSERT_EQ(results[2].first->first, "g");
+}
+
+TEST(HashTest, HashPolicy) {
+  s21::unordered_map<int, int> map;
+  ASSERT_EQ(map.bucket_count(), 0U);
+  ASSERT_EQ(map.load_factor(), 0.0F);
+  map.reserve(1000);
+  std::size_t buckets = map.bucket_count();
+  ASSERT_GE(buckets * map.max_load_factor(), 1000.0F);
+  for (int i = 0; i < 1000; ++i) map[i] = i;
+  ASSERT_EQ(map.bucket_count(), buckets);
+
+  map.max_load_factor(0.25F);
+  ASSERT_LE(map.load_factor(), 0.25F);
+  ASSERT_GT(map.bucket_count(), buckets);
+  ASSERT_THROW(map.max_load_factor(0.0F), std::invalid_argument);
+  map.rehash(1U << 14);
+  ASSERT_EQ(map.bucket_count(), 1U << 14);
+  for (int i = 0; i < 1000; ++i) ASSERT_EQ(map.at(i), i);
+
+  s21::unordered_set<int> full(16);
+  full.max_load_factor(1.0F);
+  for (int i = 0; i < 15; ++i) full.insert(i);
+  ASSERT_EQ(full.bucket_count(), 16U);
+  full.insert(15);
+  ASSERT_EQ(full.bucket_count(), 32U);
+}
+
+TEST(HashTest, HeterogeneousLookup) {
+  s21::unordered_set<std::string, StringHash, std::equal_to<>> set = {
+      "alpha", "beta"};
+  std::string_view key = "beta";
+  ASSERT_TRUE(set.contains(key));
+  ASSERT_EQ(*set.find(key), "beta");
+  ASSERT_FALSE(set.contains(std::string_view("gamma")));
+
+  s21::unordered_map<std::string, int, StringHash, std::equal_to<>> map;
+  map["alpha"] = 1;
+  ASSERT_EQ(map.find(std::string_view("alpha"))->second, 1);
+  ASSERT_TRUE(map.contains(std::string_view("alpha")));
+  ASSERT_FALSE(map.contains("alp"));
+}
@@ -1,8 +1,17 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <random>
+#include <set>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include "../s21_containers.h"
 #include "../s21_containersplus.h"
@@ -3410,3 +3419,1495 @@ TEST(MultisetInsertManyTest, InsertManyNoElements) {
   size_t n = 0;
   ASSERT_EQ(results.size(), n);
 }
+
+struct AllocationCounters {
+  static inline int allocations = 0;
+  static inline int live = 0;
+};
+
+template <typename T>
+struct CountingAllocator : AllocationCounters {
+  using value_type = T;
+
+  CountingAllocator() = default;
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>&) {}
+
+  T* allocate(std::size_t n) {
+    ++allocations;
+    ++live;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, std::size_t n) {
+    --live;
+    std::allocator<T>().deallocate(p, n);
+  }
+  template <typename U>
+  bool operator==(const CountingAllocator<U>&) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const CountingAllocator<U>&) const {
+    return false;
+  }
+};
+
+TEST(NodePoolTest, SetAllocatesInChunks) {
+  CountingAllocator<int>::allocations = 0;
+  {
+    s21::set<int, std::less<int>, CountingAllocator<int>> set;
+    for (int i = 0; i < 10000; ++i) set.insert(i);
+    ASSERT_EQ(set.size(), 10000U);
+    ASSERT_LT(CountingAllocator<int>::allocations, 20);
+    int expected = 0;
+    for (auto it = set.begin(); it != set.end(); ++it) {
+      ASSERT_EQ(*it, expected++);
+    }
+  }
+  ASSERT_EQ(CountingAllocator<int>::live, 0);
+}
+
+TEST(NodePoolTest, ErasedNodesAreReused) {
+  s21::set<int, std::less<int>, CountingAllocator<int>> set;
+  for (int i = 0; i < 1000; ++i) set.insert(i);
+  int before = CountingAllocator<int>::allocations;
+  for (int i = 0; i < 500; ++i) set.erase(set.find(i * 2));
+  for (int i = 0; i < 500; ++i) set.insert(-i - 1);
+  ASSERT_EQ(CountingAllocator<int>::allocations, before);
+  ASSERT_EQ(set.size(), 1000U);
+  ASSERT_EQ(*set.begin(), -500);
+}
+
+TEST(NodePoolTest, ClearReleasesChunks) {
+  CountingAllocator<int>::live = 0;
+  s21::multiset<int, std::less<int>, CountingAllocator<int>> multiset;
+  for (int i = 0; i < 5000; ++i) multiset.insert(i % 10);
+  ASSERT_GT(CountingAllocator<int>::live, 0);
+  multiset.clear();
+  ASSERT_EQ(CountingAllocator<int>::live, 0);
+  ASSERT_TRUE(multiset.empty());
+  multiset.insert(3);
+  ASSERT_EQ(multiset.count(3), 1U);
+}
+
+TEST(NodePoolTest, MapWithStringsAndAllocator) {
+  using Alloc = CountingAllocator<std::pair<const std::string, std::string>>;
+  s21::map<std::string, std::string, std::less<std::string>, Alloc> map;
+  for (int i = 0; i < 300; ++i) {
+    map.insert(std::to_string(i), std::string(40, 'a' + i % 26));
+  }
+  s21::map<std::string, std::string, std::less<std::string>, Alloc> copy(map);
+  map.clear();
+  ASSERT_EQ(copy.size(), 300U);
+  ASSERT_EQ(copy.at("25"), std::string(40, 'z'));
+  s21::map<std::string, std::string, std::less<std::string>, Alloc> moved(
+      std::move(copy));
+  ASSERT_EQ(moved.size(), 300U);
+  ASSERT_TRUE(copy.empty());
+  ASSERT_EQ(moved["7"], std::string(40, 'h'));
+}
+
+TEST(CachedBoundsTest, BeginAndLastFollowInsertAndErase) {
+  s21::set<int> set;
+  std::set<int> reference;
+  unsigned seed = 12345;
+  for (int step = 0; step < 4000; ++step) {
+    seed = seed * 1103515245U + 12345U;
+    int key = static_cast<int>((seed >> 8) % 500);
+    if (step % 3 == 2) {
+      auto it = set.find(key);
+      if (it != set.end()) set.erase(it);
+      reference.erase(key);
+    } else {
+      set.insert(key);
+      reference.insert(key);
+    }
+    ASSERT_EQ(set.size(), reference.size());
+    if (!reference.empty()) {
+      ASSERT_EQ(*set.begin(), *reference.begin());
+      ASSERT_EQ(*--set.end(), *reference.rbegin());
+    } else {
+      ASSERT_TRUE(set.begin() == set.end());
+    }
+  }
+}
+
+TEST(CachedBoundsTest, MultisetDuplicatesAtTheEdges) {
+  s21::multiset<int> multiset = {5, 5, 1, 9, 9};
+  multiset.insert(9);
+  multiset.insert(0);
+  ASSERT_EQ(*multiset.begin(), 0);
+  ASSERT_EQ(*--multiset.end(), 9);
+  multiset.erase(multiset.begin());
+  multiset.erase(--multiset.end());
+  ASSERT_EQ(*multiset.begin(), 1);
+  ASSERT_EQ(*--multiset.end(), 9);
+  multiset.clear();
+  ASSERT_TRUE(multiset.begin() == multiset.end());
+}
+
+TEST(BulkBuildTest, SortedInitializerListIsBalanced) {
+  s21::set<int> set = {1, 2, 3, 4, 5, 6, 7};
+  ASSERT_EQ(set.size(), 7U);
+  ASSERT_EQ(*set.tree_->begin(), 1);
+  ASSERT_EQ(set.tree_->heightTree(set.find(4).getCurNode()), 3);
+  int expected = 1;
+  for (auto value : set) ASSERT_EQ(value, expected++);
+  ASSERT_EQ(*--set.end(), 7);
+}
+
+TEST(BulkBuildTest, UnsortedInputFallsBackToInsert) {
+  s21::set<int> set = {3, 1, 2, 3, 1};
+  ASSERT_EQ(set.size(), 3U);
+  ASSERT_EQ(*set.begin(), 1);
+  s21::multiset<int> multiset = {1, 2, 2, 3, 3, 3};
+  ASSERT_EQ(multiset.size(), 6U);
+  ASSERT_EQ(multiset.count(3), 3U);
+  s21::set<int> duplicates = {1, 2, 2, 3};
+  ASSERT_EQ(duplicates.size(), 3U);
+}
+
+TEST(BulkBuildTest, LargeSortedRangeKeepsAvlInvariant) {
+  std::vector<int> keys(100000);
+  for (int i = 0; i < 100000; ++i) keys[i] = i * 2;
+  s21::set<int> set(keys.begin(), keys.end());
+  ASSERT_EQ(set.size(), keys.size());
+  ASSERT_TRUE(set.contains(4242));
+  ASSERT_FALSE(set.contains(4243));
+  set.insert(4243);
+  set.erase(set.find(0));
+  ASSERT_EQ(*set.begin(), 2);
+  ASSERT_EQ(*--set.end(), 199998);
+  ASSERT_EQ(set.size(), keys.size());
+}
+
+TEST(BulkBuildTest, SortedTagsAndMap) {
+  std::vector<std::pair<const int, std::string>> items = {
+      {1, "one"}, {2, "two"}, {3, "three"}};
+  s21::map<int, std::string> map(s21::sorted_unique, items.begin(),
+                                 items.end());
+  ASSERT_EQ(map.size(), 3U);
+  ASSERT_EQ(map.at(2), "two");
+  map.insert(0, "zero");
+  ASSERT_EQ((*map.begin()).second, "zero");
+
+  std::vector<int> sorted = {1, 1, 2, 5, 5, 5};
+  s21::multiset<int> multiset(s21::sorted_equivalent, sorted.begin(),
+                              sorted.end());
+  ASSERT_EQ(multiset.count(5), 3U);
+  ASSERT_EQ(multiset.size(), 6U);
+
+  s21::map<int, int> unsorted = {{3, 3}, {1, 1}, {2, 2}};
+  ASSERT_EQ((*unsorted.begin()).first, 1);
+}
+
+
+template <typename Node>
+bool SameShape(const Node* lhs, const Node* rhs) {
+  if (lhs == nullptr || rhs == nullptr) return lhs == rhs;
+  return lhs->value_ == rhs->value_ && lhs->height_ == rhs->height_ &&
+         SameShape(lhs->leftNode_, rhs->leftNode_) &&
+         SameShape(lhs->rightNode_, rhs->rightNode_);
+}
+
+template <typename Set>
+auto RootOf(Set& set) {
+  auto end = set.tree_->end().getCurNode();
+  auto node = set.tree_->begin().getCurNode();
+  while (node->parent_ != end) node = node->parent_;
+  return node;
+}
+
+TEST(CloneTest, CopyKeepsShapeAndIsIndependent) {
+  s21::set<int> source;
+  for (int i = 0; i < 1000; ++i) source.insert((i * 7919) % 1000);
+  s21::set<int> copy(source);
+  ASSERT_TRUE(SameShape(RootOf(source), RootOf(copy)));
+  ASSERT_EQ(*copy.begin(), 0);
+  ASSERT_EQ(*--copy.end(), 999);
+  copy.erase(copy.find(0));
+  copy.insert(1000);
+  ASSERT_TRUE(source.contains(0));
+  ASSERT_FALSE(source.contains(1000));
+  ASSERT_EQ(*copy.begin(), 1);
+  ASSERT_EQ(*--copy.end(), 1000);
+}
+
+TEST(CloneTest, AssignmentUsesOneChunk) {
+  s21::set<int, std::less<int>, CountingAllocator<int>> source;
+  for (int i = 0; i < 5000; ++i) source.insert(i);
+  s21::set<int, std::less<int>, CountingAllocator<int>> copy;
+  copy.insert(-1);
+  int before = CountingAllocator<int>::allocations;
+  copy = source;
+  ASSERT_EQ(CountingAllocator<int>::allocations - before, 1);
+  ASSERT_EQ(copy.size(), 5000U);
+  ASSERT_FALSE(copy.contains(-1));
+  int expected = 0;
+  for (auto value : copy) ASSERT_EQ(value, expected++);
+}
+
+TEST(CloneTest, MultisetAndMapAssignment) {
+  s21::multiset<int> source = {5, 1, 5, 3, 5};
+  s21::multiset<int> copy = {9};
+  copy = source;
+  ASSERT_EQ(copy.size(), 5U);
+  ASSERT_EQ(copy.count(5), 3U);
+
+  s21::map<std::string, int> config = {{"b", 2}, {"a", 1}, {"c", 3}};
+  s21::map<std::string, int> fork;
+  fork = config;
+  fork["a"] = 10;
+  fork.insert("d", 4);
+  ASSERT_EQ(config.at("a"), 1);
+  ASSERT_FALSE(config.contains("d"));
+  ASSERT_EQ(fork.at("a"), 10);
+  ASSERT_EQ(fork.size(), 4U);
+  ASSERT_EQ((*fork.begin()).first, "a");
+}
+
+
+template <typename Node>
+int CheckAugmentation(const Node* node) {
+  if (node == nullptr) return 0;
+  int left = CheckAugmentation(node->leftNode_);
+  int right = CheckAugmentation(node->rightNode_);
+  EXPECT_LE(std::abs(left - right), 1);
+  EXPECT_EQ(node->height_, std::max(left, right) + 1);
+  std::size_t size = 1U;
+  if (node->leftNode_) size += node->leftNode_->subtreeSize_;
+  if (node->rightNode_) size += node->rightNode_->subtreeSize_;
+  EXPECT_EQ(node->subtreeSize_, size);
+  return node->height_;
+}
+
+TEST(OrderStatisticTest, SelectAndRank) {
+  s21::set<int> set;
+  for (int i = 0; i < 2000; ++i) set.insert((i * 7919) % 2000 * 3);
+  CheckAugmentation(RootOf(set));
+  for (std::size_t i = 0; i < 2000; i += 37) {
+    ASSERT_EQ(*set.select(i), static_cast<int>(i * 3));
+    ASSERT_EQ(set.rank(static_cast<int>(i * 3)), i);
+    ASSERT_EQ(set.rank(static_cast<int>(i * 3) + 1), i + 1);
+  }
+  ASSERT_TRUE(set.select(2000) == set.end());
+  ASSERT_EQ(set.rank(-5), 0U);
+  ASSERT_EQ(set.distance(set.begin(), set.end()), 2000);
+  ASSERT_EQ(set.distance(set.find(30), set.find(3)), -9);
+}
+
+TEST(OrderStatisticTest, SizesSurviveErase) {
+  s21::set<int> set;
+  for (int i = 0; i < 3000; ++i) set.insert(i);
+  for (int i = 0; i < 3000; i += 3) set.erase(set.find(i));
+  for (int i = 2999; i > 1500; i -= 2) {
+    if (set.contains(i)) set.erase(set.find(i));
+  }
+  CheckAugmentation(RootOf(set));
+  std::size_t index = 0;
+  for (auto it = set.begin(); it != set.end(); ++it, ++index) {
+    ASSERT_EQ(set.distance(set.begin(), it),
+              static_cast<std::ptrdiff_t>(index));
+    ASSERT_TRUE(set.select(index) == it);
+  }
+  ASSERT_EQ(index, set.size());
+}
+
+TEST(OrderStatisticTest, MultisetCountAndMapRank) {
+  s21::multiset<int> multiset;
+  for (int i = 0; i < 10000; ++i) multiset.insert(i % 4);
+  ASSERT_EQ(multiset.count(2), 2500U);
+  ASSERT_EQ(multiset.count(7), 0U);
+  ASSERT_EQ(multiset.rank(3), 7500U);
+  ASSERT_EQ(*multiset.select(5000), 2);
+  auto range = multiset.equal_range(1);
+  ASSERT_EQ(multiset.distance(range.first, range.second), 2500);
+
+  s21::map<std::string, int> scores = {{"carol", 7}, {"alice", 3}, {"bob", 5}};
+  ASSERT_EQ(scores.rank("bob"), 1U);
+  ASSERT_EQ((*scores.select(2)).first, "carol");
+}
+
+
+template <typename Container>
+std::vector<int> ToVector(const Container& container) {
+  std::vector<int> result;
+  for (auto value : container) result.push_back(value);
+  return result;
+}
+
+TEST(SetAlgebraTest, SetOperationsMatchStd) {
+  std::vector<int> lhs, rhs;
+  for (int i = 0; i < 3000; ++i) lhs.push_back((i * 37) % 5000);
+  for (int i = 0; i < 700; ++i) rhs.push_back((i * 53) % 4000);
+  std::set<int> stdLhs(lhs.begin(), lhs.end()), stdRhs(rhs.begin(), rhs.end());
+
+  std::vector<int> expectUnion, expectInter, expectDiff;
+  std::set_union(stdLhs.begin(), stdLhs.end(), stdRhs.begin(), stdRhs.end(),
+                 std::back_inserter(expectUnion));
+  std::set_intersection(stdLhs.begin(), stdLhs.end(), stdRhs.begin(),
+                        stdRhs.end(), std::back_inserter(expectInter));
+  std::set_difference(stdLhs.begin(), stdLhs.end(), stdRhs.begin(),
+                      stdRhs.end(), std::back_inserter(expectDiff));
+
+  s21::set<int> a(lhs.begin(), lhs.end()), b(rhs.begin(), rhs.end());
+  a.unite(b);
+  ASSERT_TRUE(b.empty());
+  ASSERT_EQ(ToVector(a), expectUnion);
+  CheckAugmentation(RootOf(a));
+
+  s21::set<int> c(lhs.begin(), lhs.end()), d(rhs.begin(), rhs.end());
+  c.intersect(d);
+  ASSERT_EQ(ToVector(c), expectInter);
+  CheckAugmentation(RootOf(c));
+
+  s21::set<int> e(lhs.begin(), lhs.end()), f(rhs.begin(), rhs.end());
+  e.subtract(f);
+  ASSERT_EQ(ToVector(e), expectDiff);
+  ASSERT_EQ(*e.begin(), expectDiff.front());
+  ASSERT_EQ(*--e.end(), expectDiff.back());
+  e.insert(-1);
+  e.erase(e.find(expectDiff.back()));
+  ASSERT_EQ(e.size(), expectDiff.size());
+}
+
+TEST(SetAlgebraTest, MultisetCountsFollowStdAlgorithms) {
+  std::multiset<int> stdLhs, stdRhs;
+  s21::multiset<int> a, b, c, d, e, f;
+  for (int i = 0; i < 400; ++i) {
+    int x = (i * 7) % 23, y = (i * 11) % 17;
+    stdLhs.insert(x);
+    stdRhs.insert(y);
+    a.insert(x), c.insert(x), e.insert(x);
+    b.insert(y), d.insert(y), f.insert(y);
+  }
+  std::vector<int> expected;
+  std::set_union(stdLhs.begin(), stdLhs.end(), stdRhs.begin(), stdRhs.end(),
+                 std::back_inserter(expected));
+  a.unite(b);
+  ASSERT_EQ(ToVector(a), expected);
+
+  expected.clear();
+  std::set_intersection(stdLhs.begin(), stdLhs.end(), stdRhs.begin(),
+                        stdRhs.end(), std::back_inserter(expected));
+  c.intersect(d);
+  ASSERT_EQ(ToVector(c), expected);
+
+  expected.clear();
+  std::set_difference(stdLhs.begin(), stdLhs.end(), stdRhs.begin(),
+                      stdRhs.end(), std::back_inserter(expected));
+  e.subtract(f);
+  ASSERT_EQ(ToVector(e), expected);
+  CheckAugmentation(RootOf(e));
+
+  s21::multiset<int> g = {1, 2, 2}, h = {2, 3};
+  g.merge(h);
+  ASSERT_EQ(g.count(2), 3U);
+  ASSERT_EQ(g.size(), 5U);
+}
+
+TEST(SetAlgebraTest, LargeParallelIntersection) {
+  std::vector<int> evens, thirds;
+  for (int i = 0; i < 300000; ++i) evens.push_back(i * 2);
+  for (int i = 0; i < 200000; ++i) thirds.push_back(i * 3);
+  s21::set<int> a(evens.begin(), evens.end());
+  s21::set<int> b(thirds.begin(), thirds.end());
+  a.intersect(b);
+  ASSERT_EQ(a.size(), 100000U);
+  int expected = 0;
+  for (auto value : a) {
+    ASSERT_EQ(value, expected);
+    expected += 6;
+  }
+  CheckAugmentation(RootOf(a));
+
+  s21::map<int, int> m1 = {{1, 1}, {2, 2}}, m2 = {{2, 20}, {3, 30}};
+  m1.merge(m2);
+  ASSERT_EQ(m1.at(2), 2);
+  ASSERT_EQ(m1.at(3), 30);
+  ASSERT_TRUE(m2.empty());
+}
+
+
+TEST(RangeEraseTest, EraseIteratorRange) {
+  s21::set<int> set;
+  for (int i = 0; i < 5000; ++i) set.insert(i);
+  auto next = set.erase(set.find(1000), set.find(4000));
+  ASSERT_EQ(*next, 4000);
+  ASSERT_EQ(set.size(), 2000U);
+  ASSERT_FALSE(set.contains(1000));
+  ASSERT_FALSE(set.contains(3999));
+  ASSERT_TRUE(set.contains(999));
+  CheckAugmentation(RootOf(set));
+
+  set.erase(set.begin(), set.find(500));
+  ASSERT_EQ(*set.begin(), 500);
+  set.erase(set.find(4500), set.end());
+  ASSERT_EQ(*--set.end(), 4499);
+  ASSERT_EQ(set.size(), 1000U);
+  set.erase(set.begin(), set.begin());
+  ASSERT_EQ(set.size(), 1000U);
+  ASSERT_TRUE(set.erase(set.begin(), set.end()) == set.end());
+  ASSERT_TRUE(set.empty());
+}
+
+TEST(RangeEraseTest, ExtractKeyRange) {
+  s21::map<int, std::string> sessions;
+  for (int i = 0; i < 100; ++i) sessions.insert(i * 10, std::to_string(i));
+  auto expired = sessions.extract(95, 300);
+  ASSERT_EQ(expired.size(), 20U);
+  ASSERT_EQ((*expired.begin()).first, 100);
+  ASSERT_EQ(expired.at(290), "29");
+  ASSERT_EQ(sessions.size(), 80U);
+  ASSERT_FALSE(sessions.contains(100));
+  ASSERT_TRUE(sessions.contains(90));
+  ASSERT_TRUE(sessions.contains(300));
+  ASSERT_TRUE(sessions.extract(300, 300).empty());
+
+  s21::multiset<int> multiset = {1, 2, 2, 3, 3, 3, 4};
+  s21::multiset<int> middle = multiset.extract(2, 4);
+  ASSERT_EQ(middle.size(), 5U);
+  ASSERT_EQ(middle.count(3), 3U);
+  ASSERT_EQ(multiset.size(), 2U);
+  ASSERT_EQ(*multiset.begin(), 1);
+  ASSERT_EQ(*--multiset.end(), 4);
+  CheckAugmentation(RootOf(middle));
+  CheckAugmentation(RootOf(multiset));
+}
+
+
+struct CopyCounted {
+  static inline int copies = 0;
+  static inline int constructions = 0;
+  int value = 0;
+
+  CopyCounted() { ++constructions; }
+  explicit CopyCounted(int v) : value(v) { ++constructions; }
+  CopyCounted(const CopyCounted& other) : value(other.value) { ++copies; }
+  CopyCounted(CopyCounted&& other) noexcept : value(other.value) {}
+  CopyCounted& operator=(const CopyCounted& other) {
+    value = other.value;
+    ++copies;
+    return *this;
+  }
+  CopyCounted& operator=(CopyCounted&&) noexcept = default;
+  bool operator<(const CopyCounted& other) const {
+    return value < other.value;
+  }
+};
+
+TEST(RangeEraseTest, ExtractMovesValues) {
+  s21::map<int, std::unique_ptr<int>> owners;
+  for (int i = 0; i < 50; ++i) owners[i] = std::make_unique<int>(i * i);
+  auto middle = owners.extract(10, 20);
+  ASSERT_EQ(middle.size(), 10U);
+  ASSERT_EQ(*middle.at(12), 144);
+  ASSERT_EQ(owners.size(), 40U);
+  ASSERT_EQ(*owners.at(20), 400);
+
+  s21::set<std::unique_ptr<int>> pointers;
+  for (int i = 0; i < 8; ++i) pointers.insert(std::make_unique<int>(i));
+  auto moved = pointers.extract(*pointers.begin(), *--pointers.end());
+  ASSERT_EQ(moved.size(), 7U);
+  ASSERT_EQ(pointers.size(), 1U);
+
+  s21::set<CopyCounted> counted;
+  for (int i = 0; i < 100; ++i) counted.emplace(i);
+  CopyCounted::copies = 0;
+  ASSERT_EQ(counted.extract(CopyCounted(10), CopyCounted(90)).size(), 80U);
+  ASSERT_EQ(CopyCounted::copies, 0);
+}
+
+TEST(EmplaceTest, SetEmplaceAndMoveInsertDoNotCopy) {
+  CopyCounted::copies = 0;
+  s21::set<CopyCounted> set;
+  ASSERT_TRUE(set.emplace(3).second);
+  ASSERT_FALSE(set.emplace(3).second);
+  ASSERT_TRUE(set.insert(CopyCounted(1)).second);
+  ASSERT_EQ((*set.emplace_hint(set.end(), 5)).value, 5);
+  CopyCounted duplicate(1);
+  ASSERT_FALSE(set.insert(duplicate).second);
+  ASSERT_EQ(CopyCounted::copies, 0);
+  ASSERT_EQ(set.size(), 3U);
+  ASSERT_EQ((*set.begin()).value, 1);
+
+  s21::multiset<std::string> words;
+  std::string word = "long enough to defeat the small string buffer";
+  words.insert(std::move(word));
+  words.emplace(10, 'x');
+  words.emplace(10, 'x');
+  ASSERT_EQ(words.count(std::string(10, 'x')), 2U);
+  ASSERT_EQ(words.size(), 3U);
+}
+
+TEST(EmplaceTest, MapTryEmplaceBuildsOnlyWhenAbsent) {
+  s21::map<int, CopyCounted> map;
+  CopyCounted::copies = 0;
+  CopyCounted::constructions = 0;
+  ASSERT_TRUE(map.try_emplace(1, 10).second);
+  ASSERT_FALSE(map.try_emplace(1, 20).second);
+  ASSERT_EQ(CopyCounted::constructions, 1);
+
+  map[2].value = 7;
+  map[2].value += 1;
+  ASSERT_EQ(CopyCounted::constructions, 2);
+  ASSERT_EQ((*map.begin()).second.value, 10);
+  ASSERT_EQ(map[2].value, 8);
+  ASSERT_TRUE(map.emplace(3, CopyCounted(30)).second);
+  ASSERT_FALSE(map.emplace(std::piecewise_construct, std::forward_as_tuple(3),
+                           std::forward_as_tuple(31))
+                   .second);
+  ASSERT_EQ(CopyCounted::copies, 0);
+
+  s21::map<std::string, std::vector<int>> index;
+  std::vector<int> postings(1000, 1);
+  const int* data = postings.data();
+  index.insert(std::make_pair(std::string("key"), std::move(postings)));
+  ASSERT_EQ(index.at("key").data(), data);
+  auto results = index.insert_many(
+      std::make_pair(std::string("a"), std::vector<int>{1}),
+      std::make_pair(std::string("key"), std::vector<int>{2}));
+  ASSERT_TRUE(results[0].second);
+  ASSERT_FALSE(results[1].second);
+}
+
+
+struct HeavyValue {
+  static inline int constructions = 0;
+  std::vector<int> payload;
+  HeavyValue() : payload(64) { ++constructions; }
+  explicit HeavyValue(int n) : payload(n) { ++constructions; }
+};
+
+TEST(TransparentLookupTest, MapLookupsBuildNoMappedValue) {
+  s21::map<int, HeavyValue> map;
+  map.try_emplace(1, 8);
+  map.try_emplace(5, 8);
+  HeavyValue::constructions = 0;
+  ASSERT_TRUE(map.contains(1));
+  ASSERT_FALSE(map.contains(2));
+  ASSERT_EQ(map.at(5).payload.size(), 8U);
+  ASSERT_THROW(map.at(3), std::out_of_range);
+  ASSERT_EQ((*map.find(5)).first, 5);
+  ASSERT_TRUE(map.find(4) == map.end());
+  ASSERT_EQ((*map.lower_bound(2)).first, 5);
+  ASSERT_TRUE(map.upper_bound(5) == map.end());
+  ASSERT_EQ(map.rank(5), 1U);
+  ASSERT_EQ(map[1].payload.size(), 8U);
+  ASSERT_EQ(HeavyValue::constructions, 0);
+}
+
+TEST(TransparentLookupTest, StringViewAgainstStringKeys) {
+  s21::map<std::string, int, std::less<>> map = {{"alpha", 1}, {"beta", 2}};
+  std::string_view key = "beta";
+  ASSERT_TRUE(map.contains(key));
+  ASSERT_EQ((*map.find(key)).second, 2);
+  ASSERT_TRUE(map.find(std::string_view("gamma")) == map.end());
+  ASSERT_EQ((*map.lower_bound(std::string_view("b"))).first, "beta");
+
+  s21::set<std::string, std::less<>> set = {"x", "y"};
+  ASSERT_TRUE(set.contains(std::string_view("y")));
+  ASSERT_FALSE(set.contains(std::string_view("z")));
+  ASSERT_EQ(*set.find(std::string_view("x")), "x");
+  ASSERT_EQ(*set.lower_bound(std::string_view("xa")), "y");
+  ASSERT_TRUE(set.upper_bound(std::string_view("y")) == set.end());
+
+  s21::multiset<std::string, std::less<>> words = {"a", "b", "b", "c"};
+  ASSERT_EQ(words.count(std::string_view("b")), 2U);
+  auto range = words.equal_range(std::string_view("b"));
+  ASSERT_EQ(words.distance(range.first, range.second), 2);
+  ASSERT_EQ(*words.lower_bound(std::string_view("b")), "b");
+}
+
+TEST(TransparentLookupTest, ConstSetLookups) {
+  const s21::set<std::string, std::less<>> set = {"apple", "kiwi", "pear"};
+  s21::set<std::string, std::less<>>::const_iterator it =
+      set.find(std::string_view("kiwi"));
+  ASSERT_EQ(*it, "kiwi");
+  ASSERT_TRUE(set.find(std::string_view("fig")) == set.end());
+  ASSERT_EQ(*set.lower_bound(std::string_view("b")), "kiwi");
+  ASSERT_EQ(*set.upper_bound(std::string_view("kiwi")), "pear");
+  ASSERT_TRUE(set.lower_bound(std::string_view("q")) == set.end());
+  ASSERT_EQ(*set.lower_bound(std::string("kiwi")), "kiwi");
+  ASSERT_EQ(*set.upper_bound(std::string("apple")), "kiwi");
+
+  const s21::multiset<int> numbers = {1, 3, 3, 5};
+  ASSERT_EQ(*numbers.upper_bound(3), 5);
+}
+
+
+struct CountingLess {
+  static inline long calls = 0;
+  bool operator()(int lhs, int rhs) const {
+    ++calls;
+    return lhs < rhs;
+  }
+};
+
+TEST(HintTest, AppendAtEndDoesConstantComparisons) {
+  s21::set<int, CountingLess> set;
+  CountingLess::calls = 0;
+  for (int i = 0; i < 100000; ++i) set.insert(set.end(), i);
+  ASSERT_LE(CountingLess::calls, 2L * 100000);
+  ASSERT_EQ(set.size(), 100000U);
+  CheckAugmentation(RootOf(set));
+  int expected = 0;
+  for (auto value : set) ASSERT_EQ(value, expected++);
+}
+
+TEST(HintTest, WrongHintsFallBackAndDuplicatesAreFound) {
+  s21::set<int> set = {10, 20, 30, 40};
+  auto it = set.insert(set.find(40), 25);
+  ASSERT_EQ(*it, 25);
+  it = set.insert(set.begin(), 35);
+  ASSERT_EQ(*it, 35);
+  it = set.insert(set.find(20), 20);
+  ASSERT_EQ(*it, 20);
+  it = set.insert(set.find(10), 15);
+  ASSERT_EQ(*it, 15);
+  it = set.emplace_hint(set.end(), 5);
+  ASSERT_EQ(*set.begin(), 5);
+  ASSERT_EQ(set.size(), 8U);
+  CheckAugmentation(RootOf(set));
+
+  s21::multiset<int> multiset = {1, 3, 3, 5};
+  multiset.insert(multiset.find(5), 3);
+  multiset.insert(multiset.begin(), 9);
+  multiset.emplace_hint(multiset.end(), 0);
+  ASSERT_EQ(multiset.count(3), 3U);
+  ASSERT_EQ(ToVector(multiset), (std::vector<int>{0, 1, 3, 3, 3, 5, 9}));
+
+  s21::map<int, std::string> map;
+  auto pos = map.try_emplace(map.end(), 1, "one");
+  pos = map.try_emplace(map.end(), 2, "two");
+  map.try_emplace(pos, 1, "uno");
+  map.insert(map.end(), {3, "three"});
+  ASSERT_EQ(map.at(1), "one");
+  ASSERT_EQ(map.size(), 3U);
+}
+
+TEST(HintTest, InsertManyUsesPreviousPosition) {
+  s21::set<int, CountingLess> set;
+  CountingLess::calls = 0;
+  auto results = set.insert_many(1, 2, 3, 4, 5, 6, 7, 8, 3);
+  ASSERT_LE(CountingLess::calls, 30L);
+  ASSERT_EQ(results.size(), 9U);
+  ASSERT_FALSE(results[8].second);
+  ASSERT_EQ(set.size(), 8U);
+}
+
+
+TEST(CompactTreeTest, NodeIsHalfTheSize) {
+  using CompactInt = s21::CompactTree<int>;
+  ASSERT_EQ(CompactInt::node_size(), 20U);
+  ASSERT_LE(2U * CompactInt::node_size(), sizeof(s21::Node_tree<int>));
+}
+
+TEST(CompactTreeTest, RandomOperationsMatchStdMultiset) {
+  std::srand(41);
+  s21::compact_multiset<int> set;
+  std::multiset<int> expected;
+  for (int i = 0; i < 20000; ++i) {
+    int key = std::rand() % 2000;
+    if (std::rand() % 3) {
+      ASSERT_EQ(*set.insert(key), key);
+      expected.insert(key);
+    } else if (set.contains(key)) {
+      auto next = set.erase(set.find(key));
+      expected.erase(expected.find(key));
+      auto upper = expected.upper_bound(key);
+      if (!expected.count(key)) {
+        ASSERT_EQ(next == set.end() ? -1 : *next,
+                  upper == expected.end() ? -1 : *upper);
+      }
+    }
+  }
+  ASSERT_EQ(set.size(), expected.size());
+  ASSERT_EQ(ToVector(set),
+            std::vector<int>(expected.begin(), expected.end()));
+  ASSERT_EQ(*set.lower_bound(1000), *expected.lower_bound(1000));
+  ASSERT_EQ(*set.upper_bound(1000), *expected.upper_bound(1000));
+  ASSERT_EQ(set.count(1000), expected.count(1000));
+  // 1.44 log2(n + 2) bounds the height of any AVL tree
+  ASSERT_LE(set.height(), 20);
+}
+
+TEST(CompactTreeTest, DuplicateInsertIntoFullSetDoesNotGrow) {
+  s21::compact_set<std::string> set;
+  for (int i = 0; i < 15; ++i) set.insert(std::string(20, 'a' + i));
+  ASSERT_EQ(set.capacity(), 15U);
+  const std::string* first = &*set.begin();
+  ASSERT_FALSE(set.insert(*first).second);
+  ASSERT_FALSE(set.emplace(20, 'c').second);
+  ASSERT_EQ(set.capacity(), 15U);
+  ASSERT_EQ(&*set.begin(), first);
+  ASSERT_EQ(set.size(), 15U);
+}
+
+TEST(CompactTreeTest, SortedInsertStaysBalancedAndIteratorsStayValid) {
+  s21::compact_set<int> set;
+  set.reserve(1 << 16);
+  ASSERT_GE(set.capacity(), 1U << 16);
+  for (int i = 0; i < (1 << 16); ++i) set.insert(i);
+  ASSERT_EQ(set.height(), 17);
+  auto kept = set.find(12345);
+  for (int i = 0; i < (1 << 16); i += 2) set.erase(set.find(i));
+  ASSERT_EQ(*kept, 12345);
+  ASSERT_EQ(*--set.end(), (1 << 16) - 1);
+  ASSERT_EQ(set.size(), 1U << 15);
+}
+
+TEST(CompactTreeTest, MapBasics) {
+  s21::compact_map<std::string, int> map = {{"one", 1}, {"two", 2}};
+  map["three"] = 3;
+  ASSERT_EQ(map.at("two"), 2);
+  ASSERT_THROW(map.at("four"), std::out_of_range);
+  ASSERT_FALSE(map.insert_or_assign("one", 11).second);
+  ASSERT_FALSE(map.try_emplace("two", 22).second);
+  ASSERT_EQ(map.erase("three"), 1U);
+  ASSERT_EQ(map.erase("three"), 0U);
+
+  const s21::compact_map<std::string, int> copy = map;
+  map.clear();
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(copy.size(), 2U);
+  ASSERT_EQ(copy.at("one"), 11);
+  ASSERT_EQ((*copy.begin()).first, "one");
+  ASSERT_EQ(copy.find("two")->second, 2);
+
+  s21::compact_map<std::string, int> moved = std::move(map);
+  moved = copy;
+  moved.insert({"zero", 0});
+  ASSERT_EQ(moved.size(), 3U);
+  ASSERT_EQ(copy.size(), 2U);
+}
+
+TEST(CompactTreeTest, InsertFromOwnElementSurvivesGrowth) {
+  s21::compact_multiset<std::string> set;
+  for (int i = 0; i < 15; ++i) set.insert(std::string(20, 'a' + i));
+  ASSERT_EQ(set.capacity(), 15U);
+  set.insert(*set.begin());
+  ASSERT_EQ(set.capacity(), 31U);
+  ASSERT_EQ(set.size(), 16U);
+  ASSERT_EQ(*++set.begin(), std::string(20, 'a'));
+}
+
+
+TEST(BTreeTest, RandomOperationsMatchStdMultiset) {
+  std::srand(42);
+  s21::btree_multiset<int> set;
+  std::multiset<int> expected;
+  for (int i = 0; i < 60000; ++i) {
+    int key = std::rand() % 3000;
+    if (std::rand() % 5 < 3) {
+      ASSERT_EQ(*set.insert(key), key);
+      expected.insert(key);
+    } else {
+      auto found = set.find(key);
+      if (found == set.end()) continue;
+      auto next = set.erase(found);
+      auto upper = expected.upper_bound(key);
+      expected.erase(expected.find(key));
+      if (!expected.count(key)) {
+        ASSERT_EQ(next == set.end() ? -1 : *next,
+                  upper == expected.end() ? -1 : *upper);
+      }
+    }
+  }
+  ASSERT_EQ(set.size(), expected.size());
+  ASSERT_EQ(ToVector(set),
+            std::vector<int>(expected.begin(), expected.end()));
+  ASSERT_EQ(set.count(1500), expected.count(1500));
+  ASSERT_EQ(*set.lower_bound(1500), *expected.lower_bound(1500));
+  ASSERT_EQ(*set.upper_bound(1500), *expected.upper_bound(1500));
+  std::vector<int> backwards;
+  for (auto it = set.end(); it != set.begin();) backwards.push_back(*--it);
+  ASSERT_TRUE(std::equal(backwards.rbegin(), backwards.rend(),
+                         expected.begin(), expected.end()));
+  while (!set.empty()) set.erase(set.begin());
+  ASSERT_EQ(set.height(), 0);
+}
+
+TEST(BTreeTest, StringMapMatchesStdMap) {
+  std::srand(7);
+  s21::btree_map<std::string, int> map;
+  std::map<std::string, int> expected;
+  for (int i = 0; i < 20000; ++i) {
+    std::string key = std::to_string(std::rand() % 1500);
+    if (std::rand() % 2) {
+      map[key] = i;
+      expected[key] = i;
+    } else {
+      ASSERT_EQ(map.erase(key), expected.erase(key));
+    }
+  }
+  ASSERT_EQ(map.size(), expected.size());
+  auto it = map.begin();
+  for (const auto& [key, value] : expected) {
+    ASSERT_EQ(it->first, key);
+    ASSERT_EQ((it++)->second, value);
+  }
+  ASSERT_THROW(map.at("missing"), std::out_of_range);
+  ASSERT_FALSE(map.try_emplace(expected.begin()->first, -1).second);
+
+  const s21::btree_map<std::string, int> copy = map;
+  map.clear();
+  ASSERT_EQ(copy.size(), expected.size());
+  ASSERT_EQ(copy.at(expected.begin()->first), expected.begin()->second);
+  ASSERT_EQ(copy.lower_bound("")->first, expected.begin()->first);
+}
+
+TEST(BTreeTest, SortedLoadFillsLeavesAndStaysShallow) {
+  std::vector<int> keys(1 << 20);
+  for (int i = 0; i < (1 << 20); ++i) keys[i] = i;
+  s21::btree_set<int> set(keys.begin(), keys.end());
+  ASSERT_EQ(set.size(), keys.size());
+  // 2^14 full leaves of 64 ints under inner nodes of 11 to 22 children; a
+  // binary tree would be 21 levels deep
+  ASSERT_LE(set.height(), 5);
+  ASSERT_EQ(*set.find(777777), 777777);
+  auto next = set.erase(set.find(10), set.find(1000));
+  ASSERT_EQ(*next, 1000);
+  ASSERT_EQ(*--next, 9);
+  ASSERT_EQ(set.size(), keys.size() - 990U);
+  ASSERT_FALSE(set.contains(500));
+  ASSERT_EQ(set.erase(1000), 1U);
+  ASSERT_EQ(*set.lower_bound(500), 1001);
+}
+
+TEST(BTreeTest, StorageIsChosenByTag) {
+  using Pair = std::pair<const int, int>;
+  using Fast = s21::ordered_map<int, int, std::less<int>,
+                                std::allocator<Pair>, s21::btree_tag>;
+  using Plain = s21::ordered_map<int, int>;
+  ASSERT_TRUE((std::is_same_v<Fast, s21::btree_map<int, int>>));
+  ASSERT_TRUE((std::is_same_v<Plain, s21::map<int, int>>));
+  ASSERT_TRUE((std::is_same_v<s21::ordered_set<int, std::less<int>,
+                                               std::allocator<int>,
+                                               s21::btree_tag>,
+                              s21::btree_set<int>>));
+
+  Fast fast = {{3, 30}, {1, 10}, {2, 20}};
+  Plain plain = {{3, 30}, {1, 10}, {2, 20}};
+  auto fastIt = fast.begin();
+  for (auto it = plain.begin(); it != plain.end(); ++it, ++fastIt) {
+    ASSERT_EQ((*it).second, fastIt->second);
+  }
+  s21::btree_multiset<int> a = {1, 1, 2}, b = {1, 3};
+  a.merge(b);
+  ASSERT_TRUE(b.empty());
+  ASSERT_EQ(a.count(1), 3U);
+}
+
+
+TEST(FlatTest, SetBatchInsertMatchesStdSet) {
+  std::srand(43);
+  s21::flat_set<int> set = {5, 3, 5, 1};
+  std::set<int> expected = {1, 3, 5};
+  for (int round = 0; round < 20; ++round) {
+    std::vector<int> batch;
+    for (int i = 0; i < 500; ++i) batch.push_back(std::rand() % 4000);
+    set.insert(batch.begin(), batch.end());
+    expected.insert(batch.begin(), batch.end());
+    ASSERT_TRUE(set.insert(round * 1000 + 1).second ==
+                expected.insert(round * 1000 + 1).second);
+  }
+  ASSERT_EQ(ToVector(set),
+            std::vector<int>(expected.begin(), expected.end()));
+  ASSERT_EQ(*set.lower_bound(2000), *expected.lower_bound(2000));
+  ASSERT_EQ(*set.upper_bound(2000), *expected.upper_bound(2000));
+  ASSERT_EQ(set.erase(*set.begin()), 1U);
+  ASSERT_EQ(set.size(), expected.size() - 1U);
+
+  std::vector<int> keys = set.extract();
+  ASSERT_TRUE(set.empty());
+  ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+  s21::flat_set<int> adopted(s21::sorted_unique, std::move(keys));
+  ASSERT_EQ(adopted.size(), expected.size() - 1U);
+  ASSERT_TRUE(adopted.contains(*expected.rbegin()));
+}
+
+TEST(FlatTest, MultisetKeepsInsertionOrderOfEqualKeys) {
+  using Entry = std::pair<int, int>;
+  struct ByFirst {
+    bool operator()(const Entry& lhs, const Entry& rhs) const {
+      return lhs.first < rhs.first;
+    }
+  };
+  s21::flat_multiset<Entry, ByFirst> set = {{2, 0}, {1, 0}, {2, 1}};
+  set.insert({{2, 2}, {0, 0}, {2, 3}});
+  set.insert(Entry{2, 4});
+  ASSERT_EQ(set.count({2, -1}), 5U);
+  int expected = 0;
+  for (auto it = set.lower_bound({2, -1}); it != set.end(); ++it) {
+    ASSERT_EQ(it->second, expected++);
+  }
+  s21::flat_multiset<Entry, ByFirst> other = {{2, 5}};
+  set.merge(other);
+  ASSERT_TRUE(other.empty());
+  ASSERT_EQ((--set.end())->second, 5);
+}
+
+TEST(FlatTest, MapParallelArrays) {
+  s21::flat_map<std::string, int> map = {{"b", 2}, {"a", 1}, {"b", 20}};
+  ASSERT_EQ(map.size(), 2U);
+  ASSERT_EQ(map.at("b"), 2);
+  map.insert({{"d", 4}, {"c", 3}, {"a", 10}});
+  ASSERT_EQ(map.keys(), (std::vector<std::string>{"a", "b", "c", "d"}));
+  ASSERT_EQ(map.values(), (std::vector<int>{1, 2, 3, 4}));
+
+  map["e"] = 5;
+  map.begin()->second = 100;
+  ASSERT_EQ(map.at("a"), 100);
+  ASSERT_FALSE(map.insert_or_assign("c", 30).second);
+  ASSERT_EQ((*map.find("c")).second, 30);
+  ASSERT_THROW(map.at("z"), std::out_of_range);
+  ASSERT_EQ(map.erase("b"), 1U);
+  ASSERT_EQ(map.lower_bound("b")->first, "c");
+  ASSERT_EQ(map.end() - map.begin(), 4);
+  ASSERT_EQ(map.begin()[3].first, "e");
+
+  s21::flat_map<std::string, int> adopted({"y", "x", "y"}, {1, 2, 3});
+  ASSERT_EQ(adopted.keys(), (std::vector<std::string>{"x", "y"}));
+  ASSERT_EQ(adopted.values(), (std::vector<int>{2, 1}));
+  ASSERT_THROW(
+      (s21::flat_map<std::string, int>({"x"}, std::vector<int>{})),
+      std::invalid_argument);
+
+  s21::flat_map<std::string, int> other = {{"a", -1}, {"q", 17}};
+  map.merge(other);
+  ASSERT_EQ(map.at("q"), 17);
+  ASSERT_EQ(map.at("a"), 100);
+  ASSERT_EQ(other.size(), 1U);
+  const auto& constMap = map;
+  ASSERT_EQ(constMap.find("q")->second, 17);
+}
+
+TEST(FlatTest, MapOfBool) {
+  s21::flat_map<int, bool> flags = {{3, true}, {1, false}};
+  flags[2] = true;
+  flags.at(1) = true;
+  flags.begin()[2].second = false;
+  flags.insert({{5, true}, {4, false}});
+  ASSERT_EQ(flags.values(), (std::vector<bool>{true, true, false, false,
+                                               true}));
+  ASSERT_TRUE(flags.find(2)->second);
+  for (auto entry : flags) entry.second = !entry.second;
+  const auto& constFlags = flags;
+  ASSERT_FALSE(constFlags.at(1));
+  ASSERT_TRUE(constFlags.at(3));
+  ASSERT_TRUE((*constFlags.find(4)).second);
+  ASSERT_EQ(flags.erase(3), 1U);
+  ASSERT_EQ(flags.size(), 4U);
+}
+
+
+TEST(FrozenTest, SetMatchesStdSet) {
+  std::srand(44);
+  for (int n : {0, 1, 2, 3, 7, 8, 100, 1000}) {
+    s21::set<int> source;
+    std::set<int> expected;
+    for (int i = 0; i < n; ++i) {
+      int value = std::rand() % (4 * n);
+      source.insert(value);
+      expected.insert(value);
+    }
+    s21::frozen_set<int> frozen(source);
+    ASSERT_EQ(frozen.size(), expected.size());
+    ASSERT_EQ(ToVector(frozen), std::vector<int>(expected.begin(),
+                                                 expected.end()));
+    std::vector<int> backwards;
+    for (auto it = frozen.end(); it != frozen.begin();) {
+      backwards.push_back(*--it);
+    }
+    ASSERT_TRUE(std::equal(backwards.begin(), backwards.end(),
+                           expected.rbegin(), expected.rend()));
+    for (int key = -1; key <= 4 * n; ++key) {
+      auto lower = expected.lower_bound(key);
+      auto upper = expected.upper_bound(key);
+      auto frozenLower = frozen.lower_bound(key);
+      auto frozenUpper = frozen.upper_bound(key);
+      ASSERT_EQ(frozenLower == frozen.end(), lower == expected.end());
+      ASSERT_EQ(frozenUpper == frozen.end(), upper == expected.end());
+      if (lower != expected.end()) {
+        ASSERT_EQ(*frozenLower, *lower);
+      }
+      if (upper != expected.end()) {
+        ASSERT_EQ(*frozenUpper, *upper);
+      }
+      ASSERT_EQ(frozen.contains(key), expected.count(key) == 1U);
+      ASSERT_EQ(frozen.count(key), expected.count(key));
+    }
+  }
+}
+
+TEST(FrozenTest, SetFromRangeAndComparator) {
+  std::vector<std::string> words = {"pear", "fig", "apple", "fig", "kiwi"};
+  s21::frozen_set<std::string, std::greater<std::string>> frozen(
+      words.begin(), words.end());
+  ASSERT_EQ(std::vector<std::string>(frozen.begin(), frozen.end()),
+            (std::vector<std::string>{"pear", "kiwi", "fig", "apple"}));
+  ASSERT_EQ(*frozen.lower_bound("grape"), "fig");
+  ASSERT_EQ(frozen.find("plum"), frozen.end());
+  ASSERT_EQ(*frozen.find("kiwi"), "kiwi");
+
+  std::vector<int> sorted = {1, 4, 9, 16, 25};
+  s21::frozen_set<int> squares(s21::sorted_unique, sorted.begin(),
+                               sorted.end());
+  ASSERT_EQ(*squares.upper_bound(9), 16);
+  ASSERT_EQ(squares.upper_bound(25), squares.end());
+  ASSERT_TRUE(s21::frozen_set<int>().empty());
+}
+
+TEST(FrozenTest, MapFromMap) {
+  s21::map<int, std::string> source = {{3, "c"}, {1, "a"}, {2, "b"}};
+  s21::frozen_map<int, std::string> frozen(source);
+  ASSERT_EQ(frozen.size(), 3U);
+  ASSERT_EQ(frozen.at(2), "b");
+  ASSERT_THROW(frozen.at(4), std::out_of_range);
+  ASSERT_EQ(frozen.find(3)->second, "c");
+  ASSERT_EQ(frozen.find(0), frozen.end());
+  ASSERT_EQ((*frozen.lower_bound(0)).first, 1);
+  std::string joined;
+  for (auto entry : frozen) joined += entry.second;
+  ASSERT_EQ(joined, "abc");
+
+  std::vector<std::pair<int, int>> pairs = {{5, 1}, {2, 2}, {5, 3}};
+  s21::frozen_map<int, int> fromRange(pairs.begin(), pairs.end());
+  ASSERT_EQ(fromRange.size(), 2U);
+  ASSERT_EQ(fromRange.at(5), 1);
+  ASSERT_EQ((--fromRange.end())->first, 5);
+}
+
+
+TEST(ConcurrentMapTest, SingleThreadOperations) {
+  s21::concurrent_map<int, std::string> map = {{1, "a"}, {2, "b"}};
+  ASSERT_EQ(map.shard_count(), decltype(map)::kDefaultShards);
+  ASSERT_EQ(map.size(), 2U);
+  ASSERT_EQ(map.find(1).value(), "a");
+  ASSERT_FALSE(map.find(3).has_value());
+  ASSERT_FALSE(map.insert(1, "z"));
+  ASSERT_FALSE(map.insert_or_assign(1, "c"));
+  ASSERT_TRUE(map.insert_or_assign(3, "d"));
+  ASSERT_EQ(map.find(1).value(), "c");
+  ASSERT_EQ(map.erase(2), 1U);
+  ASSERT_EQ(map.erase(2), 0U);
+  ASSERT_FALSE(map.contains(2));
+
+  std::map<int, std::string> seen;
+  map.for_each([&seen, &map](int key, const std::string& value) {
+    seen[key] = value;
+    map.erase(key);  // the shard is not locked while visiting
+  });
+  ASSERT_EQ(seen, (std::map<int, std::string>{{1, "c"}, {3, "d"}}));
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ((s21::concurrent_map<int, int>(5).shard_count()), 8U);
+}
+
+TEST(ConcurrentMapTest, ParallelReadersAndWriters) {
+  s21::concurrent_map<int, int> map(8);
+  const int kThreads = 4;
+  const int kKeys = 2000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&map, t] {
+      for (int i = 0; i < kKeys; ++i) {
+        int key = i * kThreads + t;
+        map.insert_or_assign(key, key);
+        // Four reads per write, as in a read-mostly cache
+        for (int r = 0; r < 4; ++r) {
+          auto value = map.find(key - r * kThreads);
+          if (value && *value != key - r * kThreads) std::abort();
+        }
+        if (i % 2) map.erase(key);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  ASSERT_EQ(map.size(), static_cast<std::size_t>(kThreads * kKeys / 2));
+  long sum = 0;
+  map.for_each([&sum](int key, int value) {
+    ASSERT_EQ(key, value);
+    ASSERT_EQ(key / kThreads % 2, 0);
+    sum += value;
+  });
+  ASSERT_GT(sum, 0);
+}
+
+
+TEST(ConcurrentSetTest, SingleThreadOperations) {
+  s21::concurrent_set<int> set = {5, 1, 3, 3, 9};
+  ASSERT_EQ(set.size(), 4U);
+  ASSERT_EQ(ToVector(set), (std::vector<int>{1, 3, 5, 9}));
+  ASSERT_FALSE(set.insert(5).second);
+  auto inserted = set.insert(4);
+  ASSERT_TRUE(inserted.second);
+  ASSERT_EQ(*inserted.first, 4);
+  ASSERT_EQ(*set.lower_bound(2), 3);
+  ASSERT_EQ(*set.lower_bound(3), 3);
+  ASSERT_EQ(*set.upper_bound(3), 4);
+  ASSERT_TRUE(set.upper_bound(9) == set.end());
+  ASSERT_TRUE(set.find(7) == set.end());
+  ASSERT_EQ(set.erase(3), 1U);
+  ASSERT_EQ(set.erase(3), 0U);
+  ASSERT_FALSE(set.contains(3));
+  ASSERT_EQ(ToVector(set), (std::vector<int>{1, 4, 5, 9}));
+  set.clear();
+  ASSERT_TRUE(set.empty());
+  ASSERT_TRUE(set.begin() == set.end());
+}
+
+TEST(ConcurrentSetTest, IteratorOutlivesErase) {
+  s21::concurrent_set<std::string> set = {"a", "b", "c"};
+  auto it = set.find("b");
+  ASSERT_EQ(set.erase("b"), 1U);
+  // Many more erases give the epoch every chance to advance
+  for (int i = 0; i < 1000; ++i) {
+    set.insert(std::to_string(i));
+    set.erase(std::to_string(i));
+  }
+  ASSERT_EQ(*it, "b");
+  ++it;
+  ASSERT_EQ(*it, "c");
+  ASSERT_EQ(set.size(), 2U);
+}
+
+TEST(ConcurrentSetTest, CopiedIteratorOutlivesOriginal) {
+  s21::concurrent_set<std::string> set;
+  for (int i = 0; i < 1000; ++i) set.insert(std::to_string(i));
+  auto it = set.find("500");
+  ASSERT_EQ(set.erase("500"), 1U);
+  for (int i = 0; i < 200; ++i) set.erase(std::to_string(i));
+  auto copy = it;
+  it = decltype(it)();
+  for (int i = 200; i < 400; ++i) set.erase(std::to_string(i));
+  ASSERT_EQ(*copy, "500");
+  ASSERT_EQ(*++copy, "501");
+}
+
+TEST(ConcurrentSetTest, ManyLiveIterators) {
+  s21::concurrent_set<int> set;
+  for (int i = 0; i < 1000; ++i) set.insert(i);
+  std::vector<s21::concurrent_set<int>::iterator> iterators;
+  for (int i = 0; i < 1000; ++i) iterators.push_back(set.find(i));
+  for (int i = 0; i < 1000; i += 2) set.erase(i);
+  for (int i = 0; i < 1000; ++i) ASSERT_EQ(*iterators[i], i);
+  iterators.clear();
+  ASSERT_EQ(set.size(), 500U);
+}
+
+TEST(ConcurrentSetTest, ParallelInsertEraseAndScan) {
+  s21::concurrent_set<int> set;
+  const int kThreads = 4;
+  const int kKeys = 3000;
+  std::atomic<bool> done{false};
+  std::thread scanner([&set, &done] {
+    while (!done.load()) {
+      int previous = -1;
+      for (int key : set) {
+        if (key <= previous) std::abort();
+        previous = key;
+      }
+    }
+  });
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&set, t] {
+      for (int i = 0; i < kKeys; ++i) {
+        int key = i * kThreads + t;
+        if (!set.insert(key).second) std::abort();
+        if (i % 3 == 0 && set.erase(key) != 1U) std::abort();
+        if (i % 3 == 1 && !set.contains(key)) std::abort();
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  done = true;
+  scanner.join();
+  std::vector<int> expected;
+  for (int key = 0; key < kThreads * kKeys; ++key) {
+    if (key / kThreads % 3) expected.push_back(key);
+  }
+  ASSERT_EQ(set.size(), expected.size());
+  ASSERT_EQ(ToVector(set), expected);
+}
+
+TEST(ConcurrentOrderedMapTest, SingleThreadOperations) {
+  s21::concurrent_ordered_map<int, std::string> map = {{2, "b"}, {1, "a"}};
+  ASSERT_EQ(map.size(), 2U);
+  ASSERT_EQ(map.at(1), "a");
+  ASSERT_THROW(map.at(3), std::out_of_range);
+  ASSERT_FALSE(map.insert(1, "z").second);
+  ASSERT_TRUE(map.insert(3, "c").second);
+  ASSERT_TRUE(map.try_emplace(4, 2, 'd').second);
+  ASSERT_EQ(map.find(4)->second, "dd");
+  ASSERT_EQ(map.lower_bound(2)->first, 2);
+  ASSERT_EQ(map.upper_bound(2)->first, 3);
+  ASSERT_EQ(map.erase(2), 1U);
+  ASSERT_FALSE(map.contains(2));
+  std::vector<int> keys;
+  for (const auto& item : map) keys.push_back(item.first);
+  ASSERT_EQ(keys, (std::vector<int>{1, 3, 4}));
+}
+
+TEST(ConcurrentOrderedMapTest, ParallelReplace) {
+  s21::concurrent_ordered_map<int, int> map;
+  const int kThreads = 4;
+  const int kRounds = 2000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&map, t] {
+      for (int i = 0; i < kRounds; ++i) {
+        // Every thread keeps rewriting the same small key range
+        int key = i % 64;
+        map.erase(key);
+        map.insert(key, key * 10 + t);
+        auto it = map.find(key);
+        if (it != map.end() && it->second / 10 != key) std::abort();
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  ASSERT_EQ(map.size(), 64U);
+  int expected = 0;
+  for (const auto& item : map) {
+    ASSERT_EQ(item.first, expected++);
+    ASSERT_EQ(item.second / 10, item.first);
+  }
+}
+
+
+TEST(PersistentMapTest, VersionsAreIndependent) {
+  s21::persistent_map<int, std::string> v1 = {{1, "a"}, {2, "b"}, {3, "c"}};
+  s21::persistent_map<int, std::string> v2 = v1;
+  ASSERT_TRUE(v2.same_version(v1));
+  ASSERT_TRUE(v2.insert(4, "d").second);
+  ASSERT_FALSE(v2.insert(1, "z").second);
+  ASSERT_FALSE(v2.insert_or_assign(2, "B").second);
+  ASSERT_EQ(v2.erase(3), 1U);
+  ASSERT_EQ(v2.erase(3), 0U);
+  ASSERT_FALSE(v2.same_version(v1));
+
+  ASSERT_EQ(v1.size(), 3U);
+  ASSERT_EQ(v1.at(2), "b");
+  ASSERT_TRUE(v1.contains(3));
+  ASSERT_FALSE(v1.contains(4));
+  ASSERT_EQ(v2.size(), 3U);
+  ASSERT_EQ(v2.at(2), "B");
+  ASSERT_THROW(v2.at(3), std::out_of_range);
+
+  std::vector<int> keys;
+  for (const auto& item : v2) keys.push_back(item.first);
+  ASSERT_EQ(keys, (std::vector<int>{1, 2, 4}));
+  ASSERT_EQ(v2.lower_bound(3)->first, 4);
+  ASSERT_EQ(v2.upper_bound(1)->first, 2);
+  ASSERT_TRUE(v2.upper_bound(4) == v2.end());
+  ASSERT_EQ((--v2.end())->first, 4);
+  ASSERT_TRUE(v2.try_emplace(0, 3, 'x').second);
+  ASSERT_EQ(v2.begin()->second, "xxx");
+  ASSERT_TRUE(v1.emplace(5, "e").second);
+  ASSERT_EQ(v1.size(), 4U);
+  ASSERT_EQ(v2.size(), 4U);
+}
+
+TEST(PersistentMapTest, MatchesMapUnderRandomUpdates) {
+  s21::persistent_map<int, int> current;
+  std::map<int, int> expected;
+  std::vector<s21::persistent_map<int, int>> versions;
+  std::vector<std::map<int, int>> expectedVersions;
+  std::mt19937 random(7);
+  for (int i = 0; i < 4000; ++i) {
+    int key = static_cast<int>(random() % 500);
+    if (random() % 3) {
+      current.insert_or_assign(key, i);
+      expected[key] = i;
+    } else {
+      ASSERT_EQ(current.erase(key), expected.erase(key));
+    }
+    if (i % 400 == 0) {
+      versions.push_back(current);
+      expectedVersions.push_back(expected);
+    }
+  }
+  versions.push_back(current);
+  expectedVersions.push_back(expected);
+  for (std::size_t v = 0; v < versions.size(); ++v) {
+    ASSERT_EQ(versions[v].size(), expectedVersions[v].size());
+    ASSERT_TRUE(std::equal(versions[v].begin(), versions[v].end(),
+                           expectedVersions[v].begin()));
+    std::vector<std::pair<const int, int>> backwards;
+    for (auto it = versions[v].end(); it != versions[v].begin();) {
+      backwards.push_back(*--it);
+    }
+    ASSERT_TRUE(std::equal(backwards.begin(), backwards.end(),
+                           expectedVersions[v].rbegin()));
+  }
+  // AVL bound: height < 1.45 * log2(n + 2)
+  ASSERT_LE(current.height(), 13);
+}
+
+TEST(PersistentMapTest, UpdateSharesUntouchedNodes) {
+  AllocationCounters::live = 0;
+  {
+    using Alloc = CountingAllocator<std::pair<const int, int>>;
+    using Map = s21::persistent_map<int, int, std::less<int>, Alloc>;
+    Map base;
+    for (int i = 0; i < 1024; ++i) base.insert(i, i);
+    int nodes = AllocationCounters::live;
+    ASSERT_EQ(nodes, 1024);
+
+    std::vector<Map> versions;
+    for (int i = 0; i < 100; ++i) {
+      versions.push_back(versions.empty() ? base : versions.back());
+      versions.back().insert_or_assign(i * 10, -i);
+    }
+    // One path per version instead of 1024 nodes
+    ASSERT_LE(AllocationCounters::live - nodes, 100 * (base.height() + 2));
+    ASSERT_EQ(base.at(10), 10);
+    ASSERT_EQ(versions.back().at(10), -1);
+
+    base.clear();
+    versions.erase(versions.begin(), versions.end() - 1);
+    ASSERT_EQ(versions.back().size(), 1024U);
+  }
+  ASSERT_EQ(AllocationCounters::live, 0);
+}
+
+
+TEST(CountedMultisetTest, RunsExpandOnIteration) {
+  s21::counted_multiset<int> set = {3, 1, 3, 2, 3, 1};
+  ASSERT_EQ(set.size(), 6U);
+  ASSERT_EQ(set.distinct_count(), 3U);
+  ASSERT_EQ(ToVector(set), (std::vector<int>{1, 1, 2, 3, 3, 3}));
+  ASSERT_EQ(set.count(3), 3U);
+  ASSERT_EQ(set.count(4), 0U);
+  ASSERT_EQ(std::distance(set.lower_bound(2), set.upper_bound(3)), 4);
+
+  auto range = set.equal_range(3);
+  ASSERT_EQ(std::distance(range.first, range.second), 3);
+  ASSERT_TRUE(range.second == set.end());
+  range = set.equal_range(0);
+  ASSERT_TRUE(range.first == range.second);
+  ASSERT_EQ(*range.first, 1);
+
+  std::vector<int> backwards;
+  for (auto it = set.end(); it != set.begin();) backwards.push_back(*--it);
+  ASSERT_EQ(backwards, (std::vector<int>{3, 3, 3, 2, 1, 1}));
+
+  auto it = set.insert(2);
+  ASSERT_EQ(*it, 2);
+  ASSERT_EQ(*++it, 3);
+  ASSERT_TRUE(set.insert(5, 0U) == set.end());
+  ASSERT_EQ(*set.insert(5, 1000000000U), 5);
+  ASSERT_EQ(set.size(), 1000000007U);
+  ASSERT_EQ(set.distinct_count(), 4U);
+  ASSERT_EQ(set.erase(5), 1000000000U);
+  ASSERT_EQ(set.erase(5), 0U);
+}
+
+TEST(CountedMultisetTest, EraseOneCopyAtATime) {
+  s21::counted_multiset<std::string> set = {"a", "b", "b", "c"};
+  auto it = set.erase(set.find("b"));
+  ASSERT_EQ(*it, "b");
+  it = set.erase(it);
+  ASSERT_EQ(*it, "c");
+  ASSERT_FALSE(set.contains("b"));
+  ASSERT_EQ(set.distinct_count(), 2U);
+  it = set.erase(it);
+  ASSERT_TRUE(it == set.end());
+  ASSERT_EQ(*set.emplace(3, 'x'), "xxx");
+  ASSERT_EQ(std::vector<std::string>(set.begin(), set.end()),
+            (std::vector<std::string>{"a", "xxx"}));
+  set.clear();
+  ASSERT_TRUE(set.empty());
+  ASSERT_TRUE(set.begin() == set.end());
+}
+
+TEST(CountedMultisetTest, ConstLookups) {
+  const s21::counted_multiset<int> set = {4, 2, 4, 8};
+  ASSERT_EQ(std::vector<int>(set.begin(), set.end()),
+            (std::vector<int>{2, 4, 4, 8}));
+  ASSERT_EQ(*set.find(4), 4);
+  ASSERT_TRUE(set.find(5) == set.end());
+  ASSERT_EQ(set.count(4), 2U);
+  ASSERT_TRUE(set.contains(8));
+  ASSERT_EQ(*set.lower_bound(3), 4);
+  ASSERT_EQ(*set.upper_bound(4), 8);
+  ASSERT_EQ(std::distance(set.equal_range(4).first, set.end()), 3);
+
+  const s21::map<std::string, int, std::less<>> map = {{"a", 1}, {"c", 3}};
+  s21::map<std::string, int, std::less<>>::const_iterator it =
+      map.find(std::string_view("c"));
+  ASSERT_EQ(it->second, 3);
+  ASSERT_EQ(map.lower_bound(std::string("b"))->first, "c");
+  ASSERT_TRUE(map.upper_bound(std::string_view("c")) == map.end());
+}
+
+
+TEST(TreeTraversalTest, CloneWalkAndTeardownWithoutRecursion) {
+  s21::set<std::string> set;
+  for (int i = 0; i < 50000; ++i) {
+    set.insert(std::to_string(i * 7919 % 50000));
+  }
+  s21::set<std::string> copy = set;
+  ASSERT_EQ(copy.size(), set.size());
+  auto original = set.begin();
+  for (const auto& value : copy) ASSERT_EQ(value, *original++);
+  // Same shape: every subtree has the same measured height
+  for (int i = 0; i < 50000; i += 997) {
+    std::string key = std::to_string(i);
+    ASSERT_EQ(copy.tree_->heightTree(copy.find(key).getCurNode()),
+              set.tree_->heightTree(set.find(key).getCurNode()));
+  }
+
+  // Drops a subtree of a live tree and then the whole tree
+  s21::set<std::string> range = copy.extract("1", "5");
+  ASSERT_EQ(range.size() + copy.size(), set.size());
+  ASSERT_EQ(*range.begin(), "1");
+  ASSERT_FALSE(copy.contains("2"));
+  ASSERT_TRUE(copy.contains("5"));
+  copy.clear();
+  ASSERT_TRUE(copy.empty());
+  copy.insert("x");
+  ASSERT_EQ(copy.size(), 1U);
+
+  s21::set<int> small = {1, 2, 3, 4, 5, 6, 7};
+  testing::internal::CaptureStdout();
+  small.tree_->printTree();
+  ASSERT_EQ(testing::internal::GetCapturedStdout(),
+            "==== TREE ====\nroot -> 4 <- root \n1 2 3 4 5 6 7 \n"
+            "==== TREE ====\n");
+}
+
+
+// Picks its order when constructed, so two trees can disagree
+struct ModeLess {
+  static inline bool descending = false;
+  bool reverse = descending;
+  bool operator()(int a, int b) const { return reverse ? b < a : a < b; }
+};
+
+TEST(TreeSwapTest, ComparatorTravelsWithTheNodes) {
+  ModeLess::descending = false;
+  s21::Tree<int, ModeLess> ascending;
+  ModeLess::descending = true;
+  s21::Tree<int, ModeLess> descending;
+  ModeLess::descending = false;
+  for (int i : {2, 4, 6}) {
+    ascending.insert(i);
+    descending.insert(i);
+  }
+  ascending.swap(descending);
+  ascending.insert(5);
+  descending.insert(5);
+  ASSERT_EQ(ToVector(ascending), (std::vector<int>{6, 5, 4, 2}));
+  ASSERT_EQ(ToVector(descending), (std::vector<int>{2, 4, 5, 6}));
+
+  s21::Tree<int, ModeLess> moved(std::move(ascending));
+  moved.insert(3);
+  ASSERT_EQ(ToVector(moved), (std::vector<int>{6, 5, 4, 3, 2}));
+  s21::Tree<int, ModeLess> assigned;
+  assigned = std::move(moved);
+  assigned.insert(1);
+  ASSERT_EQ(ToVector(assigned), (std::vector<int>{6, 5, 4, 3, 2, 1}));
+}
@@ -17,6 +17,7 @@ void S21Matrix::SetRows(int rows_new)  // done
   }
 
   S21Matrix matrix_new(rows_new, cols_);
+  matrix_new.SetCopyOnWrite(cow_);
   for (int i = 0; i < std::min(rows_, rows_new); i++) {
     for (int j = 0; j < cols_; j++) {
       matrix_new.matrix_[i][j] = matrix_[i][j];
@@ -33,14 +34,63 @@ void S21Matrix::SetCols(int cols_new)  // done
   }
 
   S21Matrix matrix_new(rows_, cols_new);
+  matrix_new.SetCopyOnWrite(cow_);
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < std::min(cols_, cols_new); j++) {
-      matrix_new(i, j) = (*this)(i, j);
+      matrix_new.matrix_[i][j] = matrix_[i][j];
     }
   }
   *this = std::move(matrix_new);
 }
 
+void S21Matrix::SetCopyOnWrite(bool enabled) {
+  if (enabled && !cow_) {
+    refs_ = new std::atomic<int>(1);
+  } else if (!enabled && cow_) {
+    Detach();
+    delete refs_;
+    refs_ = nullptr;
+  }
+  cow_ = enabled;
+}
+
+bool S21Matrix::IsCopyOnWrite() const { return cow_; }
+
+bool S21Matrix::IsShared() const { return refs_ && refs_->load() > 1; }
+
+// Drops this matrix's reference to its buffer, freeing it if it was the last.
+void S21Matrix::Release() {
+  if (refs_ && refs_->fetch_sub(1) > 1) {
+    refs_ = nullptr;
+    matrix_ = nullptr;
+    return;
+  }
+  delete refs_;
+  refs_ = nullptr;
+  if (matrix_) {
+    for (int i = 0; i < rows_; i++) {
+      if (matrix_[i]) delete[] matrix_[i];
+    }
+    delete[] matrix_;
+  }
+  matrix_ = nullptr;
+}
+
+// Gives this matrix a private copy of a shared buffer before it is modified.
+void S21Matrix::Detach() {
+  if (!IsShared()) {
+    return;
+  }
+  double** matrix_new = new double*[rows_];
+  for (int i = 0; i < rows_; i++) {
+    matrix_new[i] = new double[cols_];
+    std::copy(matrix_[i], matrix_[i] + cols_, matrix_new[i]);
+  }
+  Release();
+  matrix_ = matrix_new;
+  refs_ = new std::atomic<int>(1);
+}
+
 S21Matrix::S21Matrix()  // done
 {
   rows_ = 0;
@@ -65,12 +115,19 @@ S21Matrix::S21Matrix(int rows, int cols)  // done?
 }
 
 S21Matrix::S21Matrix(const S21Matrix& other)
-    : S21Matrix(other.rows_, other.cols_)  // done?
-{
-  for (int i = 0; i < this->rows_; i++) {
-    for (int j = 0; j < this->cols_; j++) {
-      this->matrix_[i][j] = other.matrix_[i][j];
-    }
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      matrix_(other.matrix_),
+      refs_(other.refs_),
+      cow_(other.cow_) {
+  if (cow_) {
+    refs_->fetch_add(1);
+    return;
+  }
+  matrix_ = new double*[rows_];
+  for (int i = 0; i < rows_; i++) {
+    matrix_[i] = new double[cols_];
+    std::copy(other.matrix_[i], other.matrix_[i] + cols_, matrix_[i]);
   }
 }
 
@@ -79,6 +136,8 @@ S21Matrix::S21Matrix(S21Matrix&& other)  // noexcept //done
   cols_ = std::move(other.cols_);
   rows_ = std::move(other.rows_);
   matrix_ = std::move(other.matrix_);
+  refs_ = std::exchange(other.refs_, nullptr);
+  cow_ = std::exchange(other.cow_, false);
   other.cols_ = 0;
   other.rows_ = 0;
   other.matrix_ = nullptr;
@@ -86,12 +145,7 @@ S21Matrix::S21Matrix(S21Matrix&& other)  // noexcept //done
 
 S21Matrix::~S21Matrix()  // done
 {
-  if (matrix_) {
-    for (int i = 0; i < rows_; i++) {
-      if (matrix_[i]) delete[] matrix_[i];
-    }
-    delete[] matrix_;
-  }
+  Release();
   rows_ = cols_ = 0;
   // matrix_ = nullptr;
 }
@@ -100,6 +154,7 @@ bool S21Matrix::EqMatrix(const S21Matrix& other)  // done
 {
   if (matrix_ == nullptr && other.matrix_ == nullptr) return true;
   if (rows_ != other.rows_ || cols_ != other.cols_) return false;
+  if (matrix_ == other.matrix_) return true;
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       if (std::fabs(matrix_[i][j] - other.matrix_[i][j]) >= 1e-7) return false;
@@ -113,6 +168,7 @@ void S21Matrix::SumMatrix(const S21Matrix& other)  // done
   if (cols_ != other.cols_ || rows_ != other.cols_) {
     throw std::logic_error("The matrices must be of the same size");
   }
+  Detach();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       (*this).matrix_[i][j] += other.matrix_[i][j];
@@ -125,6 +181,7 @@ void S21Matrix::SubMatrix(const S21Matrix& other)  // done
   if (cols_ != other.cols_ || rows_ != other.cols_) {
     throw std::logic_error("The matrices must be of the same size");
   }
+  Detach();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       matrix_[i][j] -= other.matrix_[i][j];
@@ -134,6 +191,7 @@ void S21Matrix::SubMatrix(const S21Matrix& other)  // done
 
 void S21Matrix::MulNumber(const double num)  // done
 {
+  Detach();
   for (auto i = 0; i < rows_; i++) {
     for (auto j = 0; j < cols_; j++) {
       matrix_[i][j] = matrix_[i][j] * num;
@@ -147,6 +205,7 @@ void S21Matrix::MulMatrix(const S21Matrix& other)  // done
     throw std::logic_error("Error in size, when multiplying two matrices");
   }
   S21Matrix matrix_new(rows_, other.cols_);
+  matrix_new.SetCopyOnWrite(cow_);
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < other.cols_; j++) {
       for (int k = 0; k < cols_; k++) {
@@ -302,7 +361,15 @@ S21Matrix& S21Matrix::operator*=(const S21Matrix& other) {
   return *this;
 }
 
-double& S21Matrix::operator()(int i, int j) const {
+double& S21Matrix::operator()(int i, int j) {
+  if (i >= rows_ || j >= cols_ || i < 0 || j < 0) {
+    throw std::out_of_range("Invalid index of matric");
+  }
+  Detach();
+  return matrix_[i][j];
+}
+
+const double& S21Matrix::operator()(int i, int j) const {
   if (i >= rows_ || j >= cols_ || i < 0 || j < 0) {
     throw std::out_of_range("Invalid index of matric");
   }
@@ -323,15 +390,12 @@ S21Matrix& S21Matrix::operator=(
   if (this == &other) {
     return *this;  // Самоприсваивание
   } else {
-    if (matrix_) {
-      for (auto i = 0; i < rows_; i++) {
-        if (matrix_[i]) delete[] matrix_[i];
-      }
-      delete[] matrix_;
-    }
+    Release();
   }
   rows_ = std::move(other.rows_);
   cols_ = std::move(other.cols_);
   matrix_ = std::exchange(other.matrix_, nullptr);
+  refs_ = std::exchange(other.refs_, nullptr);
+  cow_ = std::exchange(other.cow_, false);
   return *this;
 }
\ No newline at end of file
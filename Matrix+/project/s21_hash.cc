@@ -0,0 +1,60 @@
+#include <cstdint>
+#include <cstring>
+
+#include "s21_matrix+.h"
+
+namespace {
+
+// 64-bit mixing step (splitmix64 finalizer) applied per element.
+std::uint64_t Mix(std::uint64_t seed, std::uint64_t value) {
+  std::uint64_t x = seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) +
+                            (seed >> 2));
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+}  // namespace
+
+bool S21Matrix::BitwiseEqual(const S21Matrix& other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) return false;
+  if (matrix_ == other.matrix_) return true;
+  for (int i = 0; i < rows_; i++) {
+    if (std::memcmp(matrix_[i], other.matrix_[i], sizeof(double) * cols_)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::size_t S21Matrix::Hash() const {
+  std::uint64_t seed = Mix(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) {
+      std::uint64_t bits;
+      std::memcpy(&bits, &matrix_[i][j], sizeof(bits));
+      seed = Mix(seed, bits);
+    }
+  }
+  return static_cast<std::size_t>(seed);
+}
+
+std::size_t S21Matrix::QuantizedHash(double tolerance) const {
+  if (!(tolerance > 0)) {
+    throw std::invalid_argument("Invalid tolerance of hash");
+  }
+  std::uint64_t seed = Mix(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) {
+      double bucket = std::floor(matrix_[i][j] / tolerance + 0.5);
+      std::uint64_t bits;
+      bucket += 0.0;  // -0.0 and 0.0 land in the same bucket
+      std::memcpy(&bits, &bucket, sizeof(bits));
+      seed = Mix(seed, bits);
+    }
+  }
+  return static_cast<std::size_t>(seed);
+}
@@ -1,23 +1,49 @@
 #ifndef MATRIX_PLUS
 #define MATRIX_PLUS
+#include <atomic>
 #include <iostream>
 // #include <bits/stdc++.h>
+#include <cmath>
 #include <exception>
+#include <functional>
+#include <stdexcept>
 #include <utility>
 
 class S21Matrix {
+  friend class S21MatrixBuilder;
+
  private:
   int rows_ = 0;
   int cols_ = 0;
   // std::unique_ptr<std::unique_ptr<double[]>[]>matrix_;
   double** matrix_;
+  // Copy-on-write mode: copies share matrix_ and this counter until one of
+  // them is modified. Non-null exactly when cow_ is set.
+  std::atomic<int>* refs_ = nullptr;
+  bool cow_ = false;
+
+  void Release();
+  void Detach();
 
  public:
+  enum class SolveMode { kDouble, kMixedPrecision };
+
+  struct SolveStats {
+    SolveMode mode = SolveMode::kDouble;
+    int iterations = 0;          // refinement steps, summed over columns
+    double residual_norm = 0.0;  // worst max-norm residual of A * x - b
+    bool converged = false;  // every column met its residual bound
+    bool fell_back = false;  // mixed precision gave up and refactored in double
+  };
+
   // accessors & mutators
   int GetRows() const;
   int GetCols() const;
   void SetRows(int rows);
   void SetCols(int cols);
+  void SetCopyOnWrite(bool enabled);
+  bool IsCopyOnWrite() const;
+  bool IsShared() const;
 
   S21Matrix();
   S21Matrix(int rows, int cols);
@@ -26,6 +52,12 @@ class S21Matrix {
   ~S21Matrix();
 
   bool EqMatrix(const S21Matrix& other);
+  // Bit-for-bit equality; cheaper than EqMatrix and consistent with Hash().
+  bool BitwiseEqual(const S21Matrix& other) const;
+  // Hash() matches BitwiseEqual(). QuantizedHash() rounds every element to a
+  // multiple of tolerance first, so nearly equal matrices usually collide.
+  std::size_t Hash() const;
+  std::size_t QuantizedHash(double tolerance) const;
   void SumMatrix(const S21Matrix& other);
   void SubMatrix(const S21Matrix& other);
   void MulNumber(const double num);
@@ -35,6 +67,16 @@ class S21Matrix {
   double Determinant();
   S21Matrix InverseMatrix();
   S21Matrix Minor(int rows, int cols);
+  // Solves A * X = B by LU factorization with partial pivoting. kMixedPrecision
+  // factors in float and recovers double accuracy by iterative refinement.
+  S21Matrix Solve(const S21Matrix& b, SolveMode mode = SolveMode::kDouble,
+                  SolveStats* stats = nullptr) const;
+  // Spectral routines for symmetric matrices: eigenvalues come out as a
+  // column in descending order, eigenvectors as the matching columns.
+  void SymmetricEigen(S21Matrix* values, S21Matrix* vectors) const;
+  // Randomized truncated SVD A ~ U * diag(S) * V^T of the given rank.
+  void TruncatedSVD(int rank, S21Matrix* u, S21Matrix* s, S21Matrix* v,
+                    int power_iterations = 2) const;
 
   S21Matrix operator+(const S21Matrix& other);
   S21Matrix operator-(const S21Matrix& other);
@@ -45,7 +87,11 @@ class S21Matrix {
   S21Matrix& operator-=(const S21Matrix& other);
   S21Matrix& operator*=(const S21Matrix& other);
   S21Matrix& operator*=(const double num);
-  double& operator()(int i, int j) const;
+  // The mutable accessor unshares a copy-on-write buffer first, even for a
+  // read: read through a const reference (std::as_const) to keep sharing.
+  // References it returns stay valid only until the matrix is copied again.
+  double& operator()(int i, int j);
+  const double& operator()(int i, int j) const;
 
   S21Matrix& operator=(
       const S21Matrix& other);  // оператор копирования // const!!!
@@ -56,4 +102,11 @@ class S21Matrix {
   void SetValue(double value, int i, int j);
 };
 
+namespace std {
+template <>
+struct hash<S21Matrix> {
+  size_t operator()(const S21Matrix& matrix) const { return matrix.Hash(); }
+};
+}  // namespace std
+
 #endif  // MATRIX_PLUS
\ No newline at end of file
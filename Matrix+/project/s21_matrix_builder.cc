@@ -0,0 +1,105 @@
+#include "s21_matrix_builder.h"
+
+#include <algorithm>
+
+S21MatrixBuilder::S21MatrixBuilder(int cols) {
+  if (cols <= 0) {
+    throw std::invalid_argument("Invalid size of matrix");
+  }
+  cols_ = cols;
+}
+
+S21MatrixBuilder::~S21MatrixBuilder() { Clear(); }
+
+double* S21MatrixBuilder::NewRow() const { return new double[cols_](); }
+
+int S21MatrixBuilder::GetRows() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<int>(rows_.size());
+}
+
+int S21MatrixBuilder::GetCols() const { return cols_; }
+
+void S21MatrixBuilder::Reserve(int rows) {
+  if (rows < 0) {
+    throw std::invalid_argument("Invalid size of matrix");
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  rows_.reserve(rows);
+}
+
+void S21MatrixBuilder::AppendRow(const double* values) {
+  double* row = NewRow();
+  std::copy(values, values + cols_, row);
+  std::lock_guard<std::mutex> lock(mutex_);
+  try {
+    rows_.push_back(row);
+  } catch (...) {
+    delete[] row;
+    throw;
+  }
+}
+
+void S21MatrixBuilder::AppendRow(std::initializer_list<double> values) {
+  if (static_cast<int>(values.size()) != cols_) {
+    throw std::invalid_argument("Invalid size of row");
+  }
+  AppendRow(values.begin());
+}
+
+int S21MatrixBuilder::ReserveRows(int count) {
+  if (count < 0) {
+    throw std::invalid_argument("Invalid size of matrix");
+  }
+  std::vector<double*> fresh;
+  fresh.reserve(count);
+  try {
+    for (int i = 0; i < count; i++) {
+      fresh.push_back(NewRow());
+    }
+  } catch (...) {
+    for (double* row : fresh) delete[] row;
+    throw;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  int first = static_cast<int>(rows_.size());
+  try {
+    rows_.insert(rows_.end(), fresh.begin(), fresh.end());
+  } catch (...) {
+    for (double* row : fresh) delete[] row;
+    throw;
+  }
+  return first;
+}
+
+double* S21MatrixBuilder::Row(int i) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (i < 0 || i >= static_cast<int>(rows_.size())) {
+    throw std::out_of_range("Invalid index of row");
+  }
+  return rows_[i];
+}
+
+void S21MatrixBuilder::SetRow(int i, const double* values) {
+  double* row = Row(i);
+  std::copy(values, values + cols_, row);
+}
+
+S21Matrix S21MatrixBuilder::Build() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  S21Matrix result;
+  result.matrix_ = new double*[rows_.size()];
+  std::copy(rows_.begin(), rows_.end(), result.matrix_);
+  result.rows_ = static_cast<int>(rows_.size());
+  result.cols_ = cols_;
+  rows_.clear();
+  rows_.shrink_to_fit();
+  return result;
+}
+
+void S21MatrixBuilder::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (double* row : rows_) delete[] row;
+  rows_.clear();
+}
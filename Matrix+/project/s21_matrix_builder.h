@@ -0,0 +1,43 @@
+#ifndef MATRIX_PLUS_BUILDER
+#define MATRIX_PLUS_BUILDER
+#include <initializer_list>
+#include <mutex>
+#include <vector>
+
+#include "s21_matrix+.h"
+
+// Collects rows of a matrix whose final row count is unknown. Rows are kept
+// as separate buffers, so growing the builder only moves row pointers, and
+// Build() hands the buffers over to S21Matrix without copying the data.
+class S21MatrixBuilder {
+ private:
+  int cols_ = 0;
+  std::vector<double*> rows_;
+  mutable std::mutex mutex_;
+
+  double* NewRow() const;
+
+ public:
+  explicit S21MatrixBuilder(int cols);
+  S21MatrixBuilder(const S21MatrixBuilder& other) = delete;
+  S21MatrixBuilder& operator=(const S21MatrixBuilder& other) = delete;
+  ~S21MatrixBuilder();
+
+  int GetRows() const;
+  int GetCols() const;
+  void Reserve(int rows);
+
+  void AppendRow(const double* values);
+  void AppendRow(std::initializer_list<double> values);
+
+  // Parallel ingestion: each producer reserves its own range of zeroed rows
+  // and fills them through Row() / SetRow() without further coordination.
+  int ReserveRows(int count);
+  double* Row(int i);
+  void SetRow(int i, const double* values);
+
+  S21Matrix Build();
+  void Clear();
+};
+
+#endif  // MATRIX_PLUS_BUILDER
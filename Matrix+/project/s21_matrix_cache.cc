@@ -0,0 +1,133 @@
+#include "s21_matrix_cache.h"
+
+S21MatrixCache::S21MatrixCache(std::size_t capacity_bytes)
+    : capacity_bytes_(capacity_bytes) {}
+
+std::size_t S21MatrixCache::BytesOf(const S21Matrix& matrix) {
+  return sizeof(double) * matrix.GetRows() * matrix.GetCols();
+}
+
+// Returns the entry for matrix, creating an empty one on a miss. The entry is
+// moved to the front of the LRU list either way.
+S21MatrixCache::Entry& S21MatrixCache::Lookup(const S21Matrix& matrix) {
+  std::size_t hash = matrix.Hash();
+  auto range = index_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second->key.BitwiseEqual(matrix)) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return entries_.front();
+    }
+  }
+  entries_.emplace_front();
+  Entry& entry = entries_.front();
+  entry.hash = hash;
+  entry.key = matrix;
+  index_.emplace(hash, entries_.begin());
+  Resize(entry);
+  return entry;
+}
+
+void S21MatrixCache::Resize(Entry& entry) {
+  used_bytes_ -= entry.bytes;
+  entry.bytes = sizeof(Entry) + BytesOf(entry.key) + BytesOf(entry.inverse);
+  used_bytes_ += entry.bytes;
+}
+
+void S21MatrixCache::Erase(EntryList::iterator entry) {
+  auto range = index_.equal_range(entry->hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == entry) {
+      index_.erase(it);
+      break;
+    }
+  }
+  used_bytes_ -= entry->bytes;
+  entries_.erase(entry);
+}
+
+// Drops least recently used entries; the front entry is the one being
+// filled and is only dropped when it alone exceeds the capacity.
+void S21MatrixCache::Evict() {
+  while (used_bytes_ > capacity_bytes_ && !entries_.empty()) {
+    Erase(std::prev(entries_.end()));
+  }
+}
+
+// Called when computing a result for the front entry threw: an entry that
+// Lookup has just created holds no result and would only take up space.
+void S21MatrixCache::Discard() {
+  if (!entries_.front().has_determinant && !entries_.front().has_inverse) {
+    Erase(entries_.begin());
+  }
+  Evict();
+}
+
+double S21MatrixCache::Determinant(const S21Matrix& matrix) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Entry& entry = Lookup(matrix);
+  if (entry.has_determinant) {
+    hits_++;
+    return entry.determinant;
+  }
+  misses_++;
+  double determinant;
+  try {
+    determinant = entry.key.Determinant();
+  } catch (...) {
+    Discard();
+    throw;
+  }
+  entry.determinant = determinant;
+  entry.has_determinant = true;
+  Evict();
+  return determinant;
+}
+
+S21Matrix S21MatrixCache::InverseMatrix(const S21Matrix& matrix) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Entry& entry = Lookup(matrix);
+  if (entry.has_inverse) {
+    hits_++;
+    return entry.inverse;
+  }
+  misses_++;
+  S21Matrix inverse;
+  try {
+    inverse = entry.key.InverseMatrix();
+  } catch (...) {
+    Discard();
+    throw;
+  }
+  entry.inverse = inverse;
+  entry.has_inverse = true;
+  Resize(entry);
+  Evict();
+  return inverse;
+}
+
+std::size_t S21MatrixCache::GetHits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hits_;
+}
+
+std::size_t S21MatrixCache::GetMisses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return misses_;
+}
+
+std::size_t S21MatrixCache::GetSize() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+std::size_t S21MatrixCache::GetUsedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return used_bytes_;
+}
+
+void S21MatrixCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  used_bytes_ = 0;
+}
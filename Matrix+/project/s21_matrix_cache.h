@@ -0,0 +1,54 @@
+#ifndef MATRIX_PLUS_CACHE
+#define MATRIX_PLUS_CACHE
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "s21_matrix+.h"
+
+// Memoizes Determinant() and InverseMatrix() by input matrix. Inputs are
+// matched bit-for-bit; the least recently used entries are evicted once
+// the stored keys and results exceed capacity_bytes.
+class S21MatrixCache {
+ private:
+  struct Entry {
+    std::size_t hash = 0;
+    S21Matrix key;
+    bool has_determinant = false;
+    double determinant = 0.0;
+    bool has_inverse = false;
+    S21Matrix inverse;
+    std::size_t bytes = 0;
+  };
+  using EntryList = std::list<Entry>;
+
+  std::size_t capacity_bytes_;
+  std::size_t used_bytes_ = 0;
+  std::size_t hits_ = 0;
+  std::size_t misses_ = 0;
+  EntryList entries_;  // most recently used first
+  std::unordered_multimap<std::size_t, EntryList::iterator> index_;
+  mutable std::mutex mutex_;
+
+  static std::size_t BytesOf(const S21Matrix& matrix);
+  Entry& Lookup(const S21Matrix& matrix);
+  void Resize(Entry& entry);
+  void Erase(EntryList::iterator entry);
+  void Evict();
+  void Discard();
+
+ public:
+  explicit S21MatrixCache(std::size_t capacity_bytes);
+
+  double Determinant(const S21Matrix& matrix);
+  S21Matrix InverseMatrix(const S21Matrix& matrix);
+
+  std::size_t GetHits() const;
+  std::size_t GetMisses() const;
+  std::size_t GetSize() const;
+  std::size_t GetUsedBytes() const;
+  void Clear();
+};
+
+#endif  // MATRIX_PLUS_CACHE
@@ -0,0 +1,178 @@
+#include <cfloat>
+#include <vector>
+
+#include "s21_matrix+.h"
+
+namespace {
+
+const int kMaxRefinementSteps = 30;
+
+// LU factorization with partial pivoting, stored in place row-major.
+template <typename Real>
+bool Factorize(std::vector<Real>& lu, std::vector<int>& pivots, int n) {
+  pivots.resize(n);
+  for (int k = 0; k < n; k++) {
+    int pivot = k;
+    Real best = std::fabs(lu[k * n + k]);
+    for (int i = k + 1; i < n; i++) {
+      Real candidate = std::fabs(lu[i * n + k]);
+      if (candidate > best) {
+        best = candidate;
+        pivot = i;
+      }
+    }
+    pivots[k] = pivot;
+    if (best == Real(0) || !std::isfinite(best)) return false;
+    if (pivot != k) {
+      for (int j = 0; j < n; j++) std::swap(lu[k * n + j], lu[pivot * n + j]);
+    }
+    Real* row_k = &lu[k * n];
+    for (int i = k + 1; i < n; i++) {
+      Real* row_i = &lu[i * n];
+      Real factor = row_i[k] / row_k[k];
+      row_i[k] = factor;
+      for (int j = k + 1; j < n; j++) row_i[j] -= factor * row_k[j];
+    }
+  }
+  return true;
+}
+
+template <typename Real>
+void Substitute(const std::vector<Real>& lu, const std::vector<int>& pivots,
+                int n, std::vector<Real>& x) {
+  for (int k = 0; k < n; k++) std::swap(x[k], x[pivots[k]]);
+  for (int i = 1; i < n; i++) {
+    Real sum = x[i];
+    for (int j = 0; j < i; j++) sum -= lu[i * n + j] * x[j];
+    x[i] = sum;
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    Real sum = x[i];
+    for (int j = i + 1; j < n; j++) sum -= lu[i * n + j] * x[j];
+    x[i] = sum / lu[i * n + i];
+  }
+}
+
+// A NaN anywhere makes the norm NaN, so a failed solve is never accepted.
+double MaxNorm(const std::vector<double>& v) {
+  double norm = 0.0;
+  for (double value : v) {
+    if (std::isnan(value)) return value;
+    norm = std::max(norm, std::fabs(value));
+  }
+  return norm;
+}
+
+}  // namespace
+
+S21Matrix S21Matrix::Solve(const S21Matrix& b, SolveMode mode,
+                           SolveStats* stats) const {
+  if (rows_ != cols_) {
+    throw std::logic_error("The matrix must be square");
+  }
+  if (b.rows_ != rows_) {
+    throw std::logic_error("Error in size, when solving a system");
+  }
+  const int n = rows_;
+  SolveStats result;
+  result.mode = mode;
+
+  std::vector<double> a(n * n);
+  double a_norm = 0.0;
+  for (int i = 0; i < n; i++) {
+    double row_sum = 0.0;
+    for (int j = 0; j < n; j++) {
+      a[i * n + j] = matrix_[i][j];
+      row_sum += std::fabs(matrix_[i][j]);
+    }
+    a_norm = std::max(a_norm, row_sum);
+  }
+  // Narrowing a double outside the float range is undefined, so such a
+  // matrix goes straight to the double factorization.
+  const bool fits_float = MaxNorm(a) <= FLT_MAX;
+
+  std::vector<float> lu_single;
+  std::vector<double> lu_double;
+  std::vector<int> pivots;
+  bool single = false;
+  if (mode == SolveMode::kMixedPrecision && !fits_float) {
+    result.fell_back = true;
+  } else if (mode == SolveMode::kMixedPrecision) {
+    lu_single.assign(a.begin(), a.end());
+    single = Factorize(lu_single, pivots, n);
+    result.fell_back = !single;
+  }
+  if (!single) {
+    lu_double = a;
+    if (!Factorize(lu_double, pivots, n)) {
+      throw std::logic_error("The matrix is singular");
+    }
+  }
+
+  S21Matrix x(n, b.cols_);
+  std::vector<double> rhs(n), sol(n), residual(n);
+  std::vector<float> correction(n);
+  result.converged = true;
+  for (int c = 0; c < b.cols_; c++) {
+    for (int i = 0; i < n; i++) rhs[i] = b.matrix_[i][c];
+    const double tolerance = std::sqrt(static_cast<double>(n)) * DBL_EPSILON;
+
+    bool done = false;
+    if (single && MaxNorm(rhs) <= FLT_MAX) {
+      for (int i = 0; i < n; i++) correction[i] = static_cast<float>(rhs[i]);
+      Substitute(lu_single, pivots, n, correction);
+      sol.assign(correction.begin(), correction.end());
+      for (int step = 0; step <= kMaxRefinementSteps && !done; step++) {
+        for (int i = 0; i < n; i++) {
+          double sum = rhs[i];
+          for (int j = 0; j < n; j++) sum -= a[i * n + j] * sol[j];
+          residual[i] = sum;
+        }
+        double r_norm = MaxNorm(residual);
+        if (!std::isfinite(r_norm) || r_norm > FLT_MAX) break;
+        if (r_norm <= tolerance * a_norm * MaxNorm(sol)) {
+          result.residual_norm = std::max(result.residual_norm, r_norm);
+          done = true;
+        } else if (step < kMaxRefinementSteps) {
+          for (int i = 0; i < n; i++) {
+            correction[i] = static_cast<float>(residual[i]);
+          }
+          Substitute(lu_single, pivots, n, correction);
+          for (int i = 0; i < n; i++) sol[i] += correction[i];
+          result.iterations++;
+        }
+      }
+    }
+    if (single && !done) {
+      // The float factors are too inaccurate for this system, or the right
+      // hand side does not fit a float: redo the remaining columns with a
+      // double factorization.
+      single = false;
+      result.fell_back = true;
+      lu_double = a;
+      if (!Factorize(lu_double, pivots, n)) {
+        throw std::logic_error("The matrix is singular");
+      }
+    }
+    if (!done) {
+      sol = rhs;
+      Substitute(lu_double, pivots, n, sol);
+      for (int i = 0; i < n; i++) {
+        double sum = rhs[i];
+        for (int j = 0; j < n; j++) sum -= a[i * n + j] * sol[j];
+        residual[i] = sum;
+      }
+      double r_norm = MaxNorm(residual);
+      // A direct solve is accepted within the backward error bound of LU
+      // with partial pivoting rather than the refinement tolerance.
+      done = std::isfinite(r_norm) &&
+             r_norm <= n * DBL_EPSILON * a_norm * MaxNorm(sol);
+      result.residual_norm = std::max(result.residual_norm, r_norm);
+    }
+    result.converged = result.converged && done;
+    for (int i = 0; i < n; i++) x.matrix_[i][c] = sol[i];
+  }
+
+  if (stats) *stats = result;
+  return x;
+}
@@ -0,0 +1,467 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "s21_matrix+.h"
+
+namespace {
+
+// Dense row-major storage used by the spectral kernels.
+struct Dense {
+  int rows = 0;
+  int cols = 0;
+  std::vector<double> data;
+
+  Dense() = default;
+  Dense(int r, int c) : rows(r), cols(c), data(std::size_t(r) * c, 0.0) {}
+  double* Row(int i) { return &data[std::size_t(i) * cols]; }
+  const double* Row(int i) const { return &data[std::size_t(i) * cols]; }
+  double& At(int i, int j) { return data[std::size_t(i) * cols + j]; }
+  double At(int i, int j) const { return data[std::size_t(i) * cols + j]; }
+};
+
+const int kBlock = 64;
+
+// Threads started on first use and kept until exit, so that the kernels,
+// which call ParallelFor once per Householder step or QL sweep, do not pay
+// for thread creation every time. The caller works as well, and chunks are
+// claimed through a counter so that uneven ones balance out.
+class WorkerPool {
+ public:
+  static WorkerPool& Instance() {
+    static WorkerPool pool;
+    return pool;
+  }
+
+  int Threads() const { return static_cast<int>(workers_.size()) + 1; }
+
+  // Calls task(0) ... task(chunks - 1) and returns when all are done. A
+  // caller that finds the pool busy with another one runs them alone.
+  template <typename Task>
+  void Run(int chunks, Task& task) {
+    std::unique_lock<std::mutex> busy(run_mutex_, std::try_to_lock);
+    if (!busy.owns_lock() || workers_.empty()) {
+      for (int c = 0; c < chunks; c++) task(c);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      invoke_ = [](void* context, int chunk) {
+        (*static_cast<Task*>(context))(chunk);
+      };
+      context_ = &task;
+      chunks_ = chunks;
+      next_.store(0);
+      active_ = static_cast<int>(workers_.size());
+      generation_++;
+    }
+    wake_.notify_all();
+    Work();
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return active_ == 0; });
+  }
+
+ private:
+  WorkerPool() {
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    for (int t = 1; t < threads; t++) workers_.emplace_back([this] { Loop(); });
+  }
+
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) worker.join();
+  }
+
+  void Work() {
+    for (int c = next_.fetch_add(1); c < chunks_; c = next_.fetch_add(1)) {
+      invoke_(context_, c);
+    }
+  }
+
+  void Loop() {
+    unsigned long seen = 0;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+        if (stop_) return;
+        seen = generation_;
+      }
+      Work();
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--active_ == 0) done_.notify_one();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  void (*invoke_)(void*, int) = nullptr;
+  void* context_ = nullptr;
+  int chunks_ = 0;
+  std::atomic<int> next_{0};
+  int active_ = 0;
+  unsigned long generation_ = 0;
+  bool stop_ = false;
+};
+
+// Splits [begin, end) into contiguous chunks, a few per pool thread, and
+// runs them on the pool. Small ranges run inline since handing them over
+// would cost more than the work.
+template <typename Fn>
+void ParallelFor(int begin, int end, long work_per_item, Fn fn) {
+  const long kMinWork = 1L << 16;
+  const int kChunksPerThread = 4;
+  int count = end - begin;
+  if (count < 2 || count * work_per_item < kMinWork) {
+    fn(begin, end);
+    return;
+  }
+  WorkerPool& pool = WorkerPool::Instance();
+  int chunks = std::min(count, kChunksPerThread * pool.Threads());
+  int step = (count + chunks - 1) / chunks;
+  auto task = [&](int chunk) {
+    int lo = begin + chunk * step;
+    if (lo < end) fn(lo, std::min(end, lo + step));
+  };
+  pool.Run(chunks, task);
+}
+
+// C = op(A) * B, where op(A) is A or its transpose. Rows of C are split
+// between threads; the inner product is blocked over k for cache reuse.
+Dense Multiply(const Dense& a, bool transpose_a, const Dense& b) {
+  int m = transpose_a ? a.cols : a.rows;
+  int inner = transpose_a ? a.rows : a.cols;
+  Dense c(m, b.cols);
+  ParallelFor(0, m, long(inner) * b.cols, [&](int lo, int hi) {
+    for (int kk = 0; kk < inner; kk += kBlock) {
+      int k_end = std::min(inner, kk + kBlock);
+      for (int i = lo; i < hi; i++) {
+        double* c_row = c.Row(i);
+        for (int k = kk; k < k_end; k++) {
+          double a_ik = transpose_a ? a.At(k, i) : a.At(i, k);
+          if (a_ik == 0.0) continue;
+          const double* b_row = b.Row(k);
+          for (int j = 0; j < b.cols; j++) c_row[j] += a_ik * b_row[j];
+        }
+      }
+    }
+  });
+  return c;
+}
+
+// Orthonormalizes the columns of q in place (modified Gram-Schmidt, applied
+// twice for numerical stability).
+void Orthonormalize(Dense& q) {
+  for (int pass = 0; pass < 2; pass++) {
+    for (int j = 0; j < q.cols; j++) {
+      for (int p = 0; p < j; p++) {
+        double dot = 0.0;
+        for (int i = 0; i < q.rows; i++) dot += q.At(i, p) * q.At(i, j);
+        for (int i = 0; i < q.rows; i++) q.At(i, j) -= dot * q.At(i, p);
+      }
+      double norm = 0.0;
+      for (int i = 0; i < q.rows; i++) norm += q.At(i, j) * q.At(i, j);
+      norm = std::sqrt(norm);
+      for (int i = 0; i < q.rows; i++) {
+        q.At(i, j) = norm > 0.0 ? q.At(i, j) / norm : 0.0;
+      }
+    }
+  }
+}
+
+// Householder reduction of the symmetric matrix in v to tridiagonal form.
+// On return d/e hold the diagonal and subdiagonal and v the transformation.
+void Tridiagonalize(Dense& v, std::vector<double>& d, std::vector<double>& e) {
+  const int n = v.rows;
+  for (int j = 0; j < n; j++) d[j] = v.At(n - 1, j);
+
+  for (int i = n - 1; i > 0; i--) {
+    double scale = 0.0;
+    double h = 0.0;
+    for (int k = 0; k < i; k++) scale += std::fabs(d[k]);
+    if (scale == 0.0) {
+      e[i] = d[i - 1];
+      for (int j = 0; j < i; j++) {
+        d[j] = v.At(i - 1, j);
+        v.At(i, j) = 0.0;
+        v.At(j, i) = 0.0;
+      }
+    } else {
+      for (int k = 0; k < i; k++) {
+        d[k] /= scale;
+        h += d[k] * d[k];
+      }
+      double f = d[i - 1];
+      double g = std::sqrt(h);
+      if (f > 0) g = -g;
+      e[i] = scale * g;
+      h -= f * g;
+      d[i - 1] = f - g;
+      for (int j = 0; j < i; j++) e[j] = 0.0;
+
+      for (int j = 0; j < i; j++) {
+        f = d[j];
+        v.At(j, i) = f;
+        g = e[j] + v.At(j, j) * f;
+        for (int k = j + 1; k <= i - 1; k++) {
+          g += v.At(k, j) * d[k];
+          e[k] += v.At(k, j) * f;
+        }
+        e[j] = g;
+      }
+      f = 0.0;
+      for (int j = 0; j < i; j++) {
+        e[j] /= h;
+        f += e[j] * d[j];
+      }
+      double hh = f / (h + h);
+      for (int j = 0; j < i; j++) e[j] -= hh * d[j];
+
+      // Rank-2 update of the lower triangle of the leading block, split by
+      // rows so that no two threads write to the same cache line.
+      ParallelFor(0, i, i, [&](int lo, int hi) {
+        for (int k = lo; k < hi; k++) {
+          double* row = v.Row(k);
+          double dk = d[k];
+          double ek = e[k];
+          for (int j = 0; j <= k; j++) row[j] -= d[j] * ek + e[j] * dk;
+        }
+      });
+      for (int j = 0; j < i; j++) {
+        d[j] = v.At(i - 1, j);
+        v.At(i, j) = 0.0;
+      }
+    }
+    d[i] = h;
+  }
+
+  // Accumulate the transformations.
+  std::vector<double> g(n);
+  for (int i = 0; i < n - 1; i++) {
+    v.At(n - 1, i) = v.At(i, i);
+    v.At(i, i) = 1.0;
+    double h = d[i + 1];
+    if (h != 0.0) {
+      for (int k = 0; k <= i; k++) d[k] = v.At(k, i + 1) / h;
+      // g = v^T * column i + 1 over the leading block, then v -= d * g^T.
+      // Both passes walk rows; the first splits the entries of g, the
+      // second the rows of v.
+      ParallelFor(0, i + 1, i + 1, [&](int lo, int hi) {
+        std::fill(g.begin() + lo, g.begin() + hi, 0.0);
+        for (int k = 0; k <= i; k++) {
+          const double* row = v.Row(k);
+          double vk = row[i + 1];
+          for (int j = lo; j < hi; j++) g[j] += vk * row[j];
+        }
+      });
+      ParallelFor(0, i + 1, i + 1, [&](int lo, int hi) {
+        for (int k = lo; k < hi; k++) {
+          double* row = v.Row(k);
+          double dk = d[k];
+          for (int j = 0; j <= i; j++) row[j] -= g[j] * dk;
+        }
+      });
+    }
+    for (int k = 0; k <= i; k++) v.At(k, i + 1) = 0.0;
+  }
+  for (int j = 0; j < n; j++) {
+    d[j] = v.At(n - 1, j);
+    v.At(n - 1, j) = 0.0;
+  }
+  v.At(n - 1, n - 1) = 1.0;
+  e[0] = 0.0;
+}
+
+// Implicit QL iterations on the tridiagonal matrix. The Givens rotations of a
+// sweep are recorded and applied to the rows of v in parallel blocks.
+void DiagonalizeTridiagonal(Dense& v, std::vector<double>& d,
+                            std::vector<double>& e) {
+  const int n = v.rows;
+  for (int i = 1; i < n; i++) e[i - 1] = e[i];
+  e[n - 1] = 0.0;
+
+  std::vector<double> cosines(n), sines(n);
+  double f = 0.0;
+  double tst1 = 0.0;
+  const double eps = std::pow(2.0, -52.0);
+  for (int l = 0; l < n; l++) {
+    tst1 = std::max(tst1, std::fabs(d[l]) + std::fabs(e[l]));
+    int m = l;
+    while (m < n - 1 && std::fabs(e[m]) > eps * tst1) m++;
+
+    if (m > l) {
+      do {
+        double g = d[l];
+        double p = (d[l + 1] - g) / (2.0 * e[l]);
+        double r = std::hypot(p, 1.0);
+        if (p < 0) r = -r;
+        d[l] = e[l] / (p + r);
+        d[l + 1] = e[l] * (p + r);
+        double dl1 = d[l + 1];
+        double h = g - d[l];
+        for (int i = l + 2; i < n; i++) d[i] -= h;
+        f += h;
+
+        p = d[m];
+        double c = 1.0, c2 = 1.0, c3 = 1.0;
+        double el1 = e[l + 1];
+        double s = 0.0, s2 = 0.0;
+        for (int i = m - 1; i >= l; i--) {
+          c3 = c2;
+          c2 = c;
+          s2 = s;
+          g = c * e[i];
+          h = c * p;
+          r = std::hypot(p, e[i]);
+          e[i + 1] = s * r;
+          s = e[i] / r;
+          c = p / r;
+          p = c * d[i] - s * g;
+          d[i + 1] = h + s * (c * g + s * d[i]);
+          cosines[i] = c;
+          sines[i] = s;
+        }
+        ParallelFor(0, n, 4L * (m - l), [&](int lo, int hi) {
+          for (int k = lo; k < hi; k++) {
+            double* row = v.Row(k);
+            for (int i = m - 1; i >= l; i--) {
+              double t = row[i + 1];
+              row[i + 1] = sines[i] * row[i] + cosines[i] * t;
+              row[i] = cosines[i] * row[i] - sines[i] * t;
+            }
+          }
+        });
+        p = -s * s2 * c3 * el1 * e[l] / dl1;
+        e[l] = s * p;
+        d[l] = c * p;
+      } while (std::fabs(e[l]) > eps * tst1);
+    }
+    d[l] += f;
+    e[l] = 0.0;
+  }
+}
+
+// Eigenvalues in descending order with the matching eigenvectors as columns.
+void SymmetricEigen(const Dense& a, std::vector<double>& values,
+                    Dense& vectors) {
+  const int n = a.rows;
+  Dense v = a;
+  std::vector<double> d(n), e(n);
+  if (n > 0) {
+    Tridiagonalize(v, d, e);
+    DiagonalizeTridiagonal(v, d, e);
+  }
+
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&d](int x, int y) { return d[x] > d[y]; });
+  values.resize(n);
+  vectors = Dense(n, n);
+  for (int j = 0; j < n; j++) {
+    values[j] = d[order[j]];
+    for (int i = 0; i < n; i++) vectors.At(i, j) = v.At(i, order[j]);
+  }
+}
+
+}  // namespace
+
+void S21Matrix::SymmetricEigen(S21Matrix* values, S21Matrix* vectors) const {
+  if (rows_ != cols_) {
+    throw std::logic_error("The matrix must be square");
+  }
+  Dense a(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) {
+      if (std::fabs(matrix_[i][j] - matrix_[j][i]) >=
+          1e-7 * std::max(1.0, std::fabs(matrix_[i][j]))) {
+        throw std::logic_error("The matrix must be symmetric");
+      }
+      a.At(i, j) = matrix_[i][j];
+    }
+  }
+
+  std::vector<double> lambda;
+  Dense v;
+  ::SymmetricEigen(a, lambda, v);
+  if (values) {
+    S21Matrix result(rows_, 1);
+    for (int i = 0; i < rows_; i++) result.matrix_[i][0] = lambda[i];
+    *values = std::move(result);
+  }
+  if (vectors) {
+    S21Matrix result(rows_, rows_);
+    for (int i = 0; i < rows_; i++) {
+      std::copy(v.Row(i), v.Row(i) + rows_, result.matrix_[i]);
+    }
+    *vectors = std::move(result);
+  }
+}
+
+void S21Matrix::TruncatedSVD(int rank, S21Matrix* u, S21Matrix* s,
+                             S21Matrix* v, int power_iterations) const {
+  const int kOversampling = 10;
+  if (rank <= 0 || rank > std::min(rows_, cols_) || power_iterations < 0) {
+    throw std::invalid_argument("Invalid rank of decomposition");
+  }
+  Dense a(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    std::copy(matrix_[i], matrix_[i] + cols_, a.Row(i));
+  }
+
+  // Range finder: Q spans the dominant column space of A.
+  int sketch = std::min(rank + kOversampling, std::min(rows_, cols_));
+  Dense omega(cols_, sketch);
+  std::mt19937_64 generator(0x5eedu);
+  std::normal_distribution<double> gaussian(0.0, 1.0);
+  for (double& value : omega.data) value = gaussian(generator);
+  Dense q = Multiply(a, false, omega);
+  Orthonormalize(q);
+  for (int it = 0; it < power_iterations; it++) {
+    Dense z = Multiply(a, true, q);
+    Orthonormalize(z);
+    q = Multiply(a, false, z);
+    Orthonormalize(q);
+  }
+
+  // B = Q^T A is small; its left singular vectors come from eig(B B^T).
+  Dense b = Multiply(q, true, a);
+  Dense gram(sketch, sketch);
+  for (int i = 0; i < sketch; i++) {
+    for (int j = 0; j <= i; j++) {
+      double dot = 0.0;
+      for (int k = 0; k < cols_; k++) dot += b.At(i, k) * b.At(j, k);
+      gram.At(i, j) = gram.At(j, i) = dot;
+    }
+  }
+  std::vector<double> lambda;
+  Dense w;
+  ::SymmetricEigen(gram, lambda, w);
+
+  Dense left = Multiply(q, false, w);
+  Dense right = Multiply(b, true, w);
+  S21Matrix u_new(rows_, rank), s_new(rank, 1), v_new(cols_, rank);
+  for (int j = 0; j < rank; j++) {
+    double sigma = std::sqrt(std::max(lambda[j], 0.0));
+    s_new.matrix_[j][0] = sigma;
+    for (int i = 0; i < rows_; i++) u_new.matrix_[i][j] = left.At(i, j);
+    for (int i = 0; i < cols_; i++) {
+      v_new.matrix_[i][j] = sigma > 0.0 ? right.At(i, j) / sigma : 0.0;
+    }
+  }
+  if (u) *u = std::move(u_new);
+  if (s) *s = std::move(s_new);
+  if (v) *v = std::move(v_new);
+}
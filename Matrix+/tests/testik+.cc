@@ -1,6 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include "../project/s21_matrix+.h"
+#include "../project/s21_matrix_builder.h"
+#include "../project/s21_matrix_cache.h"
 
 TEST(Test_GRows, 1) {
   S21Matrix val1(0, 0);
@@ -359,6 +366,355 @@ TEST(Test_eqq, 4) {
   EXPECT_TRUE(val1 == val2);
 }
 
+TEST(Test_Builder, 1) {
+  S21MatrixBuilder builder(3);
+  builder.AppendRow({1, 2, 3});
+  double row[3] = {4, 5, 6};
+  builder.AppendRow(row);
+  EXPECT_EQ(builder.GetRows(), 2);
+  S21Matrix val1 = builder.Build();
+  EXPECT_EQ(val1.GetRows(), 2);
+  EXPECT_EQ(val1.GetCols(), 3);
+  EXPECT_EQ(val1(0, 2), 3);
+  EXPECT_EQ(val1(1, 0), 4);
+  EXPECT_EQ(builder.GetRows(), 0);
+}
+
+TEST(Test_Builder, 2) {
+  EXPECT_THROW(S21MatrixBuilder builder(0), std::invalid_argument);
+  S21MatrixBuilder builder(2);
+  EXPECT_THROW(builder.AppendRow({1, 2, 3}), std::invalid_argument);
+  EXPECT_THROW(builder.Row(0), std::out_of_range);
+}
+
+TEST(Test_Builder, 3) {
+  const int producers = 4;
+  const int rows = 250;
+  S21MatrixBuilder builder(2);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < producers; t++) {
+    threads.emplace_back([&builder]() {
+      int first = builder.ReserveRows(rows);
+      for (int i = first; i < first + rows; i++) {
+        double values[2] = {static_cast<double>(i), static_cast<double>(-i)};
+        builder.SetRow(i, values);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  S21Matrix val1 = builder.Build();
+  EXPECT_EQ(val1.GetRows(), producers * rows);
+  for (int i = 0; i < val1.GetRows(); i++) {
+    EXPECT_EQ(val1(i, 0), i);
+    EXPECT_EQ(val1(i, 1), -i);
+  }
+}
+
+TEST(Test_Solve, 1) {
+  S21Matrix val1(3, 3);
+  val1(0, 0) = 4, val1(0, 1) = -2, val1(0, 2) = 1;
+  val1(1, 0) = -2, val1(1, 1) = 4, val1(1, 2) = -2;
+  val1(2, 0) = 1, val1(2, 1) = -2, val1(2, 2) = 4;
+  S21Matrix b(3, 1);
+  b(0, 0) = 11, b(1, 0) = -16, b(2, 0) = 17;
+  S21Matrix::SolveStats stats;
+  S21Matrix x = val1.Solve(b, S21Matrix::SolveMode::kDouble, &stats);
+  EXPECT_NEAR(x(0, 0), 1, 1e-12);
+  EXPECT_NEAR(x(1, 0), -2, 1e-12);
+  EXPECT_NEAR(x(2, 0), 3, 1e-12);
+  EXPECT_TRUE(stats.converged);
+  EXPECT_EQ(stats.iterations, 0);
+}
+
+TEST(Test_Solve, 2) {
+  const int n = 40;
+  S21Matrix val1(n, n);
+  S21Matrix b(n, 2);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      val1(i, j) = 1.0 / (1 + i + j) + (i == j ? 2.0 : 0.0);
+    }
+    b(i, 0) = i + 0.1;
+    b(i, 1) = std::sin(i);
+  }
+  S21Matrix::SolveStats stats;
+  S21Matrix x = val1.Solve(b, S21Matrix::SolveMode::kMixedPrecision, &stats);
+  EXPECT_TRUE(stats.converged);
+  EXPECT_FALSE(stats.fell_back);
+  EXPECT_GT(stats.iterations, 0);
+  S21Matrix exact = val1.Solve(b);
+  for (int i = 0; i < n; i++) {
+    EXPECT_NEAR(x(i, 0), exact(i, 0), 1e-12);
+    EXPECT_NEAR(x(i, 1), exact(i, 1), 1e-12);
+  }
+}
+
+TEST(Test_Solve, 3) {
+  S21Matrix val1(2, 2);
+  val1(0, 0) = 1e300, val1(1, 1) = 1;
+  S21Matrix b(2, 1);
+  b(0, 0) = 1e300, b(1, 0) = 2;
+  S21Matrix::SolveStats stats;
+  S21Matrix x = val1.Solve(b, S21Matrix::SolveMode::kMixedPrecision, &stats);
+  EXPECT_TRUE(stats.fell_back);
+  EXPECT_NEAR(x(0, 0), 1, 1e-12);
+  EXPECT_NEAR(x(1, 0), 2, 1e-12);
+  EXPECT_TRUE(stats.converged);
+}
+
+TEST(Test_Solve, 4) {
+  S21Matrix val1(2, 3);
+  S21Matrix b(2, 1);
+  EXPECT_THROW(val1.Solve(b), std::logic_error);
+  S21Matrix val2(2, 2);
+  EXPECT_THROW(val2.Solve(b), std::logic_error);
+  S21Matrix val3(2, 2);
+  val3(0, 0) = 1;
+  val3(1, 1) = 1;
+  S21Matrix b2(3, 1);
+  EXPECT_THROW(val3.Solve(b2), std::logic_error);
+}
+
+TEST(Test_Solve, 5) {
+  // x(0) = 1e308 * 10 / 1e308 overflows, so no residual can be accepted
+  S21Matrix val1(2, 2);
+  val1(0, 0) = 1e308, val1(0, 1) = -1e308, val1(1, 1) = 1;
+  S21Matrix b(2, 1);
+  b(1, 0) = 10;
+  S21Matrix::SolveStats stats;
+  val1.Solve(b, S21Matrix::SolveMode::kDouble, &stats);
+  EXPECT_FALSE(stats.converged);
+  val1.Solve(b, S21Matrix::SolveMode::kMixedPrecision, &stats);
+  EXPECT_FALSE(stats.converged);
+  EXPECT_TRUE(stats.fell_back);
+}
+
+TEST(Test_SymmetricEigen, 1) {
+  S21Matrix val1(3, 3);
+  val1(0, 0) = 2, val1(0, 1) = -1, val1(0, 2) = 0;
+  val1(1, 0) = -1, val1(1, 1) = 2, val1(1, 2) = -1;
+  val1(2, 0) = 0, val1(2, 1) = -1, val1(2, 2) = 2;
+  S21Matrix values, vectors;
+  val1.SymmetricEigen(&values, &vectors);
+  EXPECT_NEAR(values(0, 0), 2 + std::sqrt(2), 1e-12);
+  EXPECT_NEAR(values(1, 0), 2, 1e-12);
+  EXPECT_NEAR(values(2, 0), 2 - std::sqrt(2), 1e-12);
+  S21Matrix product = val1 * vectors;
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      EXPECT_NEAR(product(i, j), values(j, 0) * vectors(i, j), 1e-12);
+    }
+  }
+}
+
+TEST(Test_SymmetricEigen, 2) {
+  const int n = 60;
+  S21Matrix val1(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j <= i; j++) {
+      val1(i, j) = val1(j, i) = std::cos(i * 7 + j * 3);
+    }
+  }
+  S21Matrix values, vectors;
+  val1.SymmetricEigen(&values, &vectors);
+  S21Matrix product = vectors.Transpose() * vectors;
+  S21Matrix residual = val1 * vectors;
+  for (int i = 0; i < n; i++) {
+    if (i > 0) {
+      EXPECT_GE(values(i - 1, 0), values(i, 0));
+    }
+    for (int j = 0; j < n; j++) {
+      EXPECT_NEAR(product(i, j), i == j ? 1.0 : 0.0, 1e-10);
+      EXPECT_NEAR(residual(i, j), values(j, 0) * vectors(i, j), 1e-10);
+    }
+  }
+}
+
+TEST(Test_SymmetricEigen, 3) {
+  S21Matrix val1(2, 2);
+  val1(0, 1) = 1;
+  EXPECT_THROW(val1.SymmetricEigen(nullptr, nullptr), std::logic_error);
+  S21Matrix val2(2, 3);
+  EXPECT_THROW(val2.SymmetricEigen(nullptr, nullptr), std::logic_error);
+}
+
+TEST(Test_SymmetricEigen, 4) {
+  // Large enough for the Householder and QL updates to go to the pool,
+  // run from two threads so one of them finds the pool busy.
+  const int n = 320;
+  S21Matrix val1(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j <= i; j++) {
+      val1(i, j) = val1(j, i) = std::sin(i * 0.37 + j * 1.3) + (i == j);
+    }
+  }
+  S21Matrix values[2], vectors[2];
+  std::thread other([&] { val1.SymmetricEigen(&values[1], &vectors[1]); });
+  val1.SymmetricEigen(&values[0], &vectors[0]);
+  other.join();
+  S21Matrix product = vectors[0].Transpose() * vectors[0];
+  S21Matrix residual = val1 * vectors[0];
+  double worst = 0;
+  for (int i = 0; i < n; i++) {
+    EXPECT_EQ(values[0](i, 0), values[1](i, 0));
+    for (int j = 0; j < n; j++) {
+      worst = std::max(worst, std::fabs(product(i, j) - (i == j)));
+      worst = std::max(worst, std::fabs(residual(i, j) -
+                                        values[0](j, 0) * vectors[0](i, j)));
+    }
+  }
+  EXPECT_LT(worst, 1e-9);
+}
+
+TEST(Test_TruncatedSVD, 1) {
+  const int m = 50, n = 30;
+  S21Matrix left(m, 2), right(2, n);
+  for (int i = 0; i < m; i++) {
+    left(i, 0) = std::sin(i + 1.0);
+    left(i, 1) = std::cos(0.3 * i);
+  }
+  for (int j = 0; j < n; j++) {
+    right(0, j) = 3.0 * std::cos(j + 0.5);
+    right(1, j) = 0.5 * std::sin(2.0 * j);
+  }
+  S21Matrix val1 = left * right;
+  S21Matrix u, s, v;
+  val1.TruncatedSVD(2, &u, &s, &v);
+  EXPECT_EQ(u.GetRows(), m);
+  EXPECT_EQ(u.GetCols(), 2);
+  EXPECT_EQ(v.GetRows(), n);
+  EXPECT_GE(s(0, 0), s(1, 0));
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      double value = 0;
+      for (int k = 0; k < 2; k++) value += u(i, k) * s(k, 0) * v(j, k);
+      EXPECT_NEAR(value, val1(i, j), 1e-9);
+    }
+  }
+  EXPECT_THROW(val1.TruncatedSVD(0, &u, &s, &v), std::invalid_argument);
+  EXPECT_THROW(val1.TruncatedSVD(31, &u, &s, &v), std::invalid_argument);
+}
+
+TEST(Test_CopyOnWrite, 1) {
+  S21Matrix val1(2, 2);
+  val1.SetCopyOnWrite(true);
+  val1(0, 0) = 1;
+  val1(1, 1) = 2;
+  S21Matrix val2(val1);
+  S21Matrix val3;
+  val3 = val1;
+  EXPECT_TRUE(val1.IsShared());
+  EXPECT_TRUE(val2.IsCopyOnWrite());
+  EXPECT_TRUE(val1 == val2);
+  EXPECT_EQ(std::as_const(val2)(1, 1), 2);
+  EXPECT_TRUE(val2.IsShared());
+  val2(0, 0) = 5;
+  EXPECT_FALSE(val2.IsShared());
+  EXPECT_EQ(std::as_const(val1)(0, 0), 1);
+  EXPECT_EQ(std::as_const(val3)(0, 0), 1);
+  EXPECT_EQ(std::as_const(val2)(0, 0), 5);
+  EXPECT_TRUE(val1.IsShared());
+  val3.MulNumber(2);
+  EXPECT_FALSE(val1.IsShared());
+  EXPECT_EQ(std::as_const(val1)(1, 1), 2);
+  EXPECT_EQ(std::as_const(val3)(1, 1), 4);
+}
+
+TEST(Test_CopyOnWrite, 2) {
+  S21Matrix val1(2, 2);
+  val1.SetValue(1);
+  S21Matrix val2(val1);
+  EXPECT_FALSE(val1.IsShared());
+  val1.SetCopyOnWrite(true);
+  S21Matrix val3 = val1;
+  const S21Matrix& ref = val3;
+  EXPECT_EQ(ref(1, 0), 1);
+  EXPECT_TRUE(val3.IsShared());
+  val3.SetCopyOnWrite(false);
+  EXPECT_FALSE(val1.IsShared());
+  EXPECT_FALSE(val3.IsCopyOnWrite());
+  val1.SetRows(3);
+  val1.SetCols(3);
+  EXPECT_TRUE(val1.IsCopyOnWrite());
+  S21Matrix val4 = val1 + val1;
+  EXPECT_EQ(std::as_const(val4)(2, 1), 0);
+  EXPECT_EQ(std::as_const(val4)(0, 1), 2);
+  EXPECT_EQ(std::as_const(val1)(0, 1), 1);
+  EXPECT_FALSE(val1.IsShared());
+}
+
+TEST(Test_Hash, 1) {
+  S21Matrix val1(2, 2);
+  S21Matrix val2(2, 2);
+  val1(0, 1) = 0.5;
+  val2(0, 1) = 0.5;
+  EXPECT_TRUE(val1.BitwiseEqual(val2));
+  EXPECT_EQ(val1.Hash(), val2.Hash());
+  EXPECT_EQ(std::hash<S21Matrix>()(val1), val1.Hash());
+  val2(1, 1) = 1e-12;
+  EXPECT_FALSE(val1.BitwiseEqual(val2));
+  EXPECT_NE(val1.Hash(), val2.Hash());
+  EXPECT_EQ(val1.QuantizedHash(1e-6), val2.QuantizedHash(1e-6));
+  S21Matrix val3(4, 1);
+  EXPECT_NE(val3.Hash(), S21Matrix(1, 4).Hash());
+  EXPECT_THROW(val1.QuantizedHash(0), std::invalid_argument);
+}
+
+TEST(Test_Hash, 2) {
+  std::unordered_set<std::size_t> hashes;
+  for (int i = 0; i < 100; i++) {
+    S21Matrix val1(3, 3);
+    val1(i % 3, i / 3 % 3) = i;
+    hashes.insert(val1.Hash());
+  }
+  EXPECT_EQ(hashes.size(), 100U);
+}
+
+TEST(Test_MatrixCache, 1) {
+  S21MatrixCache cache(1 << 20);
+  S21Matrix val1(2, 2);
+  val1(0, 0) = 4, val1(0, 1) = 7, val1(1, 0) = 2, val1(1, 1) = 6;
+  EXPECT_DOUBLE_EQ(cache.Determinant(val1), 10);
+  EXPECT_DOUBLE_EQ(cache.Determinant(val1), 10);
+  S21Matrix inverse = cache.InverseMatrix(val1);
+  EXPECT_TRUE(inverse == val1.InverseMatrix());
+  EXPECT_TRUE(cache.InverseMatrix(val1) == inverse);
+  EXPECT_EQ(cache.GetHits(), 2U);
+  EXPECT_EQ(cache.GetMisses(), 2U);
+  EXPECT_EQ(cache.GetSize(), 1U);
+  std::size_t used = cache.GetUsedBytes();
+  S21Matrix singular(2, 2);
+  EXPECT_THROW(cache.InverseMatrix(singular), std::logic_error);
+  S21Matrix wide(2, 3);
+  EXPECT_THROW(cache.Determinant(wide), std::logic_error);
+  EXPECT_EQ(cache.GetSize(), 1U);
+  EXPECT_EQ(cache.GetUsedBytes(), used);
+  EXPECT_DOUBLE_EQ(cache.Determinant(singular), 0);
+  EXPECT_THROW(cache.InverseMatrix(singular), std::logic_error);
+  EXPECT_EQ(cache.GetSize(), 2U);
+  cache.Clear();
+  EXPECT_EQ(cache.GetSize(), 0U);
+  EXPECT_EQ(cache.GetUsedBytes(), 0U);
+}
+
+TEST(Test_MatrixCache, 2) {
+  S21MatrixCache cache(1000);
+  for (int i = 0; i < 50; i++) {
+    S21Matrix val1(3, 3);
+    val1.SetValue(i);
+    val1(0, 0) = i + 1;
+    cache.Determinant(val1);
+    EXPECT_LE(cache.GetUsedBytes(), 1000U);
+  }
+  EXPECT_GT(cache.GetSize(), 0U);
+  EXPECT_LT(cache.GetSize(), 50U);
+  S21Matrix last(3, 3);
+  last.SetValue(49);
+  last(0, 0) = 50;
+  cache.Determinant(last);
+  EXPECT_EQ(cache.GetHits(), 1U);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -366,6 +722,7 @@ int main(int argc, char** argv) {
 
 void S21Matrix::SetValue(double value)  // done
 {
+  Detach();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       matrix_[i][j] = value;
@@ -375,5 +732,6 @@ void S21Matrix::SetValue(double value)  // done
 
 void S21Matrix::SetValue(double value, int i, int j)  // done
 {
+  Detach();
   matrix_[i][j] = value;
 }